@@ -0,0 +1,39 @@
+#ifndef MATLANGRT_H
+#define MATLANGRT_H
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+void tr_rec(int rows, int cols, const double* src, int src_stride, double* dst, int dst_stride);
+void neg_mat(int size1, int size2, double mat[size1][size2], double result[size1][size2]);
+void mat_mat_mul(int size1_1, int common_size, int size2_2, double mat1[size1_1][common_size], double mat2[common_size][size2_2], double result[size1_1][size2_2]);
+double mat_mat_mul_s(int common_size, double mat1[1][common_size], double mat2[common_size][1]);
+void mat_mat_add(int size1, int size2, double mat1[size1][size2], double mat2[size1][size2], double result[size1][size2]);
+void mat_mat_sub(int size1, int size2, double mat1[size1][size2], double mat2[size1][size2], double result[size1][size2]);
+void mat_sca_mul(int size1, int size2, double scalar, double matrix[size1][size2], double result[size1][size2]);
+void mat_assign(int size1, int size2, double mat[size1][size2], double result[size1][size2]);
+void tr_sq_inplace(int size, double matrix[size][size]);
+void tr(int size1, int size2, double matrix[size1][size2], double result[size2][size1]);
+double choose(int condition, double first, double second, double third);
+int rt_binary_out();
+void rt_writev_all(struct iovec* iov, int count);
+void rt_out_flush();
+char* rt_out_reserve(int count);
+void rt_out_str(const char* str);
+void rt_out_double(double value);
+void rt_bin_put(const void* value, int size);
+void rt_bin_record(int rows, int cols, const double* data);
+typedef void (*matlang_print_fn)(void* context, int rows, int cols, const double* values);
+void print(double value);
+void print_mat(int size1, int size2, double matrix[size1][size2]);
+void printsep();
+double* rt_load_bin(const char* path, int rows, int cols, double* storage);
+int rt_csv_line(char* line, const char* path, int line_num, int cols, double* row);
+double* rt_load_csv(const char* path, int rows, int cols, double* storage);
+#endif
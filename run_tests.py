@@ -22,10 +22,26 @@ ASSUMPTIONS:
 3.) Test files are stored in tests directory relative to this program and
 all test cases are stored in files with extension .test
 4.) Name of the .mat file and .test file must be the same.
+
+With the --asm argument, the .mat files are compiled to x86-64 assembly and
+linked with the runtime library, which must be built with make runtime.
+
+With the --run argument, the .mat files are run by matlang2c --run instead of
+being compiled, which checks that the virtual machine prints the same output.
+
+The arguments after -- are passed to matlang2c, e.g.
+
+	./run_tests.py -- --parallel -O2
+
+The C files are compiled with -fopenmp and -pthread, so that the parallel
+programs run in parallel, and with the CFLAGS and LDLIBS environment
+variables. With --runtime-lib, the programs are linked with the runtime
+library. With --split, the C files of the parts are compiled as well.
 '''
 
 import os
 import sys
+import glob
 import subprocess
 import filecmp
 
@@ -35,8 +51,27 @@ c_extension = '.c'
 executable_extension = '.exe'
 test_extension = '.test'
 output_extension = '.out'
+asm_extension = '.s'
 # The current path where the test cases are stored
 test_path = 'tests'
+# Runtime library linked with the assembly
+runtime_library = os.path.join('build', 'runtime', 'libmatlangrt.a')
+# Arguments of this script and the flags after -- passed to matlang2c
+if '--' in sys.argv[1:]:
+	script_args = sys.argv[1:sys.argv.index('--')]
+	compiler_flags = sys.argv[sys.argv.index('--') + 1:]
+else:
+	script_args = sys.argv[1:]
+	compiler_flags = []
+# Compile to assembly instead of C
+use_asm = '--asm' in script_args
+# Run with the virtual machine of matlang2c instead of compiling
+use_run = '--run' in script_args
+# Link with the runtime library instead of the helpers in the C file
+use_runtime_lib = '--runtime-lib' in compiler_flags
+# Flags of gcc from the environment
+c_flags = os.environ.get('CFLAGS', '').split()
+c_libs = os.environ.get('LDLIBS', '').split()
 
 def file_test_path(file):
 	'''
@@ -63,42 +98,89 @@ def compile_to_c(f):
 	compiler = 'matlang2c'
 	# compile all files to their corresponding c files
 	print 'matlang2c compiling ', f + mat_extension, '...'
+	if use_asm:
+		return subprocess.call(
+				[os.path.join('.', compiler),
+				 file_test_path(f + mat_extension),
+				 '--asm',
+				 '-o',
+				 file_test_path(f + asm_extension)] + compiler_flags)
+	# parts of an earlier --split run
+	for part in split_parts(f):
+		os.remove(part)
 	return_code = subprocess.call(
 			[os.path.join('.', compiler),
 			 file_test_path(f + mat_extension),
 			 '-o',
-			 file_test_path(f + c_extension)])
+			 file_test_path(f + c_extension)] + compiler_flags)
 	return return_code
 
 
+def split_parts(f):
+	'''
+	Returns the C files of the parts written by matlang2c --split
+	'''
+	return sorted(glob.glob(file_test_path(f + '_[0-9]*' + c_extension)))
+
+
 def compile_c_file(f):
 	'''
 	Compiles all .c files in the test directory to .exe files in the test dir
 	'''
 	compiler = 'gcc'
+	if use_asm:
+		print 'gcc assembling ', f + asm_extension, '...'
+		return subprocess.call(
+				[compiler,
+				 file_test_path(f + asm_extension),
+				 runtime_library,
+				 '-o',
+				 file_test_path(f + executable_extension),
+				 '-lm'
+				 ])
 	print 'gcc compiling ', f + c_extension, '...'
+	runtime = []
+	if use_runtime_lib:
+		runtime = ['-I' + os.path.dirname(runtime_library), runtime_library]
 	return_code = subprocess.call(
-			[compiler,
-			 file_test_path(f + c_extension),
-			 '-o',
+			[compiler, '-fopenmp', '-pthread'] + c_flags +
+			[file_test_path(f + c_extension)] + split_parts(f) + runtime +
+			['-o',
 			 file_test_path(f + executable_extension),
 			 '-lm'
-			 ])
+			 ] + c_libs)
 	return return_code
 
 
-def run_test(f):
+def run_program(f):
+	'''
+	Runs the .mat file with matlang2c --run. Returns the exit status and the
+	output of the program.
+	'''
+	print 'matlang2c running ', f + mat_extension, '...'
+	cmd = subprocess.Popen(
+		[os.path.join('.', 'matlang2c'),
+		 file_test_path(f + mat_extension),
+		 '--run'] + compiler_flags,
+		 stdout = subprocess.PIPE)
+	output = cmd.communicate()[0]
+	return cmd.returncode, output
+
+
+def run_test(f, output = None):
 	'''
 	For all files in file_names, runs the corresponding C program compiled
 	before and writes its output to a .out file. Then compares the
 	.out and .test files. If they are the same, outputs SUCCESS; else FAILED.
+	The output of a program run by matlang2c is given.
 	'''
 #Run each test case with its corresponding program and save the output file
 #with the name of the program concatenated by .out extension
-	cmd = subprocess.Popen(
-		[os.path.join('.', file_test_path(f + executable_extension))],
-		 stdout = subprocess.PIPE)
-	output = cmd.communicate()[0]
+	if output is None:
+		cmd = subprocess.Popen(
+			[os.path.join('.', file_test_path(f + executable_extension))],
+			 stdout = subprocess.PIPE)
+		output = cmd.communicate()[0]
 	string = ''
 	with open(file_test_path(f + '.test'), 'r') as in_file:
 		for line in in_file:
@@ -118,6 +200,19 @@ def main():
 	file_names.sort()
 	for f in file_names:
 		print 'FILE:', f
+		if use_run:
+			status, output = run_program(f)
+			# the program exits with 1 on a runtime error as the C program
+			# does. Other statuses are errors of matlang2c.
+			if status not in (0, 1):
+				print 'ERROR: matlang2c'
+			elif run_test(f, output):
+				print 'SUCCESS'
+			else:
+				print 'FAILED'
+			print '========================================'
+			print
+			continue
 		if compile_to_c(f) == 0: #All .mat files are compiled to .c
 			if compile_c_file(f) == 0:
 				if run_test(f):
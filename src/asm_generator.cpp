@@ -0,0 +1,440 @@
+#include "asm_generator.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+//xmm0 and xmm1 pass the arguments of the calls
+static const int first_reg = 2;
+static const int reg_count = 16;
+
+static std::string xmm(int reg)
+{
+	return "%xmm" + std::to_string(reg);
+}
+
+static int xmm_index(const std::string& reg)
+{
+	return std::stoi(reg.substr(4));
+}
+
+static std::string pc_label(int pc)
+{
+	return ".Lpc" + std::to_string(pc);
+}
+
+void AsmGenerator::generate(const std::string& out_file_name)
+{
+	std::ofstream ofs(out_file_name.c_str());
+	if (!ofs) {
+		throw std::runtime_error(out_file_name + " couldn't be opened to write the output");
+	}
+	targets.clear();
+	for (const auto& ins : bytecode.code) {
+		if (ins.op == OpCode::Jump || ins.op == OpCode::JumpIfNotLess) {
+			targets.insert(ins.dst);
+		}
+	}
+	reg_slot.assign(reg_count, -1);
+	reg_used.assign(reg_count, 0);
+	clock = 0;
+	scratch_size = 0;
+	//the frame is a multiple of 16 bytes to keep the stack aligned at calls
+	const long frame = (8L * bytecode.scalar_count + 15) / 16 * 16;
+	ofs << "\t.text" << std::endl;
+	ofs << "\t.globl\tmain" << std::endl;
+	ofs << "\t.type\tmain, @function" << std::endl;
+	ofs << "main:" << std::endl;
+	ofs << "\tpushq\t%rbp" << std::endl;
+	ofs << "\tmovq\t%rsp, %rbp" << std::endl;
+	if (frame != 0) {
+		ofs << "\tsubq\t$" << frame << ", %rsp" << std::endl;
+	}
+	//the output is written on every exit of the program
+	ofs << "\tmovq\trt_out_flush@GOTPCREL(%rip), %rdi" << std::endl;
+	ofs << "\tcall\tatexit@PLT" << std::endl;
+	for (size_t pc = 0; pc < bytecode.code.size(); ++pc) {
+		const int index = static_cast<int>(pc);
+		if (targets.count(index) != 0) {
+			invalidate();
+			ofs << pc_label(index) << ":" << std::endl;
+		}
+		ofs << "\t# line " << bytecode.code[pc].line << std::endl;
+		write_instruction(ofs, bytecode.code[pc]);
+	}
+	ofs << pc_label(static_cast<int>(bytecode.code.size())) << ":" << std::endl;
+	ofs << "\tmovl\t$0, %eax" << std::endl;
+	ofs << "\tleave" << std::endl;
+	ofs << "\tret" << std::endl;
+	ofs << "\t.size\tmain, .-main" << std::endl;
+	write_data(ofs);
+	ofs << "\t.section\t.note.GNU-stack,\"\",@progbits" << std::endl;
+}
+
+/** Constants are written as their bits, thus they are exactly the doubles
+  * the bytecode holds.
+  */
+void AsmGenerator::write_data(std::ostream& ofs) const
+{
+	ofs << "\t.section\t.rodata" << std::endl;
+	ofs << "\t.balign\t8" << std::endl;
+	for (size_t i = 0; i < bytecode.constants.size(); ++i) {
+		uint64_t bits = 0;
+		std::memcpy(&bits, &bytecode.constants[i], sizeof(bits));
+		ofs << ".Lc" << i << ":" << std::endl;
+		ofs << "\t.quad\t" << bits << std::endl;
+	}
+	for (size_t i = 0; i < bytecode.strings.size(); ++i) {
+		ofs << ".Ls" << i << ":" << std::endl;
+		ofs << "\t.string\t\"";
+		for (const char c : bytecode.strings[i]) {
+			if (c == '\\' || c == '"') {
+				ofs << '\\';
+			}
+			ofs << c;
+		}
+		ofs << "\"" << std::endl;
+	}
+	ofs << "\t.bss" << std::endl;
+	for (size_t i = 0; i < bytecode.matrices.size(); ++i) {
+		const Dimensions& dim = bytecode.matrices[i];
+		ofs << "\t.balign\t32" << std::endl;
+		ofs << matrix_label(static_cast<int>(i)) << ":" << std::endl;
+		ofs << "\t.zero\t" << 8L * dim.rows * dim.cols << std::endl;
+	}
+	if (scratch_size != 0) {
+		ofs << "\t.balign\t32" << std::endl;
+		ofs << ".Lscratch:" << std::endl;
+		ofs << "\t.zero\t" << 8 * scratch_size << std::endl;
+	}
+}
+
+void AsmGenerator::write_instruction(std::ostream& ofs, const Instruction& ins)
+{
+	switch (ins.op) {
+		case OpCode::LoadConstant:
+		{
+			const std::string dst = allocate({});
+			ofs << "\tmovsd\t.Lc" << ins.a << "(%rip), " << dst << std::endl;
+			store(ofs, dst, ins.dst);
+			break;
+		}
+		case OpCode::MoveScalar:
+		{
+			const std::string src = load(ofs, ins.a, {});
+			const std::string dst = allocate({src});
+			ofs << "\tmovapd\t" << src << ", " << dst << std::endl;
+			store(ofs, dst, ins.dst);
+			break;
+		}
+		case OpCode::Add:
+		case OpCode::Subtract:
+		case OpCode::Multiply:
+		{
+			const std::string left = load(ofs, ins.a, {});
+			const std::string right = load(ofs, ins.b, {left});
+			const std::string dst = allocate({left, right});
+			const char* const op = (ins.op == OpCode::Add) ? "addsd"
+								 : (ins.op == OpCode::Subtract) ? "subsd"
+																: "mulsd";
+			ofs << "\tmovapd\t" << left << ", " << dst << std::endl;
+			ofs << "\t" << op << "\t" << right << ", " << dst << std::endl;
+			store(ofs, dst, ins.dst);
+			break;
+		}
+		case OpCode::Sqrt:
+		{
+			const std::string src = load(ofs, ins.a, {});
+			const std::string dst = allocate({src});
+			ofs << "\tsqrtsd\t" << src << ", " << dst << std::endl;
+			store(ofs, dst, ins.dst);
+			break;
+		}
+		case OpCode::Choose:
+		{
+			//choose(int condition, double first, double second, double third)
+			const std::string condition = load(ofs, ins.a, {});
+			const std::string first = load(ofs, ins.b, {condition});
+			const std::string second = load(ofs, ins.c, {condition, first});
+			const std::string third = load(ofs, ins.d, {condition, first, second});
+			const std::string dst = allocate({condition, first, second, third});
+			ofs << "\tcvttsd2si\t" << condition << ", %eax" << std::endl;
+			ofs << "\tmovapd\t" << first << ", " << dst << std::endl;
+			ofs << "\ttestl\t%eax, %eax" << std::endl;
+			ofs << "\tje\t1f" << std::endl;
+			ofs << "\tmovapd\t" << second << ", " << dst << std::endl;
+			ofs << "\tjg\t1f" << std::endl;
+			ofs << "\tmovapd\t" << third << ", " << dst << std::endl;
+			ofs << "1:" << std::endl;
+			store(ofs, dst, ins.dst);
+			break;
+		}
+		case OpCode::ReadElement:
+		{
+			//A[(int)<row>][(int)<col>]
+			const int cols = bytecode.matrices.at(static_cast<size_t>(ins.a)).cols;
+			const std::string row = load(ofs, ins.b, {});
+			const std::string col = load(ofs, ins.c, {row});
+			const std::string dst = allocate({row, col});
+			ofs << "\tcvttsd2si\t" << row << ", %eax" << std::endl;
+			ofs << "\tcvttsd2si\t" << col << ", %ecx" << std::endl;
+			ofs << "\timull\t$" << cols << ", %eax, %eax" << std::endl;
+			ofs << "\taddl\t%ecx, %eax" << std::endl;
+			ofs << "\tcltq" << std::endl;
+			ofs << "\tleaq\t" << matrix_label(ins.a) << "(%rip), %rdx" << std::endl;
+			ofs << "\tmovsd\t(%rdx,%rax,8), " << dst << std::endl;
+			store(ofs, dst, ins.dst);
+			break;
+		}
+		case OpCode::WriteElement:
+		{
+			//A[(int)<row> - 1][(int)<col> - 1] = <value>
+			const int cols = bytecode.matrices.at(static_cast<size_t>(ins.dst)).cols;
+			const std::string row = load(ofs, ins.a, {});
+			const std::string col = (ins.b < 0) ? "" : load(ofs, ins.b, {row});
+			const std::string value = load(ofs, ins.c, {row, col});
+			ofs << "\tcvttsd2si\t" << row << ", %eax" << std::endl;
+			ofs << "\tsubl\t$1, %eax" << std::endl;
+			ofs << "\timull\t$" << cols << ", %eax, %eax" << std::endl;
+			if (ins.b >= 0) {
+				ofs << "\tcvttsd2si\t" << col << ", %ecx" << std::endl;
+				ofs << "\tsubl\t$1, %ecx" << std::endl;
+				ofs << "\taddl\t%ecx, %eax" << std::endl;
+			}
+			ofs << "\tcltq" << std::endl;
+			ofs << "\tleaq\t" << matrix_label(ins.dst) << "(%rip), %rdx" << std::endl;
+			ofs << "\tmovsd\t" << value << ", (%rdx,%rax,8)" << std::endl;
+			break;
+		}
+		case OpCode::SetElement:
+		{
+			const std::string value = load(ofs, ins.b, {});
+			ofs << "\tmovsd\t" << value << ", " << matrix_label(ins.dst) << "+"
+				<< 8L * ins.a << "(%rip)" << std::endl;
+			break;
+		}
+		case OpCode::JumpIfNotLess:
+		{
+			//the jump is also taken if a value is NaN
+			const std::string left = load(ofs, ins.a, {});
+			const std::string right = load(ofs, ins.b, {left});
+			ofs << "\tucomisd\t" << left << ", " << right << std::endl;
+			ofs << "\tjbe\t" << pc_label(ins.dst) << std::endl;
+			break;
+		}
+		case OpCode::Jump:
+			ofs << "\tjmp\t" << pc_label(ins.dst) << std::endl;
+			break;
+		case OpCode::Print:
+		{
+			const std::string value = load(ofs, ins.a, {});
+			ofs << "\tmovapd\t" << value << ", %xmm0" << std::endl;
+			ofs << "\tcall\tprint@PLT" << std::endl;
+			invalidate();
+			break;
+		}
+		case OpCode::PrintSep:
+			ofs << "\tcall\tprintsep@PLT" << std::endl;
+			invalidate();
+			break;
+		default:
+			write_matrix_call(ofs, ins);
+			invalidate();
+			break;
+	}
+}
+
+/** Writes the call of the runtime helper of a matrix instruction. Kernels
+  * whose result can't be one of their operands write to the scratch buffer
+  * which is then copied to the result.
+  */
+void AsmGenerator::write_matrix_call(std::ostream& ofs, const Instruction& ins)
+{
+	const auto dim = [this](int matrix) {
+		return bytecode.matrices.at(static_cast<size_t>(matrix));
+	};
+	const auto address = [&ofs](const std::string& label, const char* reg) {
+		ofs << "\tleaq\t" << label << "(%rip), " << reg << std::endl;
+	};
+	const auto size_args = [&ofs](int first, int second) {
+		ofs << "\tmovl\t$" << first << ", %edi" << std::endl;
+		ofs << "\tmovl\t$" << second << ", %esi" << std::endl;
+	};
+	switch (ins.op) {
+		case OpCode::MoveMatrix:
+			//mat_assign(rows, cols, mat, result)
+			size_args(dim(ins.dst).rows, dim(ins.dst).cols);
+			address(matrix_label(ins.a), "%rdx");
+			address(matrix_label(ins.dst), "%rcx");
+			ofs << "\tcall\tmat_assign@PLT" << std::endl;
+			break;
+		case OpCode::MatrixAdd:
+		case OpCode::MatrixSubtract:
+			size_args(dim(ins.dst).rows, dim(ins.dst).cols);
+			address(matrix_label(ins.a), "%rdx");
+			address(matrix_label(ins.b), "%rcx");
+			address(matrix_label(ins.dst), "%r8");
+			ofs << "\tcall\t" << (ins.op == OpCode::MatrixAdd ? "mat_mat_add" : "mat_mat_sub")
+				<< "@PLT" << std::endl;
+			break;
+		case OpCode::MatrixMultiply:
+		case OpCode::Transpose:
+		{
+			const bool aliased = ins.dst == ins.a ||
+								 (ins.op == OpCode::MatrixMultiply && ins.dst == ins.b);
+			const std::string result = aliased ? ".Lscratch" : matrix_label(ins.dst);
+			const Dimensions result_dim = dim(ins.dst);
+			if (aliased) {
+				scratch_size = std::max(scratch_size,
+										static_cast<size_t>(result_dim.rows) *
+										static_cast<size_t>(result_dim.cols));
+			}
+			if (ins.op == OpCode::MatrixMultiply) {
+				//mat_mat_mul(rows, common, cols, mat1, mat2, result)
+				size_args(dim(ins.a).rows, dim(ins.a).cols);
+				ofs << "\tmovl\t$" << dim(ins.b).cols << ", %edx" << std::endl;
+				address(matrix_label(ins.a), "%rcx");
+				address(matrix_label(ins.b), "%r8");
+				address(result, "%r9");
+				ofs << "\tcall\tmat_mat_mul@PLT" << std::endl;
+			} else {
+				//tr(rows, cols, matrix, result)
+				size_args(dim(ins.a).rows, dim(ins.a).cols);
+				address(matrix_label(ins.a), "%rdx");
+				address(result, "%rcx");
+				ofs << "\tcall\ttr@PLT" << std::endl;
+			}
+			if (aliased) {
+				size_args(result_dim.rows, result_dim.cols);
+				address(result, "%rdx");
+				address(matrix_label(ins.dst), "%rcx");
+				ofs << "\tcall\tmat_assign@PLT" << std::endl;
+			}
+			break;
+		}
+		case OpCode::DotProduct:
+			//mat_mat_mul_s(common, mat1, mat2)
+			ofs << "\tmovl\t$" << dim(ins.a).cols << ", %edi" << std::endl;
+			address(matrix_label(ins.a), "%rsi");
+			address(matrix_label(ins.b), "%rdx");
+			ofs << "\tcall\tmat_mat_mul_s@PLT" << std::endl;
+			ofs << "\tmovsd\t%xmm0, " << slot_address(ins.dst) << std::endl;
+			break;
+		case OpCode::ScalarMultiply:
+		{
+			//mat_sca_mul(rows, cols, scalar, matrix, result)
+			const std::string scalar = load(ofs, ins.a, {});
+			ofs << "\tmovapd\t" << scalar << ", %xmm0" << std::endl;
+			size_args(dim(ins.dst).rows, dim(ins.dst).cols);
+			address(matrix_label(ins.b), "%rdx");
+			address(matrix_label(ins.dst), "%rcx");
+			ofs << "\tcall\tmat_sca_mul@PLT" << std::endl;
+			break;
+		}
+		case OpCode::Negate:
+			size_args(dim(ins.dst).rows, dim(ins.dst).cols);
+			address(matrix_label(ins.a), "%rdx");
+			address(matrix_label(ins.dst), "%rcx");
+			ofs << "\tcall\tneg_mat@PLT" << std::endl;
+			break;
+		case OpCode::PrintMatrix:
+			size_args(dim(ins.a).rows, dim(ins.a).cols);
+			address(matrix_label(ins.a), "%rdx");
+			ofs << "\tcall\tprint_mat@PLT" << std::endl;
+			break;
+		case OpCode::Load:
+		{
+			//rt_load_csv(path, rows, cols, storage) and rt_load_bin return the
+			//values. The values of a mapped binary file are copied.
+			const std::string& path = bytecode.strings.at(static_cast<size_t>(ins.a));
+			const std::string suffix = ".csv";
+			const bool csv = path.size() >= suffix.size() &&
+				path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+			address(".Ls" + std::to_string(ins.a), "%rdi");
+			ofs << "\tmovl\t$" << dim(ins.dst).rows << ", %esi" << std::endl;
+			ofs << "\tmovl\t$" << dim(ins.dst).cols << ", %edx" << std::endl;
+			address(matrix_label(ins.dst), "%rcx");
+			ofs << "\tcall\t" << (csv ? "rt_load_csv" : "rt_load_bin") << "@PLT" << std::endl;
+			if (!csv) {
+				address(matrix_label(ins.dst), "%rdi");
+				ofs << "\tcmpq\t%rax, %rdi" << std::endl;
+				ofs << "\tje\t1f" << std::endl;
+				ofs << "\tmovq\t%rax, %rsi" << std::endl;
+				ofs << "\tmovq\t$" << 8L * dim(ins.dst).rows * dim(ins.dst).cols
+					<< ", %rdx" << std::endl;
+				ofs << "\tcall\tmemcpy@PLT" << std::endl;
+				ofs << "1:" << std::endl;
+			}
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+/** A register used by the current instruction is never taken for another
+  * scalar.
+  */
+std::string AsmGenerator::load(std::ostream& ofs, int slot,
+							   const std::set<std::string>& keep)
+{
+	for (int reg = first_reg; reg < reg_count; ++reg) {
+		if (reg_slot[reg] == slot) {
+			reg_used[reg] = ++clock;
+			return xmm(reg);
+		}
+	}
+	const std::string result = allocate(keep);
+	ofs << "\tmovsd\t" << slot_address(slot) << ", " << result << std::endl;
+	reg_slot[xmm_index(result)] = slot;
+	return result;
+}
+
+std::string AsmGenerator::allocate(const std::set<std::string>& keep)
+{
+	int best = -1;
+	for (int reg = first_reg; reg < reg_count; ++reg) {
+		if (keep.count(xmm(reg)) != 0) {
+			continue;
+		}
+		if (reg_slot[reg] == -1) {
+			best = reg;
+			break;
+		}
+		if (best == -1 || reg_used[reg] < reg_used[best]) {
+			best = reg;
+		}
+	}
+	reg_slot[best] = -1;
+	reg_used[best] = ++clock;
+	return xmm(best);
+}
+
+void AsmGenerator::store(std::ostream& ofs, const std::string& reg, int slot)
+{
+	ofs << "\tmovsd\t" << reg << ", " << slot_address(slot) << std::endl;
+	for (int i = first_reg; i < reg_count; ++i) {
+		if (reg_slot[i] == slot) {
+			reg_slot[i] = -1;
+		}
+	}
+	reg_slot[xmm_index(reg)] = slot;
+}
+
+void AsmGenerator::invalidate()
+{
+	for (auto& slot : reg_slot)
+		slot = -1;
+}
+
+std::string AsmGenerator::slot_address(int slot)
+{
+	return std::to_string(-8 * (slot + 1)) + "(%rbp)";
+}
+
+std::string AsmGenerator::matrix_label(int matrix)
+{
+	return ".Lm" + std::to_string(matrix);
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+#include "bytecode.hpp"
+
+/** Writes bytecode as x86-64 assembly for the System V ABI (GNU as syntax).
+  *
+  * Matrix operations, printing and loading call the helpers of libmatlangrt,
+  * thus the program is linked with the runtime library built by
+  * `make runtime` without --threads and --blas:
+  *
+  *	gcc program.s build/runtime/libmatlangrt.a -lm
+  *
+  * Scalar registers of the bytecode live in the stack frame of main. Within a
+  * block of instructions without calls and jump targets, scalars are kept in
+  * xmm2-xmm15 after they are loaded or computed, and the least recently used
+  * register is reused when all of them are taken. Stores are written through
+  * to the stack, so the registers are simply forgotten at calls and jump
+  * targets. Matrix registers are static arrays.
+  */
+class AsmGenerator {
+public:
+	AsmGenerator(const Bytecode& t_bytecode)
+		: bytecode(t_bytecode)
+		, targets()
+		, reg_slot()
+		, reg_used()
+		, clock(0)
+		, scratch_size(0)
+	{ };
+	//writes the program to the file with the given name
+	void generate(const std::string& out_file_name);
+private:
+	void write_instruction(std::ostream& ofs, const Instruction& ins);
+	void write_matrix_call(std::ostream& ofs, const Instruction& ins);
+	void write_data(std::ostream& ofs) const;
+	/* REGISTER ALLOCATION */
+	//returns an xmm register holding the scalar register
+	std::string load(std::ostream& ofs, int slot, const std::set<std::string>& keep);
+	//returns a free xmm register that isn't in keep
+	std::string allocate(const std::set<std::string>& keep);
+	//stores the xmm register to the scalar register and remembers it
+	void store(std::ostream& ofs, const std::string& reg, int slot);
+	//forgets the contents of the xmm registers
+	void invalidate();
+	static std::string slot_address(int slot);
+	static std::string matrix_label(int matrix);
+private:
+	const Bytecode bytecode;
+	//indices of the instructions that are jumped to
+	std::set<int> targets;
+	//scalar register held by each xmm register, -1 if none
+	std::vector<int> reg_slot;
+	//time each xmm register is last used
+	std::vector<long> reg_used;
+	long clock;
+	//number of elements of the buffer used by kernels writing to an operand
+	size_t scratch_size;
+};
@@ -0,0 +1,49 @@
+#include "batch.hpp"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+void BatchCompiler::compile(std::vector<BatchJob>& jobs) const
+{
+	size_t count = threads != 0 ? threads : std::thread::hardware_concurrency();
+	count = std::max<size_t>(1, std::min(count, jobs.size()));
+	std::atomic<size_t> next(0);
+	//the calling thread is one of the workers
+	std::vector<std::thread> pool;
+	for (size_t i = 1; i < count; ++i) {
+		pool.emplace_back(&BatchCompiler::work, this, std::ref(jobs), std::ref(next));
+	}
+	work(jobs, next);
+	for (auto& thread : pool) {
+		thread.join();
+	}
+}
+
+void BatchCompiler::work(std::vector<BatchJob>& jobs, std::atomic<size_t>& next) const
+{
+	Compiler compiler;
+	for (size_t index = next++; index < jobs.size(); index = next++) {
+		BatchJob& job = jobs[index];
+		job.result = compiler.compile_file(job.source_name, job.output_name, options);
+	}
+}
+
+std::vector<std::string> read_manifest(const std::string& manifest_name)
+{
+	std::ifstream manifest(manifest_name.c_str());
+	if (!manifest) {
+		throw std::runtime_error(manifest_name + " couldn't be opened");
+	}
+	std::vector<std::string> sources;
+	std::string line;
+	while (std::getline(manifest, line)) {
+		const size_t first = line.find_first_not_of(" \t\r");
+		if (first == std::string::npos) {
+			continue;
+		}
+		const size_t last = line.find_last_not_of(" \t\r");
+		sources.push_back(line.substr(first, last - first + 1));
+	}
+	return sources;
+}
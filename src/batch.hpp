@@ -0,0 +1,43 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include <vector>
+#include "code_generator.hpp"
+#include "compiler.hpp"
+
+/** A source file of a batch, the C file it is compiled to and the result */
+struct BatchJob {
+	std::string source_name;
+	std::string output_name;
+	CompileResult result;
+	BatchJob(const std::string& t_source_name, const std::string& t_output_name)
+		: source_name(t_source_name)
+		, output_name(t_output_name)
+		, result()
+	{ };
+};
+
+/** Compiles many source files on a pool of threads. Each thread has its own
+  * Compiler and takes the next job that isn't taken yet, thus a file's
+  * output doesn't depend on the number of threads or the other files.
+  */
+class BatchCompiler {
+public:
+	//threads is the size of the pool. 0 is the number of hardware threads
+	BatchCompiler(const CodeGenOptions& t_options, unsigned t_threads = 0)
+		: options(t_options)
+		, threads(t_threads)
+	{ };
+	//compiles every job and sets its result
+	void compile(std::vector<BatchJob>& jobs) const;
+private:
+	//compiles the jobs from next on until none is left
+	void work(std::vector<BatchJob>& jobs, std::atomic<size_t>& next) const;
+private:
+	const CodeGenOptions options;
+	const unsigned threads;
+};
+
+//returns the source files listed in the manifest, one on each line. Blank
+//lines are skipped. Throws a runtime_error if the manifest can't be read.
+std::vector<std::string> read_manifest(const std::string& manifest_name);
@@ -0,0 +1,227 @@
+#include "binary_cache.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+//changes when the layout of the cache changes
+static const char* const cache_version = "matlang2c-cache-1";
+
+static std::string system_error(const std::string& prefix)
+{
+	return "Error: " + prefix + ": " + std::strerror(errno);
+}
+
+//parameters of the 64 bit FNV-1a hash
+static const uint64_t fnv_offset = (static_cast<uint64_t>(0xcbf29ce4) << 32) | 0x84222325;
+static const uint64_t fnv_prime = static_cast<uint64_t>(0x100000001b3);
+
+//FNV-1a hash of the string continuing from hash
+static uint64_t fnv1a(const std::string& str, uint64_t hash)
+{
+	for (const char c : str) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= fnv_prime;
+	}
+	return hash;
+}
+
+//splits the string at whitespace
+static std::vector<std::string> split(const std::string& str)
+{
+	std::istringstream iss(str);
+	std::vector<std::string> result;
+	std::string word;
+	while (iss >> word)
+		result.push_back(word);
+	return result;
+}
+
+static std::string environment(const char* name, const std::string& default_value)
+{
+	const char* const value = std::getenv(name);
+	return (value == nullptr || value[0] == '\0') ? default_value : value;
+}
+
+BinaryCache::BinaryCache(const std::string& t_directory)
+	: directory(t_directory)
+{
+	//mkdir -p
+	for (size_t slash = directory.find('/', 1); ; slash = directory.find('/', slash + 1)) {
+		const std::string parent = directory.substr(0, slash);
+		if (mkdir(parent.c_str(), 0755) != 0 && errno != EEXIST) {
+			throw std::runtime_error(system_error(parent));
+		}
+		if (slash == std::string::npos)
+			break;
+	}
+}
+
+std::string BinaryCache::default_directory()
+{
+	const std::string dir = environment("MATLANG_CACHE_DIR", "");
+	if (!dir.empty()) {
+		return dir;
+	}
+	const std::string xdg = environment("XDG_CACHE_HOME", "");
+	if (!xdg.empty()) {
+		return xdg + "/matlang2c";
+	}
+	return environment("HOME", ".") + "/.cache/matlang2c";
+}
+
+/** The translator binary is identified by its size and modification time,
+  * so rebuilding the translator invalidates the cache.
+  */
+std::string BinaryCache::key(const std::string& source_name,
+							 const std::vector<std::string>& flags) const
+{
+	std::ifstream source_file(source_name.c_str(), std::ios::binary);
+	if (!source_file) {
+		throw std::runtime_error(source_name + " couldn't be opened!");
+	}
+	std::ostringstream source;
+	source << source_file.rdbuf();
+	uint64_t hash = fnv_offset;
+	hash = fnv1a(std::string(cache_version) + '\0', hash);
+	struct stat st;
+	if (stat("/proc/self/exe", &st) == 0) {
+		hash = fnv1a(std::to_string(st.st_size) + ":" + std::to_string(st.st_mtime) + '\0',
+					 hash);
+	}
+	hash = fnv1a(source.str() + '\0', hash);
+	for (const auto& flag : flags) {
+		hash = fnv1a(flag + '\0', hash);
+	}
+	hash = fnv1a(environment("CC", "gcc") + '\0' + environment("CFLAGS", "-O2"), hash);
+	std::ostringstream hex;
+	hex << std::hex << std::setfill('0') << std::setw(16) << hash;
+	return hex.str();
+}
+
+std::string BinaryCache::object_path(const std::string& key) const
+{
+	return directory + "/" + key + ".so";
+}
+
+std::string BinaryCache::source_path(const std::string& key) const
+{
+	return directory + "/" + key + "." + std::to_string(getpid()) + ".c";
+}
+
+bool BinaryCache::contains(const std::string& key) const
+{
+	return access(object_path(key).c_str(), R_OK) == 0;
+}
+
+/** Runs $CC $CFLAGS -shared -fPIC c_file -o <object> -lm with the OpenMP and
+  * pthread flags the options need.
+  */
+void BinaryCache::build(const std::string& c_file, const std::string& key,
+						const CodeGenOptions& options) const
+{
+	const std::string object = object_path(key);
+	const std::string temporary = object + "." + std::to_string(getpid());
+	std::vector<std::string> args = split(environment("CC", "gcc"));
+	for (const auto& flag : split(environment("CFLAGS", "-O2")))
+		args.push_back(flag);
+	args.push_back("-shared");
+	args.push_back("-fPIC");
+	if (options.parallel_loops || options.task_graph) {
+		args.push_back("-fopenmp");
+	}
+	if (options.threaded_runtime) {
+		args.push_back("-pthread");
+	}
+	args.push_back(c_file);
+	args.push_back("-o");
+	args.push_back(temporary);
+	args.push_back("-lm");
+	std::vector<char*> argv;
+	for (auto& arg : args)
+		argv.push_back(&arg[0]);
+	argv.push_back(nullptr);
+	const pid_t pid = fork();
+	if (pid < 0) {
+		throw std::runtime_error(system_error("fork"));
+	}
+	if (pid == 0) {
+		execvp(argv[0], argv.data());
+		std::perror(argv[0]);
+		_exit(127);
+	}
+	int status = 0;
+	if (waitpid(pid, &status, 0) < 0) {
+		throw std::runtime_error(system_error("waitpid"));
+	}
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		std::remove(temporary.c_str());
+		throw std::runtime_error("Error: " + args[0] + " couldn't compile " + c_file);
+	}
+	if (std::rename(temporary.c_str(), object.c_str()) != 0) {
+		const std::string error = system_error(object);
+		std::remove(temporary.c_str());
+		throw std::runtime_error(error);
+	}
+}
+
+/** The totals are kept in the stats file of the cache, which is locked while
+  * it is updated.
+  */
+CacheStats BinaryCache::record(bool hit) const
+{
+	const std::string path = directory + "/stats";
+	const int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+	if (fd < 0) {
+		throw std::runtime_error(system_error(path));
+	}
+	CacheStats stats{0, 0};
+	if (flock(fd, LOCK_EX) == 0) {
+		char buf[64] = {0};
+		const ssize_t count = read(fd, buf, sizeof(buf) - 1);
+		if (count > 0) {
+			std::istringstream(buf) >> stats.hits >> stats.misses;
+		}
+		++(hit ? stats.hits : stats.misses);
+		const std::string content = std::to_string(stats.hits) + " " +
+									std::to_string(stats.misses) + "\n";
+		if (ftruncate(fd, 0) != 0 ||
+			pwrite(fd, content.data(), content.size(), 0) !=
+				static_cast<ssize_t>(content.size()))
+		{
+			close(fd);
+			throw std::runtime_error(system_error(path));
+		}
+	}
+	close(fd);
+	return stats;
+}
+
+/** The object stays loaded until the translator exits. The program may also
+  * exit the translator itself, e.g. when a load fails.
+  */
+BinaryCache::program_main BinaryCache::load(const std::string& object)
+{
+	void* const handle = dlopen(object.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if (handle == nullptr) {
+		throw std::runtime_error(std::string("Error: ") + dlerror());
+	}
+	void* const symbol = dlsym(handle, "main");
+	if (symbol == nullptr) {
+		throw std::runtime_error("Error: " + object + " has no main");
+	}
+	program_main result;
+	std::memcpy(&result, &symbol, sizeof(symbol));
+	return result;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "code_generator.hpp"
+
+struct CacheStats {
+	long hits;
+	long misses;
+};
+
+/** On disk cache of the programs compiled with --exec.
+  *
+  * A program is compiled to a shared object named after the FNV-1a hash of
+  * its source, the translator flags, the C compiler and its flags (CC and
+  * CFLAGS environment variables) and the translator binary itself. A source
+  * whose hash is in the cache is neither translated nor compiled again. The
+  * shared object is loaded into the translator and its main is called, thus
+  * no new process is started either.
+  *
+  * Objects are compiled to a temporary file and renamed into the cache, so
+  * concurrent jobs never load a partially written object. The cache is never
+  * cleaned; deleting its files is always safe.
+  */
+class BinaryCache {
+public:
+	//creates the directory if it doesn't exist
+	BinaryCache(const std::string& t_directory);
+	//MATLANG_CACHE_DIR or $XDG_CACHE_HOME/matlang2c or ~/.cache/matlang2c
+	static std::string default_directory();
+	//hash of the source file compiled with the given translator flags
+	std::string key(const std::string& source_name,
+					const std::vector<std::string>& flags) const;
+	//path of the shared object of the key
+	std::string object_path(const std::string& key) const;
+	//path of a C file that can be written and compiled for the key
+	std::string source_path(const std::string& key) const;
+	bool contains(const std::string& key) const;
+	//compiles the C file into the shared object of the key
+	void build(const std::string& c_file, const std::string& key,
+			   const CodeGenOptions& options) const;
+	//adds a hit or a miss to the totals of the cache and returns them
+	CacheStats record(bool hit) const;
+	typedef int (*program_main)();
+	//loads the shared object and returns its main
+	static program_main load(const std::string& object);
+private:
+	const std::string directory;
+};
@@ -0,0 +1,337 @@
+#include "bytecode.hpp"
+#include <climits>
+#include <cstdlib>
+
+//register of a value without a target
+static const std::pair<VariableType, int> no_target(VariableType::Scalar, -1);
+
+Bytecode BytecodeCompiler::compile(const IRProgram& program)
+{
+	bytecode = Bytecode();
+	registers.clear();
+	free_scalars.clear();
+	free_matrices.clear();
+	statement_temporaries.clear();
+	//for statements of the open loops and the test of each of their C loops
+	std::vector<std::pair<size_t, std::vector<size_t>>> open_loops;
+	for (size_t index = 0; index < program.statements.size(); ++index) {
+		const IRStatement& stmt = program.statements[index];
+		line = stmt.line;
+		switch (stmt.category) {
+			case TokenCategory::SingleForStatement:
+			case TokenCategory::DoubleForStatement:
+			{
+				//	0   1 2  3  4
+				// for ( i in ...		OR		for ( i , j in ...
+				const size_t depth = (stmt.category == TokenCategory::DoubleForStatement) ? 2 : 1;
+				std::vector<size_t> tests;
+				for (size_t i = 0; i < depth; ++i) {
+					const Register var = variable(stmt.tokens.at(2 + 2 * i).value());
+					compile_value(program, stmt.expressions.at(3 * i), var);
+					free_temporaries();
+					//i < <expr2> + 1
+					tests.push_back(bytecode.code.size());
+					const size_t bound = stmt.expressions.at(3 * i + 1);
+					const Register limit = temporary(VariableType::Scalar, Dimensions(1, 1));
+					long literal = 0;
+					if (integral_value(program, bound, literal)) {
+						emit(OpCode::LoadConstant, limit.second,
+							 constant(static_cast<double>(literal + 1)));
+					} else {
+						const Register one = temporary(VariableType::Scalar, Dimensions(1, 1));
+						emit(OpCode::LoadConstant, one.second, constant(1));
+						emit(OpCode::Add, limit.second,
+							 compile_value(program, bound, no_target).second, one.second);
+					}
+					//the exit is fixed at the end of the loop
+					emit(OpCode::JumpIfNotLess, -1, var.second, limit.second);
+					free_temporaries();
+				}
+				open_loops.emplace_back(index, tests);
+				break;
+			}
+			case TokenCategory::CloseCurlyBraces:
+				if (!open_loops.empty()) {
+					const auto& loop = open_loops.back();
+					for (size_t i = loop.second.size(); i-- > 0;) {
+						compile_loop_end(program, loop.first, i, loop.second[i]);
+					}
+					open_loops.pop_back();
+				}
+				break;
+			case TokenCategory::ExprAssignment:
+				compile_value(program, stmt.expressions.at(0), variable(stmt.def));
+				break;
+			case TokenCategory::SingleSubscriptExprAssignment:
+			case TokenCategory::DoubleSubscriptExprAssignment:
+			{
+				const bool is_double =
+					stmt.category == TokenCategory::DoubleSubscriptExprAssignment;
+				const int row = compile_value(program, stmt.expressions.at(0),
+											  no_target).second;
+				const int col = is_double ? compile_value(program, stmt.expressions.at(1),
+														  no_target).second
+										  : -1;
+				const int value = compile_value(program, stmt.expressions.back(),
+												no_target).second;
+				emit(OpCode::WriteElement, variable(stmt.def).second, row, col, value);
+				break;
+			}
+			case TokenCategory::ListAssignment:
+			{
+				const int matrix = variable(stmt.def).second;
+				for (size_t i = 0; i < stmt.expressions.size(); ++i) {
+					emit(OpCode::SetElement, matrix, static_cast<int>(i),
+						 compile_value(program, stmt.expressions[i], no_target).second);
+				}
+				break;
+			}
+			case TokenCategory::PrintStatement:
+			{
+				const Register value = compile_value(program, stmt.expressions.at(0),
+													 no_target);
+				emit(value.first == VariableType::Scalar ? OpCode::Print
+														 : OpCode::PrintMatrix,
+					 0, value.second);
+				break;
+			}
+			case TokenCategory::PrintSepStatement:
+				emit(OpCode::PrintSep, 0);
+				break;
+			case TokenCategory::LoadStatement:
+				//load ( A , "file" )
+				bytecode.strings.push_back(stmt.tokens.at(4).value());
+				emit(OpCode::Load, variable(stmt.def).second,
+					 static_cast<int>(bytecode.strings.size() - 1));
+				break;
+			default:
+				//declarations only reserve the registers
+				break;
+		}
+		free_temporaries();
+	}
+	return bytecode;
+}
+
+void BytecodeCompiler::compile_loop_end(const IRProgram& program, size_t for_index,
+										size_t depth, size_t test)
+{
+	const IRStatement& stmt = program.statements[for_index];
+	line = stmt.line;
+	//i += <expr3>
+	const int var = variable(stmt.tokens.at(2 + 2 * depth).value()).second;
+	const Register step = compile_value(program, stmt.expressions.at(3 * depth + 2),
+										no_target);
+	emit(OpCode::Add, var, var, step.second);
+	emit(OpCode::Jump, static_cast<int>(test));
+	free_temporaries();
+	//the test is the last instruction before the body
+	size_t jump = test;
+	while (bytecode.code[jump].op != OpCode::JumpIfNotLess)
+		++jump;
+	bytecode.code[jump].dst = static_cast<int>(bytecode.code.size());
+}
+
+BytecodeCompiler::Register BytecodeCompiler::variable(const std::string& name)
+{
+	const auto reg = registers.find(name);
+	if (reg != registers.end()) {
+		return reg->second;
+	}
+	const Variable var = sym_table->lookup(name);
+	Register result(var.type(), 0);
+	if (var.type() == VariableType::Scalar) {
+		result.second = bytecode.scalar_count++;
+	} else {
+		result.second = static_cast<int>(bytecode.matrices.size());
+		bytecode.matrices.push_back(var.dim());
+	}
+	registers.emplace(name, result);
+	return result;
+}
+
+BytecodeCompiler::Register BytecodeCompiler::temporary(VariableType type,
+													   const Dimensions& dim)
+{
+	Register result(type, 0);
+	if (type == VariableType::Scalar) {
+		if (free_scalars.empty()) {
+			result.second = bytecode.scalar_count++;
+		} else {
+			result.second = free_scalars.back();
+			free_scalars.pop_back();
+		}
+	} else {
+		auto& pool = free_matrices[std::make_pair(dim.rows, dim.cols)];
+		if (pool.empty()) {
+			result.second = static_cast<int>(bytecode.matrices.size());
+			bytecode.matrices.push_back(dim);
+		} else {
+			result.second = pool.back();
+			pool.pop_back();
+		}
+	}
+	statement_temporaries.push_back(result);
+	return result;
+}
+
+void BytecodeCompiler::free_temporaries()
+{
+	for (const auto& reg : statement_temporaries) {
+		if (reg.first == VariableType::Scalar) {
+			free_scalars.push_back(reg.second);
+		} else {
+			const Dimensions& dim = bytecode.matrices[static_cast<size_t>(reg.second)];
+			free_matrices[std::make_pair(dim.rows, dim.cols)].push_back(reg.second);
+		}
+	}
+	statement_temporaries.clear();
+}
+
+/** Integer literals are C ints. Operations between them are int operations,
+  * which wrap around on overflow on the machines gcc targets.
+  */
+bool BytecodeCompiler::integral_value(const IRProgram& program, size_t index,
+									  long& value) const
+{
+	const IRValue& ir_value = program.values[index];
+	switch (ir_value.op) {
+		case IROpcode::Constant:
+			if (ir_value.tokens.at(0).category() != TokenCategory::Integer) {
+				return false;
+			}
+			//a leading 0 makes an octal literal
+			value = std::strtol(ir_value.tokens[0].value().c_str(), nullptr, 0);
+			return true;
+		case IROpcode::Add:
+		case IROpcode::Subtract:
+		case IROpcode::Multiply:
+		{
+			long left = 0;
+			long right = 0;
+			if (!integral_value(program, ir_value.operands.at(0), left) ||
+				!integral_value(program, ir_value.operands.at(1), right))
+			{
+				return false;
+			}
+			const unsigned long result =
+				(ir_value.op == IROpcode::Add) ? static_cast<unsigned long>(left) +
+												 static_cast<unsigned long>(right)
+				: (ir_value.op == IROpcode::Subtract) ? static_cast<unsigned long>(left) -
+														static_cast<unsigned long>(right)
+													  : static_cast<unsigned long>(left) *
+														static_cast<unsigned long>(right);
+			if (left >= INT_MIN && left <= INT_MAX && right >= INT_MIN && right <= INT_MAX) {
+				value = static_cast<int>(static_cast<unsigned int>(result));
+			} else {
+				value = static_cast<long>(result);
+			}
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+int BytecodeCompiler::constant(double value)
+{
+	bytecode.constants.push_back(value);
+	return static_cast<int>(bytecode.constants.size() - 1);
+}
+
+void BytecodeCompiler::emit(OpCode op, int dst, int a, int b, int c, int d)
+{
+	bytecode.code.push_back(Instruction{op, dst, a, b, c, d, line});
+}
+
+/** Operands are computed first, thus the last instruction can write to a
+  * variable read by the expression.
+  */
+BytecodeCompiler::Register BytecodeCompiler::compile_value(const IRProgram& program,
+														   size_t index,
+														   const Register& target)
+{
+	const IRValue& value = program.values[index];
+	const bool has_target = target.second >= 0;
+	long literal = 0;
+	if (integral_value(program, index, literal) ||
+		value.op == IROpcode::Constant || value.op == IROpcode::Use ||
+		(value.op == IROpcode::Transpose && value.type == VariableType::Scalar))
+	{
+		Register result(VariableType::Scalar, 0);
+		if (integral_value(program, index, literal)) {
+			result = has_target ? target : temporary(VariableType::Scalar, value.dim);
+			emit(OpCode::LoadConstant, result.second, constant(static_cast<double>(literal)));
+		} else if (value.op == IROpcode::Constant) {
+			result = has_target ? target : temporary(VariableType::Scalar, value.dim);
+			emit(OpCode::LoadConstant, result.second,
+				 constant(std::strtod(value.tokens.at(0).value().c_str(), nullptr)));
+		} else if (value.op == IROpcode::Use) {
+			result = variable(value.name);
+		} else {
+			//tr(<scalar>) is the scalar
+			result = compile_value(program, value.operands.at(0), no_target);
+		}
+		if (has_target && result != target) {
+			emit(result.first == VariableType::Scalar ? OpCode::MoveScalar
+													  : OpCode::MoveMatrix,
+				 target.second, result.second);
+			return target;
+		}
+		return result;
+	}
+	std::vector<Register> operands;
+	for (const auto operand : value.operands)
+		operands.push_back(compile_value(program, operand, no_target));
+	const Register result = has_target ? target : temporary(value.type, value.dim);
+	const int dst = result.second;
+	switch (value.op) {
+		case IROpcode::Element:
+			//A [(int) <expr> 1 - ] [(int) 0 ]
+			emit(OpCode::ReadElement, dst, variable(value.name).second,
+				 operands.at(0).second, operands.at(1).second);
+			break;
+		case IROpcode::Add:
+		case IROpcode::Subtract:
+		case IROpcode::Multiply:
+		{
+			const Register& left = operands.at(0);
+			const Register& right = operands.at(1);
+			if (left.first == VariableType::Scalar && right.first == VariableType::Scalar) {
+				emit(value.op == IROpcode::Add ? OpCode::Add
+					 : value.op == IROpcode::Subtract ? OpCode::Subtract
+													  : OpCode::Multiply,
+					 dst, left.second, right.second);
+			} else if (left.first == VariableType::Matrix &&
+					   right.first == VariableType::Matrix)
+			{
+				emit(value.op == IROpcode::Add ? OpCode::MatrixAdd
+					 : value.op == IROpcode::Subtract ? OpCode::MatrixSubtract
+					 : value.type == VariableType::Scalar ? OpCode::DotProduct
+														  : OpCode::MatrixMultiply,
+					 dst, left.second, right.second);
+			} else if (value.op == IROpcode::Subtract) {
+				//0 - <matrix>
+				emit(OpCode::Negate, dst, right.second);
+			} else {
+				const bool left_scalar = left.first == VariableType::Scalar;
+				emit(OpCode::ScalarMultiply, dst, left_scalar ? left.second : right.second,
+					 left_scalar ? right.second : left.second);
+			}
+			break;
+		}
+		case IROpcode::Transpose:
+			emit(OpCode::Transpose, dst, operands.at(0).second);
+			break;
+		case IROpcode::Sqrt:
+			emit(OpCode::Sqrt, dst, operands.at(0).second);
+			break;
+		case IROpcode::Choose:
+			emit(OpCode::Choose, dst, operands.at(0).second, operands.at(1).second,
+				 operands.at(2).second, operands.at(3).second);
+			break;
+		default:
+			break;
+	}
+	return result;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "symbol_table.hpp"
+#include "definitions.hpp"
+#include "ir.hpp"
+
+/** Instructions of the virtual machine. Registers are either scalar (s) or
+  * matrix (m) registers. Every variable has its own register and the
+  * temporaries of a statement get the free registers of their type and
+  * dimensions.
+  */
+enum class OpCode : unsigned char {
+	LoadConstant,	//s[dst] = constants[a]
+	MoveScalar,		//s[dst] = s[a]
+	MoveMatrix,		//m[dst] = m[a]
+	Add,			//s[dst] = s[a] + s[b]
+	Subtract,		//s[dst] = s[a] - s[b]
+	Multiply,		//s[dst] = s[a] * s[b]
+	MatrixAdd,		//m[dst] = m[a] + m[b]
+	MatrixSubtract,	//m[dst] = m[a] - m[b]
+	MatrixMultiply,	//m[dst] = m[a] * m[b]
+	DotProduct,		//s[dst] = m[a] * m[b] where m[a] is 1xN and m[b] is Nx1
+	ScalarMultiply,	//m[dst] = s[a] * m[b]
+	Negate,			//m[dst] = -m[a]
+	Transpose,		//m[dst] = tr(m[a])
+	Sqrt,			//s[dst] = sqrt(s[a])
+	Choose,			//s[dst] = choose(s[a], s[b], s[c], s[d])
+	ReadElement,	//s[dst] = m[a][(int)s[b]][(int)s[c]]
+	WriteElement,	//m[dst][(int)s[a] - 1][(int)s[b] - 1] = s[c]. b is -1 for
+					//the single subscripts
+	SetElement,		//m[dst].data[a] = s[b]
+	Print,			//print(s[a])
+	PrintMatrix,	//print_mat(m[a])
+	PrintSep,		//printsep()
+	Load,			//load(m[dst], strings[a])
+	JumpIfNotLess,	//if (!(s[a] < s[b])) jump to dst
+	Jump			//jump to dst
+};
+
+struct Instruction {
+	OpCode op;
+	int dst;
+	int a;
+	int b;
+	int c;
+	int d;
+	//source line of the statement
+	int line;
+};
+
+struct Bytecode {
+	std::vector<Instruction> code;
+	std::vector<double> constants;
+	std::vector<std::string> strings;
+	int scalar_count;
+	//dimensions of the matrix registers
+	std::vector<Dimensions> matrices;
+	Bytecode()
+		: code()
+		, constants()
+		, strings()
+		, scalar_count(0)
+		, matrices()
+	{};
+};
+
+/** Lowers the SSA form of a checked program to bytecode.
+  *
+  * Values are computed as the generated C code computes them. Operations
+  * between integer literals are C int operations, thus they are computed at
+  * compile time. Every other operation is a double operation run by the VM.
+  * For statements become the jumps of their C for statements:
+  *
+  *	for (i = <expr1>; i < <expr2> + 1; i += <expr3>)
+  */
+class BytecodeCompiler {
+public:
+	//Takes a ptr to sym_table to assign registers to the variables
+	BytecodeCompiler(const SymbolTable* const sym_table_ptr)
+		: sym_table(sym_table_ptr)
+		, bytecode()
+		, registers()
+		, free_scalars()
+		, free_matrices()
+		, statement_temporaries()
+		, line(0)
+	{ };
+	BytecodeCompiler(const BytecodeCompiler&) = default;
+	BytecodeCompiler& operator=(const BytecodeCompiler&) = default;
+	Bytecode compile(const IRProgram& program);
+private:
+	//a register is a scalar or a matrix register
+	typedef std::pair<VariableType, int> Register;
+	//returns the register of the variable
+	Register variable(const std::string& name);
+	//returns a free temporary register
+	Register temporary(VariableType type, const Dimensions& dim);
+	//frees the temporaries of the current statement
+	void free_temporaries();
+	//returns the register holding the value. The last instruction writes to
+	//target if it is given.
+	Register compile_value(const IRProgram& program, size_t index,
+						   const Register& target);
+	//returns true if the value is a C int and sets its value
+	bool integral_value(const IRProgram& program, size_t index, long& value) const;
+	int constant(double value);
+	void emit(OpCode op, int dst, int a = 0, int b = 0, int c = 0, int d = 0);
+	//writes the increment and the jump back of the loop at the given depth
+	//and fixes the exit jump
+	void compile_loop_end(const IRProgram& program, size_t for_index, size_t depth,
+						  size_t test);
+private:
+	const SymbolTable* const sym_table;
+	Bytecode bytecode;
+	std::map<std::string, Register> registers;
+	std::vector<int> free_scalars;
+	//free matrix registers of each dimension
+	std::map<std::pair<int, int>, std::vector<int>> free_matrices;
+	std::vector<Register> statement_temporaries;
+	int line;
+};
@@ -1,10 +1,15 @@
 #include "code_generator.hpp"
+#include "pass_manager.hpp"
+#include "parallel.hpp"
+#include <exception>
 #include <initializer_list>
 #include <stack>
 #include <fstream>
 #include <algorithm>
 #include <stdexcept>
 #include <sstream>
+#include <cctype>
+#include <cmath>
 
 //given the message list, concatenates them and throws a runtime error
 template<typename T, typename... Args>
@@ -15,45 +20,426 @@ std::string err_linenum(int num);
 //throws a runtime error
 void confirm_type(const Variable&, const VariableType&);
 
-void CodeGenerator::write_program_structure(std::ofstream& ofs) const
+/** Returns the helpers that must be written before each helper. */
+std::map<std::string, std::vector<std::string>> CodeGenerator::helper_dependencies() const
+{
+	std::map<std::string, std::vector<std::string>> deps{
+		{"tr", {"tr_rec"}},
+		{"tr_rec", {"tr_block"}},
+		{"tr_sq_inplace", {"tr_block"}},
+		{"mat_mat_mul_blas", {"cblas", "mat_mat_mul"}},
+		{"mat_sca_mul_blas", {"cblas", "mat_sca_mul", "mat_assign"}},
+		{"mat_mat_mul_s_blas", {"cblas", "mat_mat_mul_s"}},
+		{"print", {"rt_out"}},
+		{"print_mat", {"rt_out"}},
+		{"printsep", {"rt_out"}},
+	};
+	if (!options.entry_point.empty()) {
+		//prints are passed to the callback of the entry point
+		for (const auto& name : {"print", "print_mat", "printsep"}) {
+			deps[name] = {"rt_sink"};
+		}
+	}
+	if (options.threaded_runtime) {
+		//these kernels run on the worker pool
+		for (const auto& name : {"tr", "mat_mat_mul", "mat_mat_add", "mat_mat_sub"}) {
+			deps[name].push_back("rt_pool");
+		}
+	}
+	return deps;
+}
+
+/** Adds the helpers used by the helpers in used_helpers until every
+  * dependency is in the set.
+  */
+void CodeGenerator::add_helper_dependencies() const
+{
+	const auto deps = helper_dependencies();
+	std::vector<std::string> stack(used_helpers.begin(), used_helpers.end());
+	while (!stack.empty()) {
+		const auto it = deps.find(stack.back());
+		stack.pop_back();
+		if (it == deps.end()) {
+			continue;
+		}
+		for (const auto& dep : it->second) {
+			if (used_helpers.insert(dep).second) {
+				stack.push_back(dep);
+			}
+		}
+	}
+}
+
+const std::string& CodeGenerator::use_helper(const std::string& name) const
+{
+	return *used_helpers.insert(name).first;
+}
+
+/** Returns every helper with its writer. Every helper comes after its
+  * dependencies.
+  */
+std::vector<std::pair<std::string, CodeGenerator::helper_writer>>
+CodeGenerator::helper_writers() const
+{
+	return {
+		{"rt_pool", &CodeGenerator::write_thread_pool},
+		{"tr_block", &CodeGenerator::write_tr_block_size},
+		{"tr_rec", &CodeGenerator::write_tr_recursive},
+		{"neg_mat", &CodeGenerator::write_negative_matrix},
+		{"mat_mat_mul", &CodeGenerator::write_matrix_matrix_multiply},
+		{"mat_mat_mul_s", &CodeGenerator::write_vector_dot_product},
+		{"mat_mat_add", &CodeGenerator::write_matrix_matrix_add},
+		{"mat_mat_sub", &CodeGenerator::write_matrix_matrix_subtract},
+		{"mat_sca_mul", &CodeGenerator::write_scalar_matrix_multiply},
+		{"mat_assign", &CodeGenerator::write_matrix_assign},
+		{"cblas", &CodeGenerator::write_blas_prototypes},
+		{"mat_mat_mul_blas", &CodeGenerator::write_blas_matrix_multiply},
+		{"mat_sca_mul_blas", &CodeGenerator::write_blas_scalar_multiply},
+		{"mat_mat_mul_s_blas", &CodeGenerator::write_blas_dot_product},
+		{"tr_sq_inplace", &CodeGenerator::write_tr_inplace},
+		{"tr", &CodeGenerator::write_tr_function},
+		{"choose", &CodeGenerator::write_choose_function},
+		{"rt_out", &CodeGenerator::write_output_buffer},
+		{"rt_sink", &CodeGenerator::write_print_sink},
+		{"print", &CodeGenerator::write_print_function},
+		{"print_mat", &CodeGenerator::write_print_mat_function},
+		{"printsep", &CodeGenerator::write_printsep_function},
+		{"rt_load_bin", &CodeGenerator::write_binary_loader},
+		{"rt_load_csv", &CodeGenerator::write_csv_loader},
+	};
+}
+
+/** Writes the helpers in used_helpers. Every helper is written after its
+  * dependencies.
+  */
+void CodeGenerator::write_program_structure(std::ostream& ofs) const
 {
 	write_preprocessor_commands(ofs);
-	write_negative_matrix(ofs);
-	write_matrix_matrix_multiply(ofs);
-	write_matrix_matrix_add(ofs);
-	write_matrix_matrix_subtract(ofs);
-	write_scalar_matrix_multiply(ofs);
-	write_matrix_assign(ofs);
-	write_tr_function(ofs);
-	write_choose_function(ofs);
-	write_print_function(ofs);
-	write_printsep_function(ofs);
+	if (!options.entry_point.empty()) {
+		//only the entry point is exported from a shared library, thus the
+		//helpers of different programs loaded into a process don't clash
+		ofs << "#pragma GCC visibility push(hidden)" << std::endl;
+	}
+	for (const auto& helper : helper_writers()) {
+		if (used_helpers.count(helper.first) != 0) {
+			(this->*helper.second)(ofs);
+		}
+	}
 }
 
-void CodeGenerator::write_preprocessor_commands(std::ofstream& ofs) const
+void CodeGenerator::write_preprocessor_commands(std::ostream& ofs) const
 {
 	ofs << "#include <stdio.h>" << std::endl;
 	ofs << "#include <math.h>" << std::endl;
+	const bool uses_pool = used_helpers.count("rt_pool") != 0;
+	const bool uses_out = used_helpers.count("rt_out") != 0;
+	if (uses_pool) {
+		ofs << "#include <pthread.h>" << std::endl;
+	}
+	const bool uses_load = used_helpers.count("rt_load_bin") != 0 ||
+						   used_helpers.count("rt_load_csv") != 0;
+	if (uses_pool || uses_out || uses_load) {
+		ofs << "#include <stdlib.h>" << std::endl;
+		ofs << "#include <unistd.h>" << std::endl;
+	}
+	if (uses_out || uses_load) {
+		ofs << "#include <stdint.h>" << std::endl;
+		ofs << "#include <fcntl.h>" << std::endl;
+	}
+	if (uses_out || uses_load || used_helpers.count("memcpy") != 0) {
+		ofs << "#include <string.h>" << std::endl;
+	}
+	if (uses_out) {
+		ofs << "#include <sys/uio.h>" << std::endl;
+	}
+	if (used_helpers.count("rt_load_bin") != 0) {
+		ofs << "#include <sys/mman.h>" << std::endl;
+		ofs << "#include <sys/stat.h>" << std::endl;
+	}
 }
 
-void CodeGenerator::write_tr_function(std::ofstream& ofs) const
+/** Writes a persistent worker pool and rt_parallel_for which splits the rows
+  * of a kernel into tiles and runs them on the pool.
+  *
+  * Each participant (workers and the calling thread) owns a contiguous range
+  * of tiles. When a participant finishes its own range, it steals the
+  * remaining tiles of the others. The pool is started once at the beginning
+  * of main with MATLANG_NUM_THREADS threads (default: number of online cpus).
+  * If the pool is already busy, e.g. when called from an OpenMP loop, the
+  * kernel runs on the calling thread.
+  */
+void CodeGenerator::write_thread_pool(std::ostream& ofs) const
 {
-	//tr function takes the size of the matrix to operate on and also
-	//the result matrix that it is going to write to.
-	ofs << "void tr(int size1, int size2, double matrix[size1][size2], double result[size2][size1])" << std::endl;
+	ofs << "#ifndef RT_MAX_THREADS" << std::endl;
+	ofs << "#define RT_MAX_THREADS 256" << std::endl;
+	ofs << "#endif" << std::endl;
+	//kernels with less work than this run on the calling thread
+	ofs << "#ifndef RT_PARALLEL_MIN_WORK" << std::endl;
+	ofs << "#define RT_PARALLEL_MIN_WORK 262144" << std::endl;
+	ofs << "#endif" << std::endl;
+	//a tile should fit into the cache of a single core
+	ofs << "#ifndef RT_TILE_BYTES" << std::endl;
+	ofs << "#define RT_TILE_BYTES 65536" << std::endl;
+	ofs << "#endif" << std::endl;
+	ofs << std::endl;
+	ofs << "typedef void (*rt_tile_fn)(void* args, int begin, int end);" << std::endl;
+	ofs << std::endl;
+	ofs << "struct rt_kernel_args {" << std::endl;
+	ofs << "\tint size1;" << std::endl;
+	ofs << "\tint size2;" << std::endl;
+	ofs << "\tint size3;" << std::endl;
+	ofs << "\tdouble* mat1;" << std::endl;
+	ofs << "\tdouble* mat2;" << std::endl;
+	ofs << "\tdouble* result;" << std::endl;
+	ofs << "};" << std::endl;
+	ofs << std::endl;
+	ofs << "struct {" << std::endl;
+	ofs << "\tpthread_t threads[RT_MAX_THREADS];" << std::endl;
+	ofs << "\tint size;" << std::endl;
+	ofs << "\tpthread_mutex_t busy;" << std::endl;
+	ofs << "\tpthread_mutex_t lock;" << std::endl;
+	ofs << "\tpthread_cond_t job_ready;" << std::endl;
+	ofs << "\tpthread_cond_t job_done;" << std::endl;
+	ofs << "\tunsigned long generation;" << std::endl;
+	ofs << "\tint running;" << std::endl;
+	ofs << "\tint stop;" << std::endl;
+	ofs << "\trt_tile_fn fn;" << std::endl;
+	ofs << "\tvoid* args;" << std::endl;
+	ofs << "\tint count;" << std::endl;
+	ofs << "\tint tile;" << std::endl;
+	ofs << "\tint next[RT_MAX_THREADS];" << std::endl;
+	ofs << "\tint end[RT_MAX_THREADS];" << std::endl;
+	ofs << "} rt_pool;" << std::endl;
+	ofs << std::endl;
+	ofs << "void rt_run_tiles(int self)" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tint p;" << std::endl;
+	ofs << "\tint tile;" << std::endl;
+	ofs << "\tfor (p = 0; p < rt_pool.size; ++p) {" << std::endl;
+	ofs << "\t\tint victim = (self + p) % rt_pool.size;" << std::endl;
+	ofs << "\t\twhile ((tile = __atomic_fetch_add(&rt_pool.next[victim], 1, __ATOMIC_RELAXED)) < rt_pool.end[victim]) {" << std::endl;
+	ofs << "\t\t\tint begin = tile * rt_pool.tile;" << std::endl;
+	ofs << "\t\t\tint end = begin + rt_pool.tile;" << std::endl;
+	ofs << "\t\t\trt_pool.fn(rt_pool.args, begin, end < rt_pool.count ? end : rt_pool.count);" << std::endl;
+	ofs << "\t\t}" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+	ofs << "void* rt_worker(void* arg)" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tint self = (int)(long)arg;" << std::endl;
+	ofs << "\tunsigned long seen = 0;" << std::endl;
+	ofs << "\tpthread_mutex_lock(&rt_pool.lock);" << std::endl;
+	ofs << "\tfor (;;) {" << std::endl;
+	ofs << "\t\twhile (rt_pool.generation == seen && !rt_pool.stop)" << std::endl;
+	ofs << "\t\t\tpthread_cond_wait(&rt_pool.job_ready, &rt_pool.lock);" << std::endl;
+	ofs << "\t\tif (rt_pool.stop)" << std::endl;
+	ofs << "\t\t\tbreak;" << std::endl;
+	ofs << "\t\tseen = rt_pool.generation;" << std::endl;
+	ofs << "\t\tpthread_mutex_unlock(&rt_pool.lock);" << std::endl;
+	ofs << "\t\trt_run_tiles(self);" << std::endl;
+	ofs << "\t\tpthread_mutex_lock(&rt_pool.lock);" << std::endl;
+	ofs << "\t\tif (--rt_pool.running == 0)" << std::endl;
+	ofs << "\t\t\tpthread_cond_signal(&rt_pool.job_done);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\tpthread_mutex_unlock(&rt_pool.lock);" << std::endl;
+	ofs << "\treturn NULL;" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+	ofs << "void rt_pool_start()" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tconst char* env = getenv(\"MATLANG_NUM_THREADS\");" << std::endl;
+	ofs << "\tlong size = env ? strtol(env, NULL, 10) : sysconf(_SC_NPROCESSORS_ONLN);" << std::endl;
+	ofs << "\tlong p;" << std::endl;
+	ofs << "\tif (size > RT_MAX_THREADS)" << std::endl;
+	ofs << "\t\tsize = RT_MAX_THREADS;" << std::endl;
+	ofs << "\tpthread_mutex_init(&rt_pool.busy, NULL);" << std::endl;
+	ofs << "\tpthread_mutex_init(&rt_pool.lock, NULL);" << std::endl;
+	ofs << "\tpthread_cond_init(&rt_pool.job_ready, NULL);" << std::endl;
+	ofs << "\tpthread_cond_init(&rt_pool.job_done, NULL);" << std::endl;
+	ofs << "\trt_pool.size = 1;" << std::endl;
+	ofs << "\tfor (p = 1; p < size; ++p) {" << std::endl;
+	ofs << "\t\tif (pthread_create(&rt_pool.threads[p], NULL, rt_worker, (void*)p) != 0)" << std::endl;
+	ofs << "\t\t\tbreak;" << std::endl;
+	ofs << "\t\trt_pool.size = (int)p + 1;" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+	ofs << "void rt_pool_stop()" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tint p;" << std::endl;
+	ofs << "\tpthread_mutex_lock(&rt_pool.lock);" << std::endl;
+	ofs << "\trt_pool.stop = 1;" << std::endl;
+	ofs << "\tpthread_cond_broadcast(&rt_pool.job_ready);" << std::endl;
+	ofs << "\tpthread_mutex_unlock(&rt_pool.lock);" << std::endl;
+	ofs << "\tfor (p = 1; p < rt_pool.size; ++p)" << std::endl;
+	ofs << "\t\tpthread_join(rt_pool.threads[p], NULL);" << std::endl;
+	ofs << "\trt_pool.size = 1;" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+	//number of rows of a tile that has row_size doubles in a row
+	ofs << "int rt_tile_rows(int row_size)" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tint rows = (int)(RT_TILE_BYTES / (sizeof(double) * (row_size > 0 ? row_size : 1)));" << std::endl;
+	ofs << "\treturn rows > 0 ? rows : 1;" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+	ofs << "void rt_parallel_for(rt_tile_fn fn, void* args, int count, int tile)" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tint tiles = (count + tile - 1) / tile;" << std::endl;
+	ofs << "\tint p;" << std::endl;
+	ofs << "\tif (rt_pool.size <= 1 || tiles <= 1 || pthread_mutex_trylock(&rt_pool.busy) != 0) {" << std::endl;
+	ofs << "\t\tfn(args, 0, count);" << std::endl;
+	ofs << "\t\treturn;" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\tpthread_mutex_lock(&rt_pool.lock);" << std::endl;
+	ofs << "\trt_pool.fn = fn;" << std::endl;
+	ofs << "\trt_pool.args = args;" << std::endl;
+	ofs << "\trt_pool.count = count;" << std::endl;
+	ofs << "\trt_pool.tile = tile;" << std::endl;
+	ofs << "\tfor (p = 0; p < rt_pool.size; ++p) {" << std::endl;
+	ofs << "\t\trt_pool.next[p] = (int)((long)tiles * p / rt_pool.size);" << std::endl;
+	ofs << "\t\trt_pool.end[p] = (int)((long)tiles * (p + 1) / rt_pool.size);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\trt_pool.running = rt_pool.size - 1;" << std::endl;
+	ofs << "\t++rt_pool.generation;" << std::endl;
+	ofs << "\tpthread_cond_broadcast(&rt_pool.job_ready);" << std::endl;
+	ofs << "\tpthread_mutex_unlock(&rt_pool.lock);" << std::endl;
+	ofs << "\trt_run_tiles(0);" << std::endl;
+	ofs << "\tpthread_mutex_lock(&rt_pool.lock);" << std::endl;
+	ofs << "\twhile (rt_pool.running > 0)" << std::endl;
+	ofs << "\t\tpthread_cond_wait(&rt_pool.job_done, &rt_pool.lock);" << std::endl;
+	ofs << "\tpthread_mutex_unlock(&rt_pool.lock);" << std::endl;
+	ofs << "\tpthread_mutex_unlock(&rt_pool.busy);" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+}
+
+/** Writes a kernel that computes the rows [begin, end) of its result in
+  * rows_name and a wrapper with the given signature that runs it on the
+  * thread pool when the work is large enough.
+  *
+  * args_init initializes a struct rt_kernel_args named args from the
+  * parameters of the wrapper. rows_body uses a, the pointer to the args, and
+  * the row pointers declared by row_decls.
+  */
+void CodeGenerator::write_threaded_kernel(std::ostream& ofs,
+										  const std::string& signature,
+										  const std::string& rows_name,
+										  const std::string& args_init,
+										  const std::string& row_decls,
+										  const std::string& rows_body,
+										  const std::string& work,
+										  const std::string& row_size) const
+{
+	ofs << "void " << rows_name << "(void* args, int begin, int end)" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tstruct rt_kernel_args* a = (struct rt_kernel_args*)args;" << std::endl;
+	ofs << row_decls;
+	ofs << rows_body;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+	ofs << signature << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tstruct rt_kernel_args args = " << args_init << ";" << std::endl;
+	ofs << "\tif (" << work << " < RT_PARALLEL_MIN_WORK)" << std::endl;
+	ofs << "\t\t" << rows_name << "(&args, 0, args.size1);" << std::endl;
+	ofs << "\telse" << std::endl;
+	ofs << "\t\trt_parallel_for(" << rows_name << ", &args, args.size1, rt_tile_rows("
+		<< row_size << "));" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+}
+
+void CodeGenerator::write_tr_block_size(std::ostream& ofs) const
+{
+	ofs << "#ifndef RT_TR_BLOCK" << std::endl;
+	ofs << "#define RT_TR_BLOCK 32" << std::endl;
+	ofs << "#endif" << std::endl;
+}
+
+/** Writes a cache oblivious transpose. tr_rec halves the longer side of the
+  * block until it is at most RT_TR_BLOCK x RT_TR_BLOCK, so both the reads and
+  * the writes of a block stay in the cache whatever its size is.
+  */
+void CodeGenerator::write_tr_recursive(std::ostream& ofs) const
+{
+	//rows of src and dst are src_stride and dst_stride doubles apart
+	ofs << "void tr_rec(int rows, int cols, const double* src, int src_stride, double* dst, int dst_stride)" << std::endl;
 	ofs << "{" << std::endl;
 	ofs << "\tint i;" << std::endl;
 	ofs << "\tint j;" << std::endl;
-	ofs << "\tfor (i = 0; i < size1; ++i) {" << std::endl;
-	ofs << "\t\tfor (j = 0; j < size2; ++j) {" << std::endl;
-	ofs << "\t\t\tresult[j][i] = matrix[i][j];" << std::endl;
+	ofs << "\tif (rows <= RT_TR_BLOCK && cols <= RT_TR_BLOCK) {" << std::endl;
+	ofs << "\t\tfor (i = 0; i < rows; ++i) {" << std::endl;
+	ofs << "\t\t\tfor (j = 0; j < cols; ++j) {" << std::endl;
+	ofs << "\t\t\t\tdst[j * dst_stride + i] = src[i * src_stride + j];" << std::endl;
+	ofs << "\t\t\t}" << std::endl;
+	ofs << "\t\t}" << std::endl;
+	ofs << "\t} else if (rows >= cols) {" << std::endl;
+	ofs << "\t\ti = rows / 2;" << std::endl;
+	ofs << "\t\ttr_rec(i, cols, src, src_stride, dst, dst_stride);" << std::endl;
+	ofs << "\t\ttr_rec(rows - i, cols, src + i * src_stride, src_stride, dst + i, dst_stride);" << std::endl;
+	ofs << "\t} else {" << std::endl;
+	ofs << "\t\tj = cols / 2;" << std::endl;
+	ofs << "\t\ttr_rec(rows, j, src, src_stride, dst, dst_stride);" << std::endl;
+	ofs << "\t\ttr_rec(rows, cols - j, src + j, src_stride, dst + j * dst_stride, dst_stride);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+}
+
+/** Writes tr_sq_inplace which transposes a square matrix in place by swapping
+  * the blocks above the diagonal with the ones below it.
+  */
+void CodeGenerator::write_tr_inplace(std::ostream& ofs) const
+{
+	ofs << "void tr_sq_inplace(int size, double matrix[size][size])" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tint ii;" << std::endl;
+	ofs << "\tint jj;" << std::endl;
+	ofs << "\tint i;" << std::endl;
+	ofs << "\tint j;" << std::endl;
+	ofs << "\tfor (ii = 0; ii < size; ii += RT_TR_BLOCK) {" << std::endl;
+	ofs << "\t\tconst int i_end = (ii + RT_TR_BLOCK < size) ? ii + RT_TR_BLOCK : size;" << std::endl;
+	ofs << "\t\tfor (jj = ii; jj < size; jj += RT_TR_BLOCK) {" << std::endl;
+	ofs << "\t\t\tconst int j_end = (jj + RT_TR_BLOCK < size) ? jj + RT_TR_BLOCK : size;" << std::endl;
+	ofs << "\t\t\tfor (i = ii; i < i_end; ++i) {" << std::endl;
+	ofs << "\t\t\t\tfor (j = (ii == jj) ? i + 1 : jj; j < j_end; ++j) {" << std::endl;
+	ofs << "\t\t\t\t\tconst double tmp = matrix[i][j];" << std::endl;
+	ofs << "\t\t\t\t\tmatrix[i][j] = matrix[j][i];" << std::endl;
+	ofs << "\t\t\t\t\tmatrix[j][i] = tmp;" << std::endl;
+	ofs << "\t\t\t\t}" << std::endl;
+	ofs << "\t\t\t}" << std::endl;
 	ofs << "\t\t}" << std::endl;
 	ofs << "\t}" << std::endl;
 	ofs << "}" << std::endl;
 	ofs << std::endl;
 }
 
-void CodeGenerator::write_choose_function(std::ofstream& ofs) const
+void CodeGenerator::write_tr_function(std::ostream& ofs) const
+{
+	if (options.threaded_runtime) {
+		//each tile transposes a range of rows into a range of columns
+		write_threaded_kernel(ofs,
+			"void tr(int size1, int size2, double matrix[size1][size2], double result[size2][size1])",
+			"tr_rows",
+			"{size1, size2, 0, &matrix[0][0], 0, &result[0][0]}",
+			"",
+			"\ttr_rec(end - begin, a->size2, a->mat1 + (long)begin * a->size2, a->size2,\n"
+			"\t\t   a->result + begin, a->size1);\n",
+			"(double)size1 * size2", "size2");
+		return;
+	}
+	//tr function takes the size of the matrix to operate on and also
+	//the result matrix that it is going to write to.
+	ofs << "void tr(int size1, int size2, double matrix[size1][size2], double result[size2][size1])" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\ttr_rec(size1, size2, &matrix[0][0], size2, &result[0][0], size1);" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+}
+
+void CodeGenerator::write_choose_function(std::ostream& ofs) const
 {
 	ofs << "double choose(int condition, double first, double second, double third)"
 		<< std::endl;
@@ -69,44 +455,497 @@ void CodeGenerator::write_choose_function(std::ofstream& ofs) const
 	ofs << std::endl;
 }
 
-void CodeGenerator::write_print_function(std::ofstream& ofs) const
+/** Writes the output buffer of the print functions. The output is collected
+  * in a buffer of RT_OUT_BYTES bytes and written to stdout when the buffer is
+  * full and at the end of main.
+  *
+  * If the environment variable MATLANG_BINARY_OUT (or the macro RT_BINARY_OUT
+  * when it is not set) is a file name, or "-" for stdout, every print writes
+  * a binary record to that file instead: the number of rows and columns as
+  * 32 bit integers and the values in row major order as doubles, all little
+  * endian. A scalar is a 1x1 record and printsep is a 0x0 record. Records
+  * larger than half of the buffer are written with writev without a copy.
+  *
+  * rt_out_double writes a double exactly as printf("%g") does. The value is
+  * scaled to 6 digits with an exact power of ten, thus the scaled value has
+  * a relative error of at most 2^-53. If this error can change the rounding of
+  * the last digit, or the value is out of the range of the exact powers,
+  * snprintf is used instead.
+  */
+void CodeGenerator::write_output_buffer(std::ostream& ofs) const
+{
+	ofs << "#ifndef RT_OUT_BYTES" << std::endl;
+	ofs << "#define RT_OUT_BYTES 65536" << std::endl;
+	ofs << "#endif" << std::endl;
+	ofs << "char rt_out_buf[RT_OUT_BYTES];" << std::endl;
+	ofs << "int rt_out_len = 0;" << std::endl;
+	ofs << std::endl;
+	ofs << "#ifndef RT_BINARY_OUT" << std::endl;
+	ofs << "#define RT_BINARY_OUT 0" << std::endl;
+	ofs << "#endif" << std::endl;
+	//-2 if the output mode is not chosen yet, -1 for text output
+	ofs << "int rt_bin_fd = -2;" << std::endl;
+	ofs << std::endl;
+	ofs << "int rt_binary_out()" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tif (rt_bin_fd == -2) {" << std::endl;
+	ofs << "\t\tconst char* path = getenv(\"MATLANG_BINARY_OUT\");" << std::endl;
+	ofs << "\t\tif (path == 0)" << std::endl;
+	ofs << "\t\t\tpath = RT_BINARY_OUT;" << std::endl;
+	ofs << "\t\tif (path == 0 || path[0] == '\\0') {" << std::endl;
+	ofs << "\t\t\trt_bin_fd = -1;" << std::endl;
+	ofs << "\t\t} else if (strcmp(path, \"-\") == 0) {" << std::endl;
+	ofs << "\t\t\trt_bin_fd = 1;" << std::endl;
+	ofs << "\t\t} else {" << std::endl;
+	ofs << "\t\t\trt_bin_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);" << std::endl;
+	ofs << "\t\t\tif (rt_bin_fd < 0) {" << std::endl;
+	ofs << "\t\t\t\tperror(path);" << std::endl;
+	ofs << "\t\t\t\texit(1);" << std::endl;
+	ofs << "\t\t\t}" << std::endl;
+	ofs << "\t\t}" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\treturn rt_bin_fd >= 0;" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+	//writes every iovec, retrying after partial writes
+	ofs << "void rt_writev_all(struct iovec* iov, int count)" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\twhile (count > 0) {" << std::endl;
+	ofs << "\t\tssize_t written = writev(rt_bin_fd, iov, count);" << std::endl;
+	ofs << "\t\tif (written < 0) {" << std::endl;
+	ofs << "\t\t\tperror(\"writev\");" << std::endl;
+	//exit would flush the output again
+	ofs << "\t\t\t_exit(1);" << std::endl;
+	ofs << "\t\t}" << std::endl;
+	ofs << "\t\twhile (count > 0 && (size_t)written >= iov->iov_len) {" << std::endl;
+	ofs << "\t\t\twritten -= (ssize_t)iov->iov_len;" << std::endl;
+	ofs << "\t\t\t++iov;" << std::endl;
+	ofs << "\t\t\t--count;" << std::endl;
+	ofs << "\t\t}" << std::endl;
+	ofs << "\t\tif (count > 0) {" << std::endl;
+	ofs << "\t\t\tiov->iov_base = (char*)iov->iov_base + written;" << std::endl;
+	ofs << "\t\t\tiov->iov_len -= (size_t)written;" << std::endl;
+	ofs << "\t\t}" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+	//registered with atexit by main, thus the output is written on every
+	//exit of the program
+	ofs << "void rt_out_flush()" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tconst int len = rt_out_len;" << std::endl;
+	ofs << "\trt_out_len = 0;" << std::endl;
+	ofs << "\tif (rt_bin_fd >= 0) {" << std::endl;
+	ofs << "\t\tstruct iovec iov;" << std::endl;
+	ofs << "\t\tiov.iov_base = rt_out_buf;" << std::endl;
+	ofs << "\t\tiov.iov_len = (size_t)len;" << std::endl;
+	ofs << "\t\trt_writev_all(&iov, 1);" << std::endl;
+	ofs << "\t} else {" << std::endl;
+	ofs << "\t\tfwrite(rt_out_buf, 1, len, stdout);" << std::endl;
+	ofs << "\t\tfflush(stdout);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+	//returns the end of the buffer after making room for count characters
+	ofs << "char* rt_out_reserve(int count)" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tif (rt_out_len + count > RT_OUT_BYTES)" << std::endl;
+	ofs << "\t\trt_out_flush();" << std::endl;
+	ofs << "\treturn rt_out_buf + rt_out_len;" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+	ofs << "void rt_out_str(const char* str)" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tfor (; *str; ++str) {" << std::endl;
+	ofs << "\t\t*rt_out_reserve(1) = *str;" << std::endl;
+	ofs << "\t\t++rt_out_len;" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+	//powers of ten that are exactly representable as doubles
+	ofs << "const double rt_pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};" << std::endl;
+	ofs << std::endl;
+	ofs << "void rt_out_double(double value)" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tchar* const out = rt_out_reserve(32);" << std::endl;
+	ofs << "\tchar* p = out;" << std::endl;
+	ofs << "\tconst double abs_value = fabs(value);" << std::endl;
+	ofs << "\tchar digits[6];" << std::endl;
+	ofs << "\tint count = 6;" << std::endl;
+	ofs << "\tint exponent;" << std::endl;
+	ofs << "\tlong scaled;" << std::endl;
+	ofs << "\tdouble m;" << std::endl;
+	ofs << "\tint i;" << std::endl;
+	ofs << "\tif (value < 0)" << std::endl;
+	ofs << "\t\t*p++ = '-';" << std::endl;
+	//integers with at most 6 digits are printed as they are
+	ofs << "\tif (abs_value < 1e6 && abs_value == (long)abs_value && (value != 0 || !signbit(value))) {" << std::endl;
+	ofs << "\t\tscaled = (long)abs_value;" << std::endl;
+	ofs << "\t\ti = 0;" << std::endl;
+	ofs << "\t\tdo {" << std::endl;
+	ofs << "\t\t\tdigits[i++] = (char)('0' + scaled % 10);" << std::endl;
+	ofs << "\t\t\tscaled /= 10;" << std::endl;
+	ofs << "\t\t} while (scaled != 0);" << std::endl;
+	ofs << "\t\twhile (i > 0)" << std::endl;
+	ofs << "\t\t\t*p++ = digits[--i];" << std::endl;
+	ofs << "\t\trt_out_len += (int)(p - out);" << std::endl;
+	ofs << "\t\treturn;" << std::endl;
+	ofs << "\t}" << std::endl;
+	//negated condition is also true for nan
+	ofs << "\tif (!(abs_value >= 1e-15 && abs_value < 1e21)) {" << std::endl;
+	ofs << "\t\trt_out_len += snprintf(out, 32, \"%g\", value);" << std::endl;
+	ofs << "\t\treturn;" << std::endl;
+	ofs << "\t}" << std::endl;
+	//m = abs_value * 10^(5 - exponent) is in [1e5, 1e6)
+	ofs << "\texponent = (int)floor(log10(abs_value));" << std::endl;
+	ofs << "\tfor (i = 0; i < 2; ++i) {" << std::endl;
+	ofs << "\t\tm = (exponent <= 5) ? abs_value * rt_pow10[5 - exponent] : abs_value / rt_pow10[exponent - 5];" << std::endl;
+	ofs << "\t\tif (m < 1e5)" << std::endl;
+	ofs << "\t\t\t--exponent;" << std::endl;
+	ofs << "\t\telse if (m >= 1e6)" << std::endl;
+	ofs << "\t\t\t++exponent;" << std::endl;
+	ofs << "\t\telse" << std::endl;
+	ofs << "\t\t\tbreak;" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\tif (fabs(m - floor(m) - 0.5) < 1e-6) {" << std::endl;
+	ofs << "\t\trt_out_len += snprintf(out, 32, \"%g\", value);" << std::endl;
+	ofs << "\t\treturn;" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\tscaled = (long)(m + 0.5);" << std::endl;
+	ofs << "\tif (scaled == 1000000) {" << std::endl;
+	ofs << "\t\tscaled = 100000;" << std::endl;
+	ofs << "\t\t++exponent;" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\tfor (i = 5; i >= 0; --i) {" << std::endl;
+	ofs << "\t\tdigits[i] = (char)('0' + scaled % 10);" << std::endl;
+	ofs << "\t\tscaled /= 10;" << std::endl;
+	ofs << "\t}" << std::endl;
+	//%g removes the trailing zeros
+	ofs << "\twhile (count > 1 && digits[count - 1] == '0')" << std::endl;
+	ofs << "\t\t--count;" << std::endl;
+	ofs << "\tif (exponent >= -4 && exponent < 6) {" << std::endl;
+	ofs << "\t\tif (exponent < 0) {" << std::endl;
+	ofs << "\t\t\t*p++ = '0';" << std::endl;
+	ofs << "\t\t\t*p++ = '.';" << std::endl;
+	ofs << "\t\t\tfor (i = -1; i > exponent; --i)" << std::endl;
+	ofs << "\t\t\t\t*p++ = '0';" << std::endl;
+	ofs << "\t\t\tfor (i = 0; i < count; ++i)" << std::endl;
+	ofs << "\t\t\t\t*p++ = digits[i];" << std::endl;
+	ofs << "\t\t} else {" << std::endl;
+	ofs << "\t\t\tfor (i = 0; i <= exponent; ++i)" << std::endl;
+	ofs << "\t\t\t\t*p++ = digits[i];" << std::endl;
+	ofs << "\t\t\tif (count > exponent + 1)" << std::endl;
+	ofs << "\t\t\t\t*p++ = '.';" << std::endl;
+	ofs << "\t\t\tfor (; i < count; ++i)" << std::endl;
+	ofs << "\t\t\t\t*p++ = digits[i];" << std::endl;
+	ofs << "\t\t}" << std::endl;
+	ofs << "\t} else {" << std::endl;
+	ofs << "\t\t*p++ = digits[0];" << std::endl;
+	ofs << "\t\tif (count > 1)" << std::endl;
+	ofs << "\t\t\t*p++ = '.';" << std::endl;
+	ofs << "\t\tfor (i = 1; i < count; ++i)" << std::endl;
+	ofs << "\t\t\t*p++ = digits[i];" << std::endl;
+	ofs << "\t\t*p++ = 'e';" << std::endl;
+	ofs << "\t\t*p++ = (exponent < 0) ? '-' : '+';" << std::endl;
+	ofs << "\t\texponent = (exponent < 0) ? -exponent : exponent;" << std::endl;
+	ofs << "\t\t*p++ = (char)('0' + exponent / 10);" << std::endl;
+	ofs << "\t\t*p++ = (char)('0' + exponent % 10);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\trt_out_len += (int)(p - out);" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+	//copies size bytes of value to the buffer in little endian order
+	ofs << "void rt_bin_put(const void* value, int size)" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tchar* const out = rt_out_reserve(size);" << std::endl;
+	ofs << "#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__" << std::endl;
+	ofs << "\tint i;" << std::endl;
+	ofs << "\tfor (i = 0; i < size; ++i)" << std::endl;
+	ofs << "\t\tout[i] = ((const char*)value)[size - 1 - i];" << std::endl;
+	ofs << "#else" << std::endl;
+	ofs << "\tmemcpy(out, value, (size_t)size);" << std::endl;
+	ofs << "#endif" << std::endl;
+	ofs << "\trt_out_len += size;" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+	ofs << "void rt_bin_record(int rows, int cols, const double* data)" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tconst int32_t header[2] = {rows, cols};" << std::endl;
+	ofs << "\tconst size_t bytes = (size_t)rows * (size_t)cols * sizeof(double);" << std::endl;
+	ofs << "\tsize_t i;" << std::endl;
+	ofs << "#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__" << std::endl;
+	ofs << "\tif (bytes > RT_OUT_BYTES / 2) {" << std::endl;
+	ofs << "\t\tstruct iovec iov[2];" << std::endl;
+	ofs << "\t\trt_out_flush();" << std::endl;
+	ofs << "\t\tiov[0].iov_base = (void*)header;" << std::endl;
+	ofs << "\t\tiov[0].iov_len = sizeof(header);" << std::endl;
+	ofs << "\t\tiov[1].iov_base = (void*)data;" << std::endl;
+	ofs << "\t\tiov[1].iov_len = bytes;" << std::endl;
+	ofs << "\t\trt_writev_all(iov, 2);" << std::endl;
+	ofs << "\t\treturn;" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "#endif" << std::endl;
+	ofs << "\trt_bin_put(&header[0], 4);" << std::endl;
+	ofs << "\trt_bin_put(&header[1], 4);" << std::endl;
+	ofs << "\tfor (i = 0; i < bytes / sizeof(double); ++i)" << std::endl;
+	ofs << "\t\trt_bin_put(&data[i], sizeof(double));" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+}
+
+/** Writes the callback the prints of the entry point are passed to. A print
+  * is passed as a matrix of values in row major order, a scalar as a 1x1
+  * matrix and printsep as a 0x0 matrix, like the records of the binary
+  * output. The callback is thread local and restored when the entry point
+  * returns, thus the entry point may run on many threads at once.
+  */
+void CodeGenerator::write_print_sink(std::ostream& ofs) const
+{
+	ofs << "typedef void (*matlang_print_fn)(void* context, int rows, int cols,"
+		" const double* values);" << std::endl;
+	ofs << "static _Thread_local matlang_print_fn rt_sink;" << std::endl;
+	ofs << "static _Thread_local void* rt_sink_context;" << std::endl;
+	ofs << std::endl;
+}
+
+void CodeGenerator::write_print_function(std::ostream& ofs) const
 {
-	//For writing doubles as integers when they are "equal" to integers,
-	//we do a check. If not "integer", then we print it with 7 precision.
 	ofs << "void print(double value)" << std::endl;
 	ofs << "{" << std::endl;
-	ofs << "\tprintf(\"%g\\n\", value);" << std::endl;
+	if (!options.entry_point.empty()) {
+		ofs << "	rt_sink(rt_sink_context, 1, 1, &value);" << std::endl;
+		ofs << "}" << std::endl;
+		ofs << std::endl;
+		return;
+	}
+	ofs << "\tif (rt_binary_out()) {" << std::endl;
+	ofs << "\t\trt_bin_record(1, 1, &value);" << std::endl;
+	ofs << "\t\treturn;" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\trt_out_double(value);" << std::endl;
+	ofs << "\trt_out_str(\"\\n\");" << std::endl;
 	ofs << "}" << std::endl;
 	ofs << std::endl;
+}
+
+void CodeGenerator::write_print_mat_function(std::ostream& ofs) const
+{
 	//Matrices should have their own function for printing
 	ofs << "void print_mat(int size1, int size2, double matrix[size1][size2])" << std::endl;
 	ofs << "{" << std::endl;
+	if (!options.entry_point.empty()) {
+		ofs << "	rt_sink(rt_sink_context, size1, size2, &matrix[0][0]);" << std::endl;
+		ofs << "}" << std::endl;
+		ofs << std::endl;
+		return;
+	}
 	ofs << "\tint i;" << std::endl;
 	ofs << "\tint j;" << std::endl;
+	ofs << "\tif (rt_binary_out()) {" << std::endl;
+	ofs << "\t\trt_bin_record(size1, size2, &matrix[0][0]);" << std::endl;
+	ofs << "\t\treturn;" << std::endl;
+	ofs << "\t}" << std::endl;
 	ofs << "\tfor (i = 0; i < size1; ++i) {" << std::endl;
 	ofs << "\t\tfor (j = 0; j < size2; ++j) {" << std::endl;
-	ofs << "\t\t\tdouble value = matrix[i][j];" << std::endl;
-	ofs << "\t\t\tprintf(\"%g\", value);" << std::endl;
+	ofs << "\t\t\trt_out_double(matrix[i][j]);" << std::endl;
 	ofs << "\t\t\tif (j != size2 - 1)" << std::endl;
-	ofs << "\t\t\t\tprintf(\"\\t\");" << std::endl;
+	ofs << "\t\t\t\trt_out_str(\"\\t\");" << std::endl;
 	ofs << "\t\t}" << std::endl;
-	ofs << "\t\t\tprintf(\"\\n\");" << std::endl;
+	ofs << "\t\trt_out_str(\"\\n\");" << std::endl;
 	ofs << "\t}" << std::endl;
 	ofs << "}" << std::endl;
 	ofs << std::endl;
 }
+/** Writes rt_load_bin which maps a binary matrix file, checks its header and
+  * returns a pointer to its values without copying them. The mapping is
+  * private, thus assignments to the matrix don't change the file. On big
+  * endian machines, the values are swapped into the storage of the matrix.
+  */
+void CodeGenerator::write_binary_loader(std::ostream& ofs) const
+{
+	ofs << "double* rt_load_bin(const char* path, int rows, int cols, double* storage)" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tconst size_t bytes = (size_t)rows * (size_t)cols * sizeof(double);" << std::endl;
+	ofs << "\tint32_t header[2] = {0, 0};" << std::endl;
+	ofs << "\tstruct stat st;" << std::endl;
+	ofs << "\tchar* map;" << std::endl;
+	ofs << "\tdouble* values;" << std::endl;
+	ofs << "#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__" << std::endl;
+	ofs << "\tsize_t i;" << std::endl;
+	ofs << "#endif" << std::endl;
+	ofs << "\tint fd = open(path, O_RDONLY);" << std::endl;
+	ofs << "\tif (fd < 0 || fstat(fd, &st) != 0) {" << std::endl;
+	ofs << "\t\tperror(path);" << std::endl;
+	ofs << "\t\texit(1);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\tif ((size_t)st.st_size != sizeof(header) + bytes) {" << std::endl;
+	ofs << "\t\tfprintf(stderr, \"%s: expected a %dx%d matrix\\n\", path, rows, cols);" << std::endl;
+	ofs << "\t\texit(1);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\tmap = (char*)mmap(0, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);" << std::endl;
+	ofs << "\tclose(fd);" << std::endl;
+	ofs << "\tif (map == MAP_FAILED) {" << std::endl;
+	ofs << "\t\tperror(path);" << std::endl;
+	ofs << "\t\texit(1);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__" << std::endl;
+	ofs << "\tfor (i = 0; i < sizeof(header); ++i)" << std::endl;
+	ofs << "\t\t((char*)header)[i] = map[i ^ 3];" << std::endl;
+	ofs << "\tfor (i = 0; i < bytes; ++i)" << std::endl;
+	ofs << "\t\t((char*)storage)[i] = map[sizeof(header) + (i ^ 7)];" << std::endl;
+	ofs << "\tmunmap(map, (size_t)st.st_size);" << std::endl;
+	ofs << "\tvalues = storage;" << std::endl;
+	ofs << "#else" << std::endl;
+	ofs << "\t(void)storage;" << std::endl;
+	ofs << "\tmemcpy(header, map, sizeof(header));" << std::endl;
+	ofs << "\tvalues = (double*)(map + sizeof(header));" << std::endl;
+	ofs << "#endif" << std::endl;
+	ofs << "\tif (header[0] != rows || header[1] != cols) {" << std::endl;
+	ofs << "\t\tfprintf(stderr, \"%s: expected a %dx%d matrix, found %dx%d\\n\", path, rows, cols, (int)header[0], (int)header[1]);" << std::endl;
+	ofs << "\t\texit(1);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\treturn values;" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+}
+
+/** Writes rt_load_csv which reads a file of comma separated values into the
+  * storage of the matrix. The file is read in chunks of RT_CSV_CHUNK bytes
+  * and memchr finds the end of each line. Blank lines are skipped.
+  */
+void CodeGenerator::write_csv_loader(std::ostream& ofs) const
+{
+	ofs << "#ifndef RT_CSV_CHUNK" << std::endl;
+	ofs << "#define RT_CSV_CHUNK (1 << 20)" << std::endl;
+	ofs << "#endif" << std::endl;
+	//parses a line into row. Returns 0 for a blank line. row is 0 if the
+	//matrix has no more rows.
+	ofs << "int rt_csv_line(char* line, const char* path, int line_num, int cols, double* row)" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tchar* end;" << std::endl;
+	ofs << "\tint j;" << std::endl;
+	ofs << "\twhile (*line == ' ' || *line == '\\t' || *line == '\\r')" << std::endl;
+	ofs << "\t\t++line;" << std::endl;
+	ofs << "\tif (*line == '\\0')" << std::endl;
+	ofs << "\t\treturn 0;" << std::endl;
+	ofs << "\tif (row == 0) {" << std::endl;
+	ofs << "\t\tfprintf(stderr, \"%s:%d: too many rows\\n\", path, line_num);" << std::endl;
+	ofs << "\t\texit(1);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\tfor (j = 0; j < cols; ++j) {" << std::endl;
+	ofs << "\t\trow[j] = strtod(line, &end);" << std::endl;
+	ofs << "\t\tif (end == line)" << std::endl;
+	ofs << "\t\t\tbreak;" << std::endl;
+	ofs << "\t\tline = end;" << std::endl;
+	ofs << "\t\twhile (*line == ' ' || *line == '\\t' || *line == '\\r')" << std::endl;
+	ofs << "\t\t\t++line;" << std::endl;
+	ofs << "\t\tif (j != cols - 1) {" << std::endl;
+	ofs << "\t\t\tif (*line != ',')" << std::endl;
+	ofs << "\t\t\t\tbreak;" << std::endl;
+	ofs << "\t\t\t++line;" << std::endl;
+	ofs << "\t\t}" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\tif (j != cols || *line != '\\0') {" << std::endl;
+	ofs << "\t\tfprintf(stderr, \"%s:%d: expected %d values\\n\", path, line_num, cols);" << std::endl;
+	ofs << "\t\texit(1);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\treturn 1;" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+	ofs << "double* rt_load_csv(const char* path, int rows, int cols, double* storage)" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tFILE* file = fopen(path, \"r\");" << std::endl;
+	ofs << "\tchar* buf = (char*)malloc(RT_CSV_CHUNK + 1);" << std::endl;
+	ofs << "\tsize_t len = 0;" << std::endl;
+	ofs << "\tint row = 0;" << std::endl;
+	ofs << "\tint line_num = 0;" << std::endl;
+	ofs << "\tint eof = 0;" << std::endl;
+	ofs << "\tif (file == 0 || buf == 0) {" << std::endl;
+	ofs << "\t\tperror(path);" << std::endl;
+	ofs << "\t\texit(1);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\twhile (!eof) {" << std::endl;
+	ofs << "\t\tchar* p = buf;" << std::endl;
+	ofs << "\t\tchar* end;" << std::endl;
+	ofs << "\t\tlen += fread(buf + len, 1, RT_CSV_CHUNK - len, file);" << std::endl;
+	ofs << "\t\tif (ferror(file)) {" << std::endl;
+	ofs << "\t\t\tperror(path);" << std::endl;
+	ofs << "\t\t\texit(1);" << std::endl;
+	ofs << "\t\t}" << std::endl;
+	ofs << "\t\teof = feof(file);" << std::endl;
+	ofs << "\t\tend = buf + len;" << std::endl;
+	ofs << "\t\t*end = '\\0';" << std::endl;
+	//the last line of a chunk is kept for the next chunk unless it is the
+	//last line of the file
+	ofs << "\t\twhile (p != end) {" << std::endl;
+	ofs << "\t\t\tchar* newline = (char*)memchr(p, '\\n', (size_t)(end - p));" << std::endl;
+	ofs << "\t\t\tif (newline == 0) {" << std::endl;
+	ofs << "\t\t\t\tif (!eof)" << std::endl;
+	ofs << "\t\t\t\t\tbreak;" << std::endl;
+	ofs << "\t\t\t\tnewline = end;" << std::endl;
+	ofs << "\t\t\t}" << std::endl;
+	ofs << "\t\t\t*newline = '\\0';" << std::endl;
+	ofs << "\t\t\t++line_num;" << std::endl;
+	ofs << "\t\t\tif (rt_csv_line(p, path, line_num, cols, (row < rows) ? storage + (size_t)row * cols : 0))" << std::endl;
+	ofs << "\t\t\t\t++row;" << std::endl;
+	ofs << "\t\t\tp = (newline == end) ? end : newline + 1;" << std::endl;
+	ofs << "\t\t}" << std::endl;
+	ofs << "\t\tif (p == buf && len == RT_CSV_CHUNK) {" << std::endl;
+	ofs << "\t\t\tfprintf(stderr, \"%s:%d: line is too long\\n\", path, line_num + 1);" << std::endl;
+	ofs << "\t\t\texit(1);" << std::endl;
+	ofs << "\t\t}" << std::endl;
+	ofs << "\t\tlen = (size_t)(end - p);" << std::endl;
+	ofs << "\t\tmemmove(buf, p, len);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\tif (row != rows) {" << std::endl;
+	ofs << "\t\tfprintf(stderr, \"%s: expected %d rows, found %d\\n\", path, rows, row);" << std::endl;
+	ofs << "\t\texit(1);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\tfclose(file);" << std::endl;
+	ofs << "\tfree(buf);" << std::endl;
+	ofs << "\treturn storage;" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+}
 
-void CodeGenerator::write_printsep_function(std::ofstream& ofs) const
+void CodeGenerator::write_printsep_function(std::ostream& ofs) const
 {
 	ofs << "void printsep()" << std::endl;
 	ofs << "{" << std::endl;
-	ofs << "\tprintf(\"----------\\n\");" << std::endl;
+	if (!options.entry_point.empty()) {
+		ofs << "	rt_sink(rt_sink_context, 0, 0, 0);" << std::endl;
+		ofs << "}" << std::endl;
+		ofs << std::endl;
+		return;
+	}
+	ofs << "\tif (rt_binary_out())" << std::endl;
+	ofs << "\t\trt_bin_record(0, 0, 0);" << std::endl;
+	ofs << "\telse" << std::endl;
+	ofs << "\t\trt_out_str(\"----------\\n\");" << std::endl;
 	ofs << "}" << std::endl;
 	ofs << std::endl;
 }
 
-void CodeGenerator::write_matrix_matrix_subtract(std::ofstream& ofs) const
+void CodeGenerator::write_matrix_matrix_subtract(std::ostream& ofs) const
 {
+	if (options.threaded_runtime) {
+		write_threaded_kernel(ofs,
+			"void mat_mat_sub(int size1, int size2, double mat1[size1][size2], double mat2[size1][size2], double result[size1][size2])",
+			"mat_mat_sub_rows",
+			"{size1, size2, 0, &mat1[0][0], &mat2[0][0], &result[0][0]}",
+			"\tdouble (*mat1)[a->size2] = (double (*)[a->size2])a->mat1;\n"
+			"\tdouble (*mat2)[a->size2] = (double (*)[a->size2])a->mat2;\n"
+			"\tdouble (*result)[a->size2] = (double (*)[a->size2])a->result;\n"
+			"\tint i;\n"
+			"\tint j;\n",
+			"\tfor (i = begin; i < end; ++i) {\n"
+			"\t\tfor (j = 0; j < a->size2; ++j) {\n"
+			"\t\t\tresult[i][j] = mat1[i][j] - mat2[i][j];\n"
+			"\t\t}\n"
+			"\t}\n",
+			"(double)size1 * size2", "size2");
+		return;
+	}
 	ofs << "void mat_mat_sub(int size1, int size2, double mat1[size1][size2], double mat2[size1][size2], double result[size1][size2])" << std::endl;
 	ofs << "{" << std::endl;
 	ofs << "\tint i;" << std::endl;
@@ -120,8 +959,26 @@ void CodeGenerator::write_matrix_matrix_subtract(std::ofstream& ofs) const
 	ofs << std::endl;
 }
 
-void CodeGenerator::write_matrix_matrix_add(std::ofstream& ofs) const
+void CodeGenerator::write_matrix_matrix_add(std::ostream& ofs) const
 {
+	if (options.threaded_runtime) {
+		write_threaded_kernel(ofs,
+			"void mat_mat_add(int size1, int size2, double mat1[size1][size2], double mat2[size1][size2], double result[size1][size2])",
+			"mat_mat_add_rows",
+			"{size1, size2, 0, &mat1[0][0], &mat2[0][0], &result[0][0]}",
+			"\tdouble (*mat1)[a->size2] = (double (*)[a->size2])a->mat1;\n"
+			"\tdouble (*mat2)[a->size2] = (double (*)[a->size2])a->mat2;\n"
+			"\tdouble (*result)[a->size2] = (double (*)[a->size2])a->result;\n"
+			"\tint i;\n"
+			"\tint j;\n",
+			"\tfor (i = begin; i < end; ++i) {\n"
+			"\t\tfor (j = 0; j < a->size2; ++j) {\n"
+			"\t\t\tresult[i][j] = mat1[i][j] + mat2[i][j];\n"
+			"\t\t}\n"
+			"\t}\n",
+			"(double)size1 * size2", "size2");
+		return;
+	}
 	ofs << "void mat_mat_add(int size1, int size2, double mat1[size1][size2], double mat2[size1][size2], double result[size1][size2])" << std::endl;
 	ofs << "{" << std::endl;
 	ofs << "\tint i;" << std::endl;
@@ -135,7 +992,7 @@ void CodeGenerator::write_matrix_matrix_add(std::ofstream& ofs) const
 	ofs << std::endl;
 }
 
-void CodeGenerator::write_negative_matrix(std::ofstream& ofs) const
+void CodeGenerator::write_negative_matrix(std::ostream& ofs) const
 {
 	ofs << "void neg_mat(int size1, int size2, double mat[size1][size2], double result[size1][size2])" << std::endl;
 	ofs << "{" << std::endl;
@@ -147,9 +1004,54 @@ void CodeGenerator::write_negative_matrix(std::ofstream& ofs) const
 	ofs << "\t\t}" << std::endl;
 	ofs << "\t}" << std::endl;
 	ofs << "}" << std::endl;
+	ofs << std::endl;
+}
+
+void CodeGenerator::write_matrix_matrix_multiply(std::ostream& ofs) const
+{
+	if (options.threaded_runtime) {
+		//threads compute different rows of the result
+		write_threaded_kernel(ofs,
+			"void mat_mat_mul(int size1_1, int common_size, int size2_2, double mat1[size1_1][common_size], double mat2[common_size][size2_2], double result[size1_1][size2_2])",
+			"mat_mat_mul_rows",
+			"{size1_1, common_size, size2_2, &mat1[0][0], &mat2[0][0], &result[0][0]}",
+			"\tdouble (*mat1)[a->size2] = (double (*)[a->size2])a->mat1;\n"
+			"\tdouble (*mat2)[a->size3] = (double (*)[a->size3])a->mat2;\n"
+			"\tdouble (*result)[a->size3] = (double (*)[a->size3])a->result;\n"
+			"\tint i;\n"
+			"\tint j;\n"
+			"\tint k;\n",
+			"\tfor (i = begin; i < end; ++i) {\n"
+			"\t\tfor (j = 0; j < a->size3; ++j) {\n"
+			"\t\t\tdouble sum = 0;\n"
+			"\t\t\tfor (k = 0; k < a->size2; ++k) {\n"
+			"\t\t\t\tsum += mat1[i][k] * mat2[k][j];\n"
+			"\t\t\t}\n"
+			"\t\t\tresult[i][j] = sum;\n"
+			"\t\t}\n"
+			"\t}\n",
+			"(double)size1_1 * common_size * size2_2", "common_size + size2_2");
+	} else {
+		write_serial_matrix_multiply(ofs);
+	}
 }
 
-void CodeGenerator::write_matrix_matrix_multiply(std::ofstream& ofs) const
+void CodeGenerator::write_vector_dot_product(std::ostream& ofs) const
+{
+	//Multiplication of (1xN) (Nx1) results in a scalar.
+	ofs << "double mat_mat_mul_s(int common_size, double mat1[1][common_size], double mat2[common_size][1])" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tint k;" << std::endl;
+	ofs << "\tdouble sum = 0;" << std::endl;
+	ofs << "\tfor (k = 0; k < common_size; ++k) {" << std::endl;
+	ofs << "\t\tsum += mat1[0][k] * mat2[k][0];" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\treturn sum;" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+}
+
+void CodeGenerator::write_serial_matrix_multiply(std::ostream& ofs) const
 {
 	//For (MxN) (NxK) matrix multiplication, takes the sizes M, N, K
 	//takes the matrices to multiply
@@ -170,154 +1072,907 @@ void CodeGenerator::write_matrix_matrix_multiply(std::ofstream& ofs) const
 	ofs << "\t}" << std::endl;
 	ofs << "}" << std::endl;
 	ofs << std::endl;
-	//Multiplication of (1xN) (Nx1) results in a scalar.
-	ofs << "double mat_mat_mul_s(int common_size, double mat1[1][common_size], double mat2[common_size][1])" << std::endl;
+}
+
+void CodeGenerator::write_scalar_matrix_multiply(std::ostream& ofs) const
+{
+	ofs << "void mat_sca_mul(int size1, int size2, double scalar, double matrix[size1][size2], double result[size1][size2])" << std::endl;
 	ofs << "{" << std::endl;
-	ofs << "\tint k;" << std::endl;
-	ofs << "\tdouble sum = 0;" << std::endl;
-	ofs << "\tfor (k = 0; k < common_size; ++k) {" << std::endl;
-	ofs << "\t\tsum += mat1[0][k] * mat2[k][0];" << std::endl;
+	ofs << "\tint i;" << std::endl;
+	ofs << "\tint j;" << std::endl;
+	ofs << "\tfor (i = 0; i < size1; ++i) {" << std::endl;
+	ofs << "\t\tfor (j = 0; j < size2; ++j) {" << std::endl;
+	ofs << "\t\t\tresult[i][j] = scalar * matrix[i][j];" << std::endl;
+	ofs << "\t\t}" << std::endl;
 	ofs << "\t}" << std::endl;
-	ofs << "\treturn sum;" << std::endl;
 	ofs << "}" << std::endl;
+	ofs << std::endl;
+}
+
+void CodeGenerator::write_matrix_assign(std::ostream& ofs) const
+{
+	ofs << "void mat_assign(int size1, int size2, double mat[size1][size2], double result[size1][size2])" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tint i;" << std::endl;
+	ofs << "\tint j;" << std::endl;
+	ofs << "\tfor (i = 0; i < size1; ++i) {" << std::endl;
+	ofs << "\t\tfor (j = 0; j < size2; ++j) {" << std::endl;
+	ofs << "\t\t\tresult[i][j] = mat[i][j];" << std::endl;
+	ofs << "\t\t}" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "}" << std::endl;
+}
+
+/** Writes the CBLAS prototypes used by the wrappers mat_mat_mul_blas,
+  * mat_sca_mul_blas and mat_mat_mul_s_blas.
+  *
+  * The prototypes are declared weak unless MATLANG_HAVE_BLAS is defined.
+  * Thus, the program links without a BLAS library and the wrappers call the
+  * built-in kernels when the CBLAS functions are not linked.
+  */
+void CodeGenerator::write_blas_prototypes(std::ostream& ofs) const
+{
+	//values of CblasRowMajor, CblasNoTrans and CblasTrans in cblas.h
+	ofs << "#define RT_CBLAS_ROW_MAJOR 101" << std::endl;
+	ofs << "#define RT_CBLAS_NO_TRANS 111" << std::endl;
+	ofs << "#define RT_CBLAS_TRANS 112" << std::endl;
+	ofs << "#ifdef MATLANG_HAVE_BLAS" << std::endl;
+	ofs << "#define RT_BLAS_DECL" << std::endl;
+	ofs << "#define rt_blas_linked() 1" << std::endl;
+	ofs << "#else" << std::endl;
+	ofs << "#define RT_BLAS_DECL __attribute__((weak))" << std::endl;
+	ofs << "#define rt_blas_linked() (cblas_dgemm && cblas_dgemv && cblas_dscal && cblas_ddot)" << std::endl;
+	ofs << "#endif" << std::endl;
+	ofs << "void cblas_dgemm(int order, int trans_a, int trans_b, int m, int n, int k, double alpha, const double* a, int lda, const double* b, int ldb, double beta, double* c, int ldc) RT_BLAS_DECL;" << std::endl;
+	ofs << "void cblas_dgemv(int order, int trans, int m, int n, double alpha, const double* a, int lda, const double* x, int incx, double beta, double* y, int incy) RT_BLAS_DECL;" << std::endl;
+	ofs << "void cblas_dscal(int n, double alpha, double* x, int incx) RT_BLAS_DECL;" << std::endl;
+	ofs << "double cblas_ddot(int n, const double* x, int incx, const double* y, int incy) RT_BLAS_DECL;" << std::endl;
+	ofs << std::endl;
+}
+
+void CodeGenerator::write_blas_matrix_multiply(std::ostream& ofs) const
+{
+	//matrix-vector and vector-matrix products are computed with dgemv
+	ofs << "void mat_mat_mul_blas(int size1_1, int common_size, int size2_2, double mat1[size1_1][common_size], double mat2[common_size][size2_2], double result[size1_1][size2_2])" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tif (!rt_blas_linked()) {" << std::endl;
+	ofs << "\t\tmat_mat_mul(size1_1, common_size, size2_2, mat1, mat2, result);" << std::endl;
+	ofs << "\t} else if (size2_2 == 1) {" << std::endl;
+	ofs << "\t\tcblas_dgemv(RT_CBLAS_ROW_MAJOR, RT_CBLAS_NO_TRANS, size1_1, common_size, 1.0, &mat1[0][0], common_size, &mat2[0][0], 1, 0.0, &result[0][0], 1);" << std::endl;
+	ofs << "\t} else if (size1_1 == 1) {" << std::endl;
+	ofs << "\t\tcblas_dgemv(RT_CBLAS_ROW_MAJOR, RT_CBLAS_TRANS, common_size, size2_2, 1.0, &mat2[0][0], size2_2, &mat1[0][0], 1, 0.0, &result[0][0], 1);" << std::endl;
+	ofs << "\t} else {" << std::endl;
+	ofs << "\t\tcblas_dgemm(RT_CBLAS_ROW_MAJOR, RT_CBLAS_NO_TRANS, RT_CBLAS_NO_TRANS, size1_1, size2_2, common_size, 1.0, &mat1[0][0], common_size, &mat2[0][0], size2_2, 0.0, &result[0][0], size2_2);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+}
+
+void CodeGenerator::write_blas_scalar_multiply(std::ostream& ofs) const
+{
+	ofs << "void mat_sca_mul_blas(int size1, int size2, double scalar, double matrix[size1][size2], double result[size1][size2])" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tif (!rt_blas_linked()) {" << std::endl;
+	ofs << "\t\tmat_sca_mul(size1, size2, scalar, matrix, result);" << std::endl;
+	ofs << "\t\treturn;" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\tmat_assign(size1, size2, matrix, result);" << std::endl;
+	ofs << "\tcblas_dscal(size1 * size2, scalar, &result[0][0], 1);" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+}
+
+void CodeGenerator::write_blas_dot_product(std::ostream& ofs) const
+{
+	ofs << "double mat_mat_mul_s_blas(int common_size, double mat1[1][common_size], double mat2[common_size][1])" << std::endl;
+	ofs << "{" << std::endl;
+	ofs << "\tif (!rt_blas_linked()) {" << std::endl;
+	ofs << "\t\treturn mat_mat_mul_s(common_size, mat1, mat2);" << std::endl;
+	ofs << "\t}" << std::endl;
+	ofs << "\treturn cblas_ddot(common_size, &mat1[0][0], 1, &mat2[0][0], 1);" << std::endl;
+	ofs << "}" << std::endl;
+	ofs << std::endl;
+}
+
+std::string CodeGenerator::blas_kernel(const std::string& name, long work) const
+{
+	if (options.blas && work >= options.blas_min_work) {
+		return use_helper(name + "_blas");
+	}
+	return use_helper(name);
+}
+
+/** Writes the prototypes of the functions in the helper definitions. Every
+  * function definition starts with an unindented signature line followed by
+  * a line with a single opening brace. Typedefs are copied since the
+  * signatures may use them.
+  */
+static void write_prototypes(std::ostream& header, const std::string& definitions)
+{
+	std::istringstream lines(definitions);
+	std::string prev;
+	std::string line;
+	while (std::getline(lines, line)) {
+		if (line.compare(0, 8, "typedef ") == 0) {
+			header << line << std::endl;
+		} else if (line == "{" && !prev.empty() && prev.find('(') != std::string::npos &&
+			prev[0] != '#' && !std::isspace(static_cast<unsigned char>(prev[0])))
+		{
+			header << prev << ";" << std::endl;
+		}
+		prev = line;
+	}
+}
+
+/** Writes every helper to source_name and their prototypes to header_name.
+  * Programs generated with runtime_library include header_name and are linked
+  * with the library built from source_name. BLAS wrappers and the worker pool
+  * are only a part of the runtime if their options are set.
+  */
+void CodeGenerator::generate_runtime(const std::string& header_name,
+									 const std::string& source_name)
+{
+	for (const auto& helper : helper_writers()) {
+		if (helper.first.find("_blas") == std::string::npos || options.blas) {
+			used_helpers.insert(helper.first);
+		}
+	}
+	used_helpers.erase("rt_pool");
+	used_helpers.erase("cblas");
+	add_helper_dependencies();
+	std::ostringstream definitions;
+	write_program_structure(definitions);
+	std::ofstream source(source_name);
+	if (!source) {
+		throw_error(source_name, " couldn't be opened to write the output");
+	}
+	source << definitions.str();
+	std::ofstream header(header_name);
+	if (!header) {
+		throw_error(header_name, " couldn't be opened to write the output");
+	}
+	header << "#ifndef MATLANGRT_H" << std::endl;
+	header << "#define MATLANGRT_H" << std::endl;
+	//the prototypes use types of these headers and the programs call memcpy
+	write_preprocessor_commands(header);
+	write_prototypes(header, definitions.str());
+	header << "#endif" << std::endl;
+}
+
+/** From the given source file generates C code and writes it to the
+  * out_file_name
+  */
+void CodeGenerator::generate_c_code(const std::vector<stmt_with_info>& program,
+								    const std::string& out_file_name)
+{
+	if (options.split_statements > 0) {
+		generate_split_c_code(program, out_file_name);
+		return;
+	}
+	std::ofstream ofs(out_file_name);
+	if (!ofs) {
+		throw_error(out_file_name, " couldn't be opened to write the output");
+	}
+	generate_c_code(program, ofs);
+}
+
+void CodeGenerator::generate_c_code(const std::vector<stmt_with_info>& program,
+									std::ostream& ofs)
+{
+	if (!options.entry_point.empty() &&
+		(options.threaded_runtime || options.runtime_library || options.evaluate))
+	{
+		throw_error("Error: --entry can't be used with --threads, --runtime-lib or --eval");
+	}
+	if (options.split_statements > 0) {
+		throw_error("Error: --split needs an output file");
+	}
+	const std::vector<stmt_with_info> src_file = optimize(program);
+	//main is generated first to learn the helpers it uses
+	std::ostringstream main_body;
+	this->indentation_level = 1;
+	write_statements(main_body, src_file, 0);
+	if (options.evaluate) {
+		Evaluator evaluator(sym_table, EvalBudget{options.eval_operations,
+												  options.eval_memory});
+		const EvalResult evaluated = evaluator.run(src_file);
+		if (evaluated.end != 0) {
+			used_helpers.clear();
+			open_loops.clear();
+			this->indentation_level = 1;
+			main_body.str("");
+			write_evaluated_statements(main_body, src_file, evaluated);
+			write_statements(main_body, src_file, evaluated.end);
+		}
+	}
+	if (!options.entry_point.empty()) {
+		use_helper("rt_sink");
+	}
+	add_helper_dependencies();
+	if (options.runtime_library) {
+		//helpers are defined in libmatlangrt
+		ofs << "#include \"matlangrt.h\"" << std::endl;
+	} else {
+		write_program_structure(ofs);
+	}
+	if (!options.entry_point.empty()) {
+		write_entry_point(ofs);
+		ofs << main_body.str();
+		ofs << "\trt_sink = rt_saved_sink;" << std::endl;
+		ofs << "\trt_sink_context = rt_saved_context;" << std::endl;
+		ofs << "\treturn 0;" << std::endl;
+		ofs << "}" << std::endl;
+		return;
+	}
+	//start main function. Everything is written inside main.
+	ofs << "int main()" << std::endl;
+	ofs << "{" << std::endl;
+	if (used_helpers.count("rt_out") != 0) {
+		//the loaders exit on an error
+		ofs << "\tatexit(rt_out_flush);" << std::endl;
+	}
+	const bool uses_pool = used_helpers.count("rt_pool") != 0;
+	if (uses_pool) {
+		ofs << "\trt_pool_start();" << std::endl;
+	}
+	ofs << main_body.str();
+	//done. Close main and exit.
+	if (uses_pool) {
+		ofs << "\trt_pool_stop();" << std::endl;
+	}
+	ofs << "\treturn 0;" << std::endl;
+	ofs << "}" << std::endl;
+}
+
+/** Writes the beginning of the entry point that is written instead of main:
+  *
+  *	int name(double* const* rt_matrices, matlang_print_fn rt_print, void* rt_context)
+  *
+  * rt_matrices[i] is the storage of the ith declared matrix or vector in row
+  * major order. The program starts with the values in the storage and leaves
+  * its results there.
+  */
+void CodeGenerator::write_entry_point(std::ostream& ofs) const
+{
+	ofs << "#pragma GCC visibility pop" << std::endl;
+	ofs << "int " << options.entry_point << "(double* const* rt_matrices, "
+		"matlang_print_fn rt_print, void* rt_context)" << std::endl;
+	ofs << "{" << std::endl;
+	//the entry point may be called from a callback of another call
+	ofs << "\tconst matlang_print_fn rt_saved_sink = rt_sink;" << std::endl;
+	ofs << "\tvoid* const rt_saved_context = rt_sink_context;" << std::endl;
+	ofs << "\trt_sink = rt_print;" << std::endl;
+	ofs << "\trt_sink_context = rt_context;" << std::endl;
+}
+
+/** The whole program is generated first since the code generation also
+  * reports the semantic errors. Optimizations may remove the statements with
+  * errors.
+  */
+std::vector<stmt_with_info> CodeGenerator::optimize(const std::vector<stmt_with_info>& program)
+{
+	for (const auto& stmt_tuple : program) {
+		const TokenCategory category = std::get<1>(stmt_tuple);
+		if (category == TokenCategory::LoadStatement) {
+			loaded_matrices.insert(std::get<0>(stmt_tuple).at(2).value());
+		} else if (category == TokenCategory::MatrixDeclaration ||
+				   category == TokenCategory::VectorDeclaration)
+		{
+			const std::string name = std::get<0>(stmt_tuple).at(1).value();
+			entry_matrices.emplace(name, static_cast<int>(entry_matrices.size()));
+		}
+	}
+	std::ostringstream unused;
+	this->indentation_level = 1;
+	write_statements(unused, program, 0);
+	used_helpers.clear();
+	open_loops.clear();
+	return PassManager(sym_table, options).run(program);
+}
+
+/** Writes the statements from src_file[begin] to the end of the program.
+  * With the task_graph option, independent top level assignments are written
+  * as task regions.
+  */
+void CodeGenerator::write_statements(std::ostream& ofs,
+									 const std::vector<stmt_with_info>& src_file,
+									 size_t begin)
+{
+	const auto bounds = statement_chunks(src_file, begin);
+	if (!bounds.empty()) {
+		write_statement_chunks(ofs, src_file, bounds);
+		return;
+	}
+	//statements before next_region are already known not to be a part of a
+	//parallel task region
+	size_t next_region = begin;
+	for (size_t index = begin; index < src_file.size(); ++index) {
+		if (options.task_graph && open_loops.empty() && index >= next_region) {
+			const TaskRegion region = dataflow_analyzer.task_region(src_file, index);
+			if (region.parallel) {
+				write_task_region(ofs, src_file, region);
+				index = region.end - 1;
+				continue;
+			}
+			next_region = std::max(region.end, index + 1);
+		}
+		write_statement(ofs, src_file, index);
+	}
 }
 
-void CodeGenerator::write_scalar_matrix_multiply(std::ofstream& ofs) const
+//statements written by a compiler thread at least
+static const size_t min_statements_per_thread = 512;
+
+/** Returns the bounds of the chunks of at least chunk_size statements from
+  * src_file[begin] to the end. A chunk ends only outside the loops, thus
+  * every loop is in a single chunk. The last chunk may be shorter.
+  */
+static std::vector<size_t> top_level_bounds(const std::vector<stmt_with_info>& src_file,
+											size_t begin, size_t chunk_size)
 {
-	ofs << "void mat_sca_mul(int size1, int size2, double scalar, double matrix[size1][size2], double result[size1][size2])" << std::endl;
-	ofs << "{" << std::endl;
-	ofs << "\tint i;" << std::endl;
-	ofs << "\tint j;" << std::endl;
-	ofs << "\tfor (i = 0; i < size1; ++i) {" << std::endl;
-	ofs << "\t\tfor (j = 0; j < size2; ++j) {" << std::endl;
-	ofs << "\t\t\tresult[i][j] = scalar * matrix[i][j];" << std::endl;
-	ofs << "\t\t}" << std::endl;
-	ofs << "\t}" << std::endl;
-	ofs << "}" << std::endl;
-	ofs << std::endl;
+	std::vector<size_t> bounds;
+	int depth = 0;
+	bounds.push_back(begin);
+	for (size_t index = begin; index < src_file.size(); ++index) {
+		const auto category = std::get<1>(src_file[index]);
+		if (category == TokenCategory::SingleForStatement ||
+			category == TokenCategory::DoubleForStatement)
+		{
+			++depth;
+		} else if (category == TokenCategory::CloseCurlyBraces) {
+			--depth;
+		}
+		if (depth == 0 && index + 1 - bounds.back() >= chunk_size &&
+			index + 1 < src_file.size())
+		{
+			bounds.push_back(index + 1);
+		}
+	}
+	bounds.push_back(src_file.size());
+	return bounds;
 }
 
-void CodeGenerator::write_matrix_assign(std::ofstream& ofs) const
+/** Statements are split between the top level loops. Task regions span many
+  * statements, thus the statements of a task graph are written on this
+  * thread.
+  */
+std::vector<size_t> CodeGenerator::statement_chunks(const std::vector<stmt_with_info>& src_file,
+													size_t begin) const
 {
-	ofs << "void mat_assign(int size1, int size2, double mat[size1][size2], double result[size1][size2])" << std::endl;
-	ofs << "{" << std::endl;
-	ofs << "\tint i;" << std::endl;
-	ofs << "\tint j;" << std::endl;
-	ofs << "\tfor (i = 0; i < size1; ++i) {" << std::endl;
-	ofs << "\t\tfor (j = 0; j < size2; ++j) {" << std::endl;
-	ofs << "\t\t\tresult[i][j] = mat[i][j];" << std::endl;
-	ofs << "\t\t}" << std::endl;
-	ofs << "\t}" << std::endl;
-	ofs << "}" << std::endl;
+	std::vector<size_t> bounds;
+	const size_t count = src_file.size() - begin;
+	if (options.compiler_threads <= 1 || options.task_graph || !open_loops.empty() ||
+		count < 2 * min_statements_per_thread)
+	{
+		return bounds;
+	}
+	//a few chunks on each thread balance the work
+	const size_t chunk_size = std::max(min_statements_per_thread,
+									   count / (4 * options.compiler_threads));
+	bounds = top_level_bounds(src_file, begin, chunk_size);
+	if (bounds.size() < 3) {
+		bounds.clear();
+	}
+	return bounds;
 }
 
-/** From the given source file generates C code and writes it to the
-  * out_file_name
+/** Each chunk is written by a generator of its own with a copy of the symbol
+  * table, which gets the temporaries of the chunk. The chunks are written
+  * twice: first to count the names each chunk takes from get_unique_name,
+  * then with the names they take when written one after another. The output
+  * is the same as the output of a single thread.
   */
-void CodeGenerator::generate_c_code(const std::vector<stmt_with_info>& src_file,
-								    const std::string& out_file_name)
+void CodeGenerator::write_statement_chunks(std::ostream& ofs,
+										   const std::vector<stmt_with_info>& src_file,
+										   const std::vector<size_t>& bounds)
 {
-	std::ofstream ofs(out_file_name);
-	if (!ofs) {
-		throw_error(out_file_name, " couldn't be opened to write the output");
+	const size_t count = bounds.size() - 1;
+	std::vector<int> first_name(count, 0);
+	std::vector<int> name_count(count, 0);
+	std::vector<std::string> output(count);
+	std::vector<std::set<std::string>> helpers(count);
+	std::vector<std::exception_ptr> errors(count);
+	const auto write_chunk = [&](size_t chunk) {
+		SymbolTable chunk_table(*sym_table);
+		CodeGenerator generator(&chunk_table, options);
+		generator.loaded_matrices = loaded_matrices;
+		generator.entry_matrices = entry_matrices;
+		generator.indentation_level = indentation_level;
+		generator.unique_name_count = first_name[chunk];
+		std::ostringstream oss;
+		try {
+			for (size_t index = bounds[chunk]; index < bounds[chunk + 1]; ++index) {
+				generator.write_statement(oss, src_file, index);
+			}
+		} catch (...) {
+			errors[chunk] = std::current_exception();
+		}
+		name_count[chunk] = generator.unique_name_count - first_name[chunk];
+		output[chunk] = oss.str();
+		helpers[chunk] = generator.used_helpers;
+	};
+	parallel_for(count, options.compiler_threads, write_chunk);
+	//the first error in the program is reported
+	for (const auto& error : errors) {
+		if (error) {
+			std::rethrow_exception(error);
+		}
 	}
-	write_program_structure(ofs);
-	//start main function. Everything is written inside main.
-	ofs << "int main()" << std::endl;
-	ofs << "{" << std::endl;
-	this->indentation_level = 1;
-	for (const auto& stmt_tuple : src_file) {
-		//first --> token_vector
-		//second --> statement category
-		//third --> line number
-		this->line_count = std::get<2>(stmt_tuple);
+	for (size_t chunk = 0; chunk < count; ++chunk) {
+		first_name[chunk] = unique_name_count;
+		unique_name_count += name_count[chunk];
+	}
+	parallel_for(count, options.compiler_threads, write_chunk);
+	for (size_t chunk = 0; chunk < count; ++chunk) {
+		ofs << output[chunk];
+		used_helpers.insert(helpers[chunk].begin(), helpers[chunk].end());
+	}
+}
+
+/** Writes the program in the translation units of the parts, which are
+  * functions of at least options.split_statements top level statements each:
+  *
+  *	prog.h     helper prototypes, struct rt_state and the part prototypes
+  *	prog.c     helpers and main, which calls the parts in order
+  *	prog_1.c   void rt_part_1(struct rt_state* rt_s)
+  *	prog.mk    make -f prog.mk -j compiles the units in parallel
+  *
+  * prog is the output file name without its extension.
+  * The declared variables are members of struct rt_state, which main keeps.
+  * A part copies the variables it uses to locals at the beginning and copies
+  * the scalars and loaded matrices back at the end, thus the statements are
+  * written as they are in main.
+  */
+void CodeGenerator::generate_split_c_code(const std::vector<stmt_with_info>& program,
+										  const std::string& out_file_name)
+{
+	if (!options.entry_point.empty() || options.evaluate) {
+		throw_error("Error: --split can't be used with --entry or --eval");
+	}
+	const std::vector<stmt_with_info> src_file = optimize(program);
+	const size_t dot = out_file_name.rfind('.');
+	const size_t slash = out_file_name.rfind('/');
+	const bool has_extension = dot != std::string::npos &&
+							   (slash == std::string::npos || dot > slash);
+	const std::string base = has_extension ? out_file_name.substr(0, dot) : out_file_name;
+	const std::string name = (slash == std::string::npos) ? base : base.substr(slash + 1);
+	//the units are in the directory of the output
+	const std::string header_name = name + ".h";
+	std::string prefix;
+	for (const char c : name) {
+		prefix += std::isalnum(static_cast<unsigned char>(c))
+				  ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : '_';
+	}
+	//members of the state in the order they are declared
+	std::ostringstream state;
+	std::ostringstream init_state;
+	std::vector<std::string> members;
+	//declaration of the local copy of each member
+	std::map<std::string, std::string> locals;
+	std::set<std::string> scalars;
+	for (const auto& stmt_tuple : program) {
+		const auto category = std::get<1>(stmt_tuple);
 		const auto& token_vec = std::get<0>(stmt_tuple);
-		//switch statement category
-		switch (std::get<1>(stmt_tuple)) {
-			case TokenCategory::ScalarDeclaration:
-				write_scalar_declr(ofs, token_vec);
-				break;
-			case TokenCategory::VectorDeclaration:
-				write_vector_declr(ofs, token_vec);
-				break;
-			case TokenCategory::MatrixDeclaration:
-				write_matrix_declr(ofs, token_vec);
-				break;
-			case TokenCategory::SingleForStatement:
-				write_single_for(ofs, token_vec);
-				//when entering the for, we need to increase the indentation
+		if (category == TokenCategory::ScalarDeclaration) {
+			const std::string var = token_vec.at(1).value();
+			state << "\tdouble " << var << ";" << std::endl;
+			members.push_back(var);
+			locals[var] = "double " + var;
+			scalars.insert(var);
+		} else if (category == TokenCategory::VectorDeclaration ||
+				   category == TokenCategory::MatrixDeclaration)
+		{
+			const std::string var = token_vec.at(1).value();
+			const std::string rows = token_vec.at(3).value();
+			const std::string cols = (category == TokenCategory::VectorDeclaration)
+									 ? "1" : token_vec.at(5).value();
+			if (loaded_matrices.count(var) != 0) {
+				//initially points to its own storage
+				const std::string storage = get_unique_name();
+				state << "\tdouble " << storage << "[" << rows << "][" << cols << "];"
+					  << std::endl;
+				state << "\tdouble (*" << var << ")[" << cols << "];" << std::endl;
+				init_state << "\trt_s." << var << " = rt_s." << storage << ";" << std::endl;
+			} else {
+				state << "\tdouble " << var << "[" << rows << "][" << cols << "];"
+					  << std::endl;
+			}
+			members.push_back(var);
+			locals[var] = "double (*" + var + ")[" + cols + "]";
+		}
+	}
+	const auto bounds = top_level_bounds(src_file, 0,
+										 static_cast<size_t>(options.split_statements));
+	std::vector<std::string> parts;
+	for (size_t part = 0; part + 1 < bounds.size(); ++part) {
+		const std::vector<stmt_with_info> statements(src_file.begin() + bounds[part],
+													 src_file.begin() + bounds[part + 1]);
+		std::set<std::string> used;
+		for (const auto& stmt_tuple : statements) {
+			const auto category = std::get<1>(stmt_tuple);
+			if (category == TokenCategory::ScalarDeclaration ||
+				category == TokenCategory::VectorDeclaration ||
+				category == TokenCategory::MatrixDeclaration)
+			{
+				continue;
+			}
+			for (const auto& token : std::get<0>(stmt_tuple)) {
+				if (token.category() == TokenCategory::Identifier) {
+					used.insert(token.value());
+				}
+			}
+		}
+		std::ostringstream body;
+		this->indentation_level = 1;
+		write_statements(body, statements, 0);
+		std::ostringstream oss;
+		oss << "#include \"" << header_name << "\"" << std::endl;
+		oss << "void rt_part_" << part + 1 << "(struct rt_state* rt_s)" << std::endl;
+		oss << "{" << std::endl;
+		for (const auto& var : members) {
+			if (used.count(var) != 0) {
+				oss << "\t" << locals[var] << " = rt_s->" << var << ";" << std::endl;
+			}
+		}
+		oss << body.str();
+		//the matrices are changed in the state through the pointers
+		for (const auto& var : members) {
+			if (used.count(var) != 0 &&
+				(scalars.count(var) != 0 || loaded_matrices.count(var) != 0))
+			{
+				oss << "\trt_s->" << var << " = " << var << ";" << std::endl;
+			}
+		}
+		oss << "}" << std::endl;
+		parts.push_back(oss.str());
+	}
+	add_helper_dependencies();
+	std::ostringstream definitions;
+	if (!options.runtime_library) {
+		write_program_structure(definitions);
+	}
+	std::ostringstream header;
+	header << "#ifndef " << prefix << "_H" << std::endl;
+	header << "#define " << prefix << "_H" << std::endl;
+	if (options.runtime_library) {
+		header << "#include \"matlangrt.h\"" << std::endl;
+	} else {
+		write_preprocessor_commands(header);
+		write_prototypes(header, definitions.str());
+	}
+	header << "struct rt_state {" << std::endl;
+	header << state.str();
+	if (members.empty()) {
+		//a struct needs a member
+		header << "\tchar rt_unused;" << std::endl;
+	}
+	header << "};" << std::endl;
+	for (size_t part = 0; part < parts.size(); ++part) {
+		header << "void rt_part_" << part + 1 << "(struct rt_state* rt_s);" << std::endl;
+	}
+	header << "#endif" << std::endl;
+	std::ostringstream main_unit;
+	main_unit << "#include \"" << header_name << "\"" << std::endl;
+	main_unit << definitions.str();
+	main_unit << "int main()" << std::endl;
+	main_unit << "{" << std::endl;
+	main_unit << "\tstruct rt_state rt_s;" << std::endl;
+	main_unit << init_state.str();
+	if (used_helpers.count("rt_out") != 0) {
+		main_unit << "\tatexit(rt_out_flush);" << std::endl;
+	}
+	const bool uses_pool = used_helpers.count("rt_pool") != 0;
+	if (uses_pool) {
+		main_unit << "\trt_pool_start();" << std::endl;
+	}
+	for (size_t part = 0; part < parts.size(); ++part) {
+		main_unit << "\trt_part_" << part + 1 << "(&rt_s);" << std::endl;
+	}
+	if (uses_pool) {
+		main_unit << "\trt_pool_stop();" << std::endl;
+	}
+	main_unit << "\treturn 0;" << std::endl;
+	main_unit << "}" << std::endl;
+	//the objects are built with $(CC) $(CFLAGS) and the flags the options need
+	std::ostringstream makefile;
+	makefile << "# Generated by matlang2c. Build with make -f " << name << ".mk -j"
+			 << std::endl;
+	makefile << "CFLAGS ?= -O2" << std::endl;
+	makefile << prefix << "_CFLAGS = $(CFLAGS)";
+	if (options.parallel_loops || options.task_graph) {
+		makefile << " -fopenmp";
+	}
+	if (options.threaded_runtime) {
+		makefile << " -pthread";
+	}
+	makefile << std::endl;
+	makefile << prefix << "_OBJECTS = " << name << ".o";
+	for (size_t part = 0; part < parts.size(); ++part) {
+		makefile << " " << name << "_" << part + 1 << ".o";
+	}
+	makefile << std::endl;
+	makefile << name << ": $(" << prefix << "_OBJECTS)" << std::endl;
+	makefile << "\t$(CC) $(" << prefix << "_CFLAGS) $(" << prefix << "_OBJECTS) -o "
+			 << name << " $(LDLIBS) -lm" << std::endl;
+	makefile << "$(" << prefix << "_OBJECTS): %.o: %.c " << header_name << std::endl;
+	makefile << "\t$(CC) $(" << prefix << "_CFLAGS) -c $< -o $@" << std::endl;
+	//every file is generated before any of them is written
+	std::vector<std::pair<std::string, std::string>> files{
+		{base + ".h", header.str()},
+		{base + ".c", main_unit.str()},
+		{base + ".mk", makefile.str()}
+	};
+	for (size_t part = 0; part < parts.size(); ++part) {
+		files.emplace_back(base + "_" + std::to_string(part + 1) + ".c", parts[part]);
+	}
+	for (const auto& file : files) {
+		std::ofstream ofs(file.first);
+		if (!(ofs << file.second)) {
+			throw_error(file.first, " couldn't be opened to write the output");
+		}
+	}
+}
+
+/** Writes the prints of the statements run at compile time with their
+  * precomputed values. Matrices are printed from static tables:
+  *
+  *	static double _E4_0[6] = {...};
+  *	print_mat(2, 3, (double (*)[3])_E4_0);
+  *	print(2.5);
+  *
+  * If the evaluation stopped before the end of the program, the declarations
+  * of the evaluated statements are written as well and the variables get the
+  * values they have at that point. The rest of the program follows them.
+  */
+void CodeGenerator::write_evaluated_statements(std::ostream& ofs,
+						const std::vector<stmt_with_info>& src_file,
+						const EvalResult& evaluated)
+{
+	const bool complete = evaluated.end == src_file.size();
+	if (!complete) {
+		for (size_t index = 0; index < evaluated.end; ++index) {
+			const auto category = std::get<1>(src_file[index]);
+			if (category == TokenCategory::ScalarDeclaration ||
+				category == TokenCategory::VectorDeclaration ||
+				category == TokenCategory::MatrixDeclaration)
+			{
+				write_statement(ofs, src_file, index);
+			}
+		}
+	}
+	for (const auto& printed : evaluated.output) {
+		if (printed.statement == TokenCategory::PrintSepStatement) {
+			write_printsep_stmt(ofs);
+		} else if (printed.type == VariableType::Scalar) {
+			this->put_tabs(ofs);
+			ofs << use_helper("print") << "(" << c_literal(printed.values.at(0))
+				<< ");" << std::endl;
+		} else {
+			const auto table_name = get_unique_name();
+			write_static_table(ofs, table_name, printed.values, false);
+			this->put_tabs(ofs);
+			ofs << use_helper("print_mat") << "(" << printed.dim.rows << ", "
+				<< printed.dim.cols << ", (double (*)[" << printed.dim.cols << "])"
+				<< table_name << ");" << std::endl;
+		}
+	}
+	if (complete) {
+		return;
+	}
+	for (const auto& name_values : evaluated.values) {
+		const Variable var = sym_table->lookup(name_values.first);
+		if (var.type() == VariableType::Scalar) {
+			this->put_tabs(ofs);
+			ofs << var.name() << " = " << c_literal(name_values.second.at(0))
+				<< ";" << std::endl;
+			continue;
+		}
+		const auto table_name = get_unique_name();
+		write_static_table(ofs, table_name, name_values.second, true);
+		this->put_tabs(ofs);
+		ofs << use_helper("memcpy") << "(&" << var.name() << "[0][0], "
+			<< table_name << ", sizeof(" << table_name << "));" << std::endl;
+	}
+}
+
+/** Writes the statement at src_file[index] to ofs.
+  */
+void CodeGenerator::write_statement(std::ostream& ofs,
+									const std::vector<stmt_with_info>& src_file,
+									size_t index)
+{
+	const auto& stmt_tuple = src_file[index];
+	//first --> token_vector
+	//second --> statement category
+	//third --> line number
+	this->line_count = std::get<2>(stmt_tuple);
+	const auto& token_vec = std::get<0>(stmt_tuple);
+	//switch statement category
+	switch (std::get<1>(stmt_tuple)) {
+		case TokenCategory::ScalarDeclaration:
+			write_scalar_declr(ofs, token_vec);
+			break;
+		case TokenCategory::VectorDeclaration:
+			write_vector_declr(ofs, token_vec);
+			break;
+		case TokenCategory::MatrixDeclaration:
+			write_matrix_declr(ofs, token_vec);
+			break;
+		case TokenCategory::SingleForStatement:
+		case TokenCategory::DoubleForStatement:
+		{
+			//double for writes two nested for stmts.
+			LoopFrame frame{(std::get<1>(stmt_tuple) ==
+							 TokenCategory::DoubleForStatement) ? 2 : 1,
+							this->indentation_level, false, ""};
+			LoopParallelism parallelism;
+			if (options.parallel_loops) {
+				parallelism = loop_analyzer.analyze(src_file, index);
+			}
+			if (parallelism.parallel) {
+				frame.parallel = true;
+				frame.epilogue = write_parallel_for(ofs, token_vec,
+													parallelism);
+				//parallel loops are put inside a block
 				this->indentation_level++;
-				break;
-			case TokenCategory::DoubleForStatement:
+			} else if (frame.for_count == 2) {
 				write_double_for(ofs, token_vec);
-				//double for writes two nested for stmts. Need to increment
-				//the indentation twice
-				this->double_for = true;
-				this->indentation_level += 2;
-				break;
-			case TokenCategory::CloseCurlyBraces:
-				if (double_for)
-					this->indentation_level -= 2;
-				else
-					this->indentation_level--;
-				write_end_for(ofs);
-				this->double_for = false;
-				break;
-			case TokenCategory::PrintStatement:
-				write_print_stmt(ofs, token_vec);
-				break;
-			case TokenCategory::PrintSepStatement:
-				write_printsep_stmt(ofs);
-				break;
-			case TokenCategory::ExprAssignment:
-				write_expr_assignment(ofs, token_vec);
-				break;
-			case TokenCategory::SingleSubscriptExprAssignment:
-				write_single_subscript_assignment(ofs, token_vec);
-				break;
-			case TokenCategory::DoubleSubscriptExprAssignment:
-				write_double_subscript_assignment(ofs, token_vec);
-				break;
-			case TokenCategory::ListAssignment:
-				write_list_assignment(ofs, token_vec);
-				break;
-			default:
-			{
-				throw_error("Error (Line ", std::get<2>(stmt_tuple),
-							 "): Unexpected statement type: ",
-							 std::get<1>(stmt_tuple));
+			} else {
+				write_single_for(ofs, token_vec);
+			}
+			//when entering the for, we need to increase the indentation
+			this->indentation_level += frame.for_count;
+			open_loops.push_back(frame);
+			break;
+		}
+		case TokenCategory::CloseCurlyBraces:
+			if (open_loops.empty()) {
+				throw_error(err_linenum(this->line_count),
+							"Unexpected closing curly braces");
 			}
+			this->indentation_level = open_loops.back().indentation;
+			write_end_for(ofs, open_loops.back());
+			open_loops.pop_back();
+			break;
+		case TokenCategory::PrintStatement:
+			write_print_stmt(ofs, token_vec);
+			break;
+		case TokenCategory::PrintSepStatement:
+			write_printsep_stmt(ofs);
+			break;
+		case TokenCategory::ExprAssignment:
+			write_expr_assignment(ofs, token_vec);
+			break;
+		case TokenCategory::SingleSubscriptExprAssignment:
+			write_single_subscript_assignment(ofs, token_vec);
+			break;
+		case TokenCategory::DoubleSubscriptExprAssignment:
+			write_double_subscript_assignment(ofs, token_vec);
+			break;
+		case TokenCategory::ListAssignment:
+			write_list_assignment(ofs, token_vec);
+			break;
+		case TokenCategory::LoadStatement:
+			write_load_stmt(ofs, token_vec);
+			break;
+		default:
+		{
+			throw_error("Error (Line ", std::get<2>(stmt_tuple),
+						 "): Unexpected statement type: ",
+						 std::get<1>(stmt_tuple));
 		}
 	}
-	//done. Close main and exit.
-	ofs << "\treturn 0;" << std::endl;
+}
+
+/** Writes a region of independent assignments as OpenMP tasks. Each task
+  * depends on the tasks of its predecessors in the dependency DAG of the
+  * region through an array with one element for each task:
+  *
+  *	{
+  *		char deps[3];
+  *		#pragma omp parallel
+  *		#pragma omp single
+  *		{
+  *			#pragma omp task depend(out: deps[0])
+  *			{ ... }
+  *			#pragma omp task depend(in: deps[0]) depend(out: deps[1])
+  *			{ ... }
+  *
+  * Tasks are written in the source order. Thus, the program is still correct
+  * when OpenMP is not enabled.
+  */
+void CodeGenerator::write_task_region(std::ostream& ofs,
+									  const std::vector<stmt_with_info>& src_file,
+									  const TaskRegion& region)
+{
+	const std::string deps_name = get_unique_name();
+	this->put_tabs(ofs);
+	ofs << "{" << std::endl;
+	this->put_tabs(ofs);
+	ofs << "\tchar " << deps_name << "[" << region.end - region.begin << "];"
+		<< std::endl;
+	this->put_tabs(ofs);
+	ofs << "\t#pragma omp parallel" << std::endl;
+	this->put_tabs(ofs);
+	ofs << "\t#pragma omp single" << std::endl;
+	this->put_tabs(ofs);
+	ofs << "\t{" << std::endl;
+	this->indentation_level += 2;
+	for (size_t i = 0; i < region.predecessors.size(); ++i) {
+		this->put_tabs(ofs);
+		ofs << "#pragma omp task";
+		if (!region.predecessors[i].empty()) {
+			ofs << " depend(in: ";
+			for (size_t j = 0; j < region.predecessors[i].size(); ++j) {
+				ofs << ((j == 0) ? "" : ", ") << deps_name << "["
+					<< region.predecessors[i][j] << "]";
+			}
+			ofs << ")";
+		}
+		ofs << " depend(out: " << deps_name << "[" << i << "])" << std::endl;
+		this->put_tabs(ofs);
+		ofs << "{" << std::endl;
+		this->indentation_level++;
+		write_statement(ofs, src_file, region.begin + i);
+		this->indentation_level--;
+		this->put_tabs(ofs);
+		ofs << "}" << std::endl;
+	}
+	this->indentation_level -= 2;
+	this->put_tabs(ofs);
+	ofs << "\t}" << std::endl;
+	this->put_tabs(ofs);
 	ofs << "}" << std::endl;
 }
 
-void CodeGenerator::write_scalar_declr(std::ofstream& ofs,
+void CodeGenerator::write_scalar_declr(std::ostream& ofs,
 									   const std::vector<Token>& token_vec) const
 {
+	if (options.split_statements > 0) {
+		//a member of the state of the parts
+		return;
+	}
 	this->put_tabs(ofs);
 	ofs << "double " << token_vec.at(1).value() << ";" << std::endl;
 }
 
-void CodeGenerator::write_vector_declr(std::ofstream& ofs,
+void CodeGenerator::write_vector_declr(std::ostream& ofs,
 									   const std::vector<Token>& token_vec) const
 {
 	//vector declaration is a 2d matrix declaration with second dimensio == 1
-	this->put_tabs(ofs);
-	ofs << "double " << token_vec.at(1).value() << "["
-		<< token_vec.at(3).value() << "][1];"
-		<< std::endl;
+	write_matrix_declr(ofs, token_vec);
 }
 
-void CodeGenerator::write_matrix_declr(std::ofstream& ofs,
+void CodeGenerator::write_matrix_declr(std::ostream& ofs,
 									   const std::vector<Token>& token_vec) const
 {
+	if (options.split_statements > 0) {
+		//a member of the state of the parts
+		return;
+	}
+	const std::string name = token_vec.at(1).value();
+	const std::string cols = (token_vec.at(0).category() ==
+							  TokenCategory::VectorType) ? "1"
+														 : token_vec.at(5).value();
 	this->put_tabs(ofs);
-	ofs << "double " << token_vec.at(1).value() << "["
-		<< token_vec.at(3).value() << "][" << token_vec.at(5).value() << "];"
-		<< std::endl;
+	if (!options.entry_point.empty()) {
+		//the storage is given by the caller
+		ofs << "double (*" << name << ")[" << cols << "] = (double (*)[" << cols
+			<< "])rt_matrices[" << entry_matrices.at(name) << "];" << std::endl;
+		return;
+	}
+	if (loaded_matrices.count(name) != 0) {
+		//initially points to its own storage
+		const std::string storage = get_unique_name();
+		ofs << "double " << storage << "[" << token_vec.at(3).value() << "]["
+			<< cols << "];" << std::endl;
+		this->put_tabs(ofs);
+		ofs << "double (*" << name << ")[" << cols << "] = " << storage << ";"
+			<< std::endl;
+		return;
+	}
+	ofs << "double " << name << "[" << token_vec.at(3).value() << "]["
+		<< cols << "];" << std::endl;
 }
 
 /** Throws a runtime_error if the type of Variable is not the same as the give
@@ -335,7 +1990,7 @@ void CodeGenerator::confirm_type(const Variable& var, const VariableType& var_ty
 /** Writes a single for statement to the ofs with the expressions
   * stored in token_vec.
   */
-void CodeGenerator::write_single_for(std::ofstream& ofs,
+void CodeGenerator::write_single_for(std::ostream& ofs,
 									 const std::vector<Token>& token_vec) const
 {
 	/**
@@ -364,7 +2019,7 @@ void CodeGenerator::write_single_for(std::ofstream& ofs,
 		<< ") {" << std::endl;
 }
 
-void CodeGenerator::write_double_for(std::ofstream& ofs,
+void CodeGenerator::write_double_for(std::ostream& ofs,
 									 const std::vector<Token>& token_vec) const
 {
 	/**
@@ -401,18 +2056,119 @@ void CodeGenerator::write_double_for(std::ofstream& ofs,
 		<< ") {" << std::endl;
 }
 
-void CodeGenerator::write_end_for(std::ofstream& ofs) const
+/** Writes a for statement whose iterations are independent as an OpenMP
+  * parallel for. OpenMP only accepts integer loop variables. Thus, the number
+  * of iterations is computed beforehand and the MatLang loop variable is
+  * derived from an integer counter in each iteration:
+  *
+  *	{
+  *		double start = <expr1>;
+  *		int count = (int)ceil((<expr2> + 1 - start) / <step>);
+  *		int iter;
+  *		#pragma omp parallel for private(i) ...
+  *		for (iter = 0; iter < count; ++iter) {
+  *			i = start + iter * <step>;
+  *
+  * The returned epilogue gives the loop variable the value it would have after
+  * the serial loop.
+  */
+std::string CodeGenerator::write_parallel_for(std::ostream& ofs,
+											  const std::vector<Token>& token_vec,
+											  const LoopParallelism& parallelism) const
 {
-	//Adjust the indentation level according to the double_for condition
-	if (double_for) {//if double for, we need to put one extra closing braces
-		this->put_tabs(ofs);
-		ofs << "\t}" << std::endl;
+	/**
+	   0  1  2  3  4  5     6		7		...
+	  for ( id1 , id2 in expr_begin expr expr_end : ...) {
+	  for ( id1 in expr_begin expr expr_end : ...) {
+	  */
+	const bool is_double = token_vec.at(3).category() == TokenCategory::Comma;
+	const auto first_name = token_vec.at(2).value();
+	confirm_type(sym_table->lookup(first_name), VariableType::Scalar);
+	std::set<std::string> lastprivate_vars = parallelism.private_vars;
+	if (is_double) {
+		//inner loop variable keeps its value from the last iteration
+		lastprivate_vars.insert(token_vec.at(4).value());
+		confirm_type(sym_table->lookup(token_vec.at(4).value()),
+					 VariableType::Scalar);
+	}
+	std::vector<Variable> c_expressions;
+	auto it = token_vec.begin() + (is_double ? 7 : 5);
+	for (int i = 0; i < (is_double ? 6 : 3); ++i, it += 2) {
+		c_expressions.push_back(convert_to_c_expr(it, ofs));
+		confirm_type(c_expressions.back(), VariableType::Scalar);
 	}
+	const std::string start_name = get_unique_name();
+	const std::string count_name = get_unique_name();
+	const std::string iter_name = get_unique_name();
+	const std::string step = c_expressions.at(2).name();
 	this->put_tabs(ofs);
-	ofs << "}" << std::endl;
+	ofs << "{" << std::endl;
+	this->put_tabs(ofs);
+	ofs << "\tdouble " << start_name << " = " << c_expressions.at(0).name()
+		<< ";" << std::endl;
+	this->put_tabs(ofs);
+	ofs << "\tint " << count_name << " = (int)ceil(((" << c_expressions.at(1).name()
+		<< ") + 1 - " << start_name << ") / " << step << ");" << std::endl;
+	this->put_tabs(ofs);
+	ofs << "\tint " << iter_name << ";" << std::endl;
+	this->put_tabs(ofs);
+	ofs << "\t#pragma omp parallel for private(" << first_name << ")";
+	//writes the variables as a clause if there are any
+	auto write_clause = [&ofs] (const std::string& clause,
+								const std::set<std::string>& vars)
+	{
+		if (vars.empty())
+			return;
+		ofs << " " << clause;
+		for (auto var = vars.begin(); var != vars.end(); ++var) {
+			ofs << ((var == vars.begin()) ? "" : ", ") << *var;
+		}
+		ofs << ")";
+	};
+	write_clause("lastprivate(", lastprivate_vars);
+	write_clause("reduction(+:", parallelism.reduction_vars);
+	ofs << std::endl;
+	this->put_tabs(ofs);
+	ofs << "\tfor (" << iter_name << " = 0; " << iter_name << " < " << count_name
+		<< "; ++" << iter_name << ") {" << std::endl;
+	this->put_tabs(ofs);
+	ofs << "\t\t" << first_name << " = " << start_name << " + " << iter_name
+		<< " * " << step << ";" << std::endl;
+	if (is_double) {
+		const auto second_name = token_vec.at(4).value();
+		this->put_tabs(ofs);
+		ofs << "\t\tfor (" << second_name << " = " << c_expressions.at(3).name()
+			<< "; " << second_name << " < " << c_expressions.at(4).name() << "+1"
+			<< "; " << second_name << " += " << c_expressions.at(5).name()
+			<< ") {" << std::endl;
+	}
+	std::ostringstream epilogue;
+	epilogue << first_name << " = " << start_name << " + (" << count_name
+			 << " > 0 ? " << count_name << " : 0) * " << step << ";";
+	return epilogue.str();
+}
+
+/** Closes the for statements of the given loop. Parallel loops also close
+  * the block they are put in.
+  */
+void CodeGenerator::write_end_for(std::ostream& ofs, const LoopFrame& frame) const
+{
+	//inner for statements are indented more
+	const int block = frame.parallel ? 1 : 0;
+	for (int depth = frame.for_count - 1; depth >= 0; --depth) {
+		this->put_tabs(ofs);
+		ofs << std::string(static_cast<size_t>(depth + block), '\t') << "}"
+			<< std::endl;
+	}
+	if (frame.parallel) {
+		this->put_tabs(ofs);
+		ofs << "\t" << frame.epilogue << std::endl;
+		this->put_tabs(ofs);
+		ofs << "}" << std::endl;
+	}
 }
 
-void CodeGenerator::write_print_stmt(std::ofstream& ofs,
+void CodeGenerator::write_print_stmt(std::ostream& ofs,
 									 const std::vector<Token>& token_vec) const
 {
 	//convert the expression to C expression
@@ -421,12 +2177,12 @@ void CodeGenerator::write_print_stmt(std::ofstream& ofs,
 	this->put_tabs(ofs);
 	switch (result.type()) {
 		case VariableType::Matrix:
-			ofs << "print_mat(" << result.dim().rows << ", "
+			ofs << use_helper("print_mat") << "(" << result.dim().rows << ", "
 				<< result.dim().cols << ", " << result.name() << ");"
 				<< std::endl;
 			break;
 		case VariableType::Scalar:
-			ofs << "print(" << result.name() << ");" << std::endl;
+			ofs << use_helper("print") << "(" << result.name() << ");" << std::endl;
 			break;
 		default:
 		{
@@ -437,10 +2193,10 @@ void CodeGenerator::write_print_stmt(std::ofstream& ofs,
 	}
 }
 
-void CodeGenerator::write_printsep_stmt(std::ofstream& ofs) const
+void CodeGenerator::write_printsep_stmt(std::ostream& ofs) const
 {
 	this->put_tabs(ofs);
-	ofs << "printsep();" << std::endl;
+	ofs << use_helper("printsep") << "();" << std::endl;
 }
 
 /** Writes a single subscript assignment to output C file.
@@ -452,7 +2208,7 @@ void CodeGenerator::write_printsep_stmt(std::ofstream& ofs) const
   * thrown
   *
   */
-void CodeGenerator::write_single_subscript_assignment(std::ofstream& ofs,
+void CodeGenerator::write_single_subscript_assignment(std::ostream& ofs,
 									 const std::vector<Token>& token_vec) const
 {
 	const Variable id = sym_table->lookup(token_vec.at(0).value());
@@ -493,7 +2249,7 @@ void CodeGenerator::write_single_subscript_assignment(std::ofstream& ofs,
   * thrown
   *
   */
-void CodeGenerator::write_double_subscript_assignment(std::ofstream& ofs,
+void CodeGenerator::write_double_subscript_assignment(std::ostream& ofs,
 									 const std::vector<Token>& token_vec) const
 {
 	const Variable id = sym_table->lookup(token_vec.at(0).value());
@@ -535,7 +2291,7 @@ void CodeGenerator::write_double_subscript_assignment(std::ofstream& ofs,
   * since we do not allow subscript operations that return types other than
   * scalars.
   */
-void CodeGenerator::write_expr_assignment(std::ofstream& ofs,
+void CodeGenerator::write_expr_assignment(std::ostream& ofs,
 									      const std::vector<Token>& token_vec) const
 {
 	/* auto expr_start_index = token_vec.begin(); */
@@ -543,6 +2299,9 @@ void CodeGenerator::write_expr_assignment(std::ofstream& ofs,
 
 	/* } */
 	const Variable lhs = sym_table->lookup(token_vec.at(0).value());
+	if (lhs.type() == VariableType::Matrix && write_transpose_assignment(ofs, lhs, token_vec)) {
+		return;
+	}
 	auto it = token_vec.begin() + 3;
 	const Variable rhs = convert_to_c_expr(it, ofs);
 	this->put_tabs(ofs);
@@ -557,7 +2316,7 @@ void CodeGenerator::write_expr_assignment(std::ofstream& ofs,
 		}
 		//we assign to lhs. mat_assign accepts the result of the assignment
 		//as its last argument.
-		ofs << "mat_assign(" << lhs.dim().rows << ", " << lhs.dim().cols
+		ofs << use_helper("mat_assign") << "(" << lhs.dim().rows << ", " << lhs.dim().cols
 			<< ", " << rhs.name() << ", "
 			<< lhs.name() << ");" << std::endl;
 	} else {
@@ -567,6 +2326,92 @@ void CodeGenerator::write_expr_assignment(std::ofstream& ofs,
 	}
 }
 
+/** If the statement is of the form A = tr(B), writes the transpose of B
+  * directly into A without a helper matrix and returns true. A = tr(A) is
+  * transposed in place when A is square.
+  */
+bool CodeGenerator::write_transpose_assignment(std::ostream& ofs,
+											   const Variable& lhs,
+											   const std::vector<Token>& token_vec) const
+{
+	//A = EXPR_BEGIN tr ( B ) EXPR_END
+	//0 1     2      3  4 5 6    7
+	if (token_vec.size() != 8 ||
+		token_vec[3].category() != TokenCategory::TrFunction ||
+		token_vec[5].category() != TokenCategory::Identifier)
+	{
+		return false;
+	}
+	const Variable arg = sym_table->lookup(token_vec[5].value());
+	const Dimensions dims = arg.dim();
+	if (arg.type() != VariableType::Matrix ||
+		lhs.dim() != Dimensions(dims.cols, dims.rows))
+	{
+		//let the usual conversion report the error
+		return false;
+	}
+	this->put_tabs(ofs);
+	//dimensions of A and tr(A) are the same only if A is square
+	if (arg.name() == lhs.name()) {
+		ofs << use_helper("tr_sq_inplace") << "(" << dims.rows << ", " << lhs.name() << ");"
+			<< std::endl;
+	} else {
+		ofs << use_helper("tr") << "(" << dims.rows << ", " << dims.cols << ", " << arg.name()
+			<< ", " << lhs.name() << ");" << std::endl;
+	}
+	return true;
+}
+
+/** Writes a load statement to output C file. A load statement has the
+  * following format:
+  *
+  *		load(A, "file")	where A is a previously defined matrix or vector
+  *
+  * Files ending with .csv are read as comma separated values, one row in each
+  * line. Other files are mapped to memory and must be binary records as
+  * written with MATLANG_BINARY_OUT. The dimensions in the file are checked
+  * against the declaration of A at runtime.
+  */
+void CodeGenerator::write_load_stmt(std::ostream& ofs,
+									const std::vector<Token>& token_vec) const
+{
+	//load ( A , "file" )
+	// 0   1 2 3    4   5
+	const Variable var = sym_table->lookup(token_vec.at(2).value());
+	if (var.type() != VariableType::Matrix) {
+		throw_error(err_linenum(this->line_count), "load: ", var.name(),
+					" is not a matrix or a vector");
+	}
+	if (!options.entry_point.empty()) {
+		throw_error(err_linenum(this->line_count), "load: ", var.name(),
+					" must be passed to the entry point instead");
+	}
+	const std::string path = token_vec.at(4).value();
+	std::string c_path;
+	for (const char c : path) {
+		if (c == '\\') {
+			c_path += '\\';
+		}
+		c_path += c;
+	}
+	const Dimensions dims = var.dim();
+	const std::string suffix = ".csv";
+	const bool csv = path.size() >= suffix.size() &&
+		path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+	this->put_tabs(ofs);
+	if (csv) {
+		ofs << use_helper("rt_load_csv") << "(\"" << c_path << "\", "
+			<< dims.rows << ", " << dims.cols << ", &" << var.name()
+			<< "[0][0]);" << std::endl;
+	} else {
+		//the matrix points to the mapped file after loading
+		ofs << var.name() << " = (double (*)[" << dims.cols << "])"
+			<< use_helper("rt_load_bin") << "(\"" << c_path << "\", "
+			<< dims.rows << ", " << dims.cols << ", &" << var.name()
+			<< "[0][0]);" << std::endl;
+	}
+}
+
 /** Writes a list assignment statement to output C file.
   * A list assignment statement has the following format:
   *
@@ -574,11 +2419,19 @@ void CodeGenerator::write_expr_assignment(std::ofstream& ofs,
   *							  and expression_list is a list of expressions
   *							  separated with TokenCategory::ListSeparator.
   *
-  * This method translates this list assignment to C code by assigning each
-  * value of the matrix separately. Thus, if expression_list contains 40
-  * expressions, this method would write 40 lines of assignments to the C code.
+  * Constant expressions are evaluated at compile time and written to a static
+  * table which is copied to the matrix with a single memcpy:
+  *
+  *		static const double table[6] = {1, 2, 0, 4, 5, 6};
+  *		memcpy(&A[0][0], table, sizeof(table));
+  *		A[0][2] = x;
+  *
+  * Only the remaining expressions are assigned separately. Constants are
+  * computed as C computes them, see Evaluator. If an expression reads A, it
+  * must see the elements assigned before it, thus every element is assigned
+  * in order without a table.
   */
-void CodeGenerator::write_list_assignment(std::ofstream& ofs,
+void CodeGenerator::write_list_assignment(std::ostream& ofs,
 									      const std::vector<Token>& token_vec) const
 {
 	//		0	   1  2		3		4		...
@@ -587,25 +2440,25 @@ void CodeGenerator::write_list_assignment(std::ofstream& ofs,
 	this->confirm_type(sym_table->lookup(name), VariableType::Matrix);
 	int size1 = sym_table->lookup(name).dim().rows;
 	int size2 = sym_table->lookup(name).dim().cols;
+	//start of each expression in row major order
+	std::vector<citer> elements;
 	//expression begin iterator
 	auto it = token_vec.begin() + 4;
 	for (int i = 0; i < size1; ++i) {
 		for (int j = 0; j < size2; ++j) {
 			//if there is still expressions to read and the iterator
 			//is at close curly braces or at the end of the vector
-			if (it->category() == TokenCategory::CloseCurlyBraces ||
-				it == token_vec.end())
+			if (it == token_vec.end() ||
+				it->category() == TokenCategory::CloseCurlyBraces)
 			{
 				throw_error(err_linenum(this->line_count),
 							"List Initialization: Expected expressions ",
-							size1 + size2, " Found expressions ",
-							i*size2 + j + 1);
+							size1 * size2, " Found expressions ",
+							i*size2 + j);
 			}
-			const auto var = this->convert_to_c_expr(it, ofs);
-			confirm_type(var, VariableType::Scalar);
-			this->put_tabs(ofs);
-			ofs << name << "[" << i << "][" << j << "] = " << var.name()
-				<< ";" << std::endl;
+			elements.push_back(it);
+			while (it->category() != TokenCategory::ExpressionEnd)
+				++it;
 			//pass expr_end and expr_begin so that it on the start of the next
 			//expr
 			it += 2;
@@ -620,6 +2473,43 @@ void CodeGenerator::write_list_assignment(std::ofstream& ofs,
 					"List initialization: Expected closing curly braces, Found: ",
 					it->value());
 	}
+	Evaluator evaluator(sym_table, EvalBudget{1000000, 1000000});
+	std::vector<double> values(elements.size(), 0);
+	std::vector<bool> is_constant(elements.size(), false);
+	bool any_constant = false;
+	//an element reading the matrix reads the elements stored before it,
+	//thus every element is stored in order
+	const bool reads_target = std::any_of(token_vec.begin() + 1, token_vec.end(),
+		[&name](const Token& token) {
+			return token.category() == TokenCategory::Identifier &&
+				   token.value() == name;
+		});
+	for (size_t k = 0; k < elements.size() && !reads_target; ++k) {
+		const size_t begin = static_cast<size_t>(elements[k] - token_vec.begin());
+		size_t end = begin;
+		while (token_vec.at(end).category() != TokenCategory::ExpressionEnd)
+			++end;
+		is_constant[k] = evaluator.constant(token_vec, token_range(begin, end),
+											values[k]);
+		any_constant = any_constant || is_constant[k];
+	}
+	if (any_constant) {
+		const auto table_name = this->get_unique_name();
+		write_static_table(ofs, table_name, values, true);
+		this->put_tabs(ofs);
+		ofs << use_helper("memcpy") << "(&" << name << "[0][0], " << table_name
+			<< ", sizeof(" << table_name << "));" << std::endl;
+	}
+	for (size_t k = 0; k < elements.size(); ++k) {
+		if (is_constant[k])
+			continue;
+		auto first = elements[k];
+		const auto var = this->convert_to_c_expr(first, ofs);
+		confirm_type(var, VariableType::Scalar);
+		this->put_tabs(ofs);
+		ofs << name << "[" << k / size2 << "][" << k % size2 << "] = "
+			<< var.name() << ";" << std::endl;
+	}
 }
 
 /**
@@ -758,7 +2648,7 @@ std::vector<Variable> get_whole_subscript(std::vector<Variable>& expr_stack)
   * mat_sca_mul(2, 1, x, y, _E4_1);
   * assign_mat(2, 1, _E4_1, k);
   */
-Variable CodeGenerator::convert_to_c_expr(citer& first, std::ofstream& ofs) const
+Variable CodeGenerator::convert_to_c_expr(citer& first, std::ostream& ofs) const
 {
 	std::vector<Variable> expr_stack; //use as a stack
 	for (; first->category() != TokenCategory::ExpressionEnd; ++first) {
@@ -852,7 +2742,7 @@ Variable CodeGenerator::convert_to_c_expr(citer& first, std::ofstream& ofs) cons
 }
 
 void CodeGenerator::convert_mat_neg(std::vector<Variable>& expr_stack,
-									std::ofstream& ofs,
+									std::ostream& ofs,
 									const Variable& right_op) const
 {
 	const auto var_name = this->get_unique_name();
@@ -861,7 +2751,7 @@ void CodeGenerator::convert_mat_neg(std::vector<Variable>& expr_stack,
 	ofs << "double " << var_name << "[" << dims.rows
 		<< "][" << dims.cols << "];" << std::endl;
 	this->put_tabs(ofs);
-	ofs << "neg_mat(" << dims.rows << ", "
+	ofs << use_helper("neg_mat") << "(" << dims.rows << ", "
 		<< dims.cols << ", " << right_op.name()
 		<< ", " << var_name << ");" << std::endl;
 	const Variable res(var_name, VariableType::Matrix, dims);
@@ -894,7 +2784,7 @@ void CodeGenerator::convert_subscript(citer index,
 }
 
 void CodeGenerator::convert_function_call(std::vector<Variable>& expr_stack,
-										  std::ofstream& ofs) const
+										  std::ostream& ofs) const
 {
 	//It is a function call. Get the function and then deal with it !!
 	const std::vector<Variable> whole_func = get_function(expr_stack);
@@ -927,7 +2817,7 @@ void CodeGenerator::convert_choose_function(std::vector<Variable>& expr_stack,
 	confirm_type(var_seq.at(6), VariableType::Scalar);
 	confirm_type(var_seq.at(8), VariableType::Scalar);
 	std::ostringstream oss;
-	oss << "choose(" << var_seq.at(2).name() << ", "
+	oss << use_helper("choose") << "(" << var_seq.at(2).name() << ", "
 					 << var_seq.at(4).name() << ", "
 					 << var_seq.at(6).name() << ", "
 					 << var_seq.at(8).name() << ")";
@@ -952,7 +2842,7 @@ void CodeGenerator::convert_sqrt_function(std::vector<Variable>& expr_stack,
 
 void CodeGenerator::convert_tr_function(std::vector<Variable>& expr_stack,
 										const std::vector<Variable>& var_seq,
-										std::ofstream& ofs) const
+										std::ostream& ofs) const
 {
 	//since we are compounding subexpressions into variables,
 	//we only need one indexing to get all the info about the
@@ -971,7 +2861,7 @@ void CodeGenerator::convert_tr_function(std::vector<Variable>& expr_stack,
 			<< "][" << dims.rows << "];" << std::endl;
 		this->put_tabs(ofs);
 		//call the tr function
-		ofs << "tr(" << dims.rows << ", " << dims.cols << ", "
+		ofs << use_helper("tr") << "(" << dims.rows << ", " << dims.cols << ", "
 			<< argument.name() << ", " << helper_name << ");"
 			<< std::endl;
 		Variable new_var(helper_name, VariableType::Matrix,
@@ -1008,7 +2898,7 @@ void CodeGenerator::convert_scalar_ops(std::vector<Variable>& expr_stack,
 }
 
 void CodeGenerator::convert_scalar_mat_mul(std::vector<Variable>& expr_stack,
-										   std::ofstream& ofs,
+										   std::ostream& ofs,
 										   const Variable& matrix,
 										   const Variable& scalar) const
 {
@@ -1019,7 +2909,8 @@ void CodeGenerator::convert_scalar_mat_mul(std::vector<Variable>& expr_stack,
 	ofs << "double " << var_name << "[" << dims.rows << "]["
 		<< dims.cols << "];" << std::endl;
 	this->put_tabs(ofs);
-	ofs << "mat_sca_mul(" << dims.rows << ", " << dims.cols
+	ofs << blas_kernel("mat_sca_mul", static_cast<long>(dims.rows) * dims.cols)
+		<< "(" << dims.rows << ", " << dims.cols
 		<< ", " << scalar.name() << ", " << matrix.name()
 		<< ", " << var_name << ");" << std::endl;
 	//update the symbol table
@@ -1031,7 +2922,7 @@ void CodeGenerator::convert_scalar_mat_mul(std::vector<Variable>& expr_stack,
 }
 
 void CodeGenerator::convert_mat_mat_mul(std::vector<Variable>& expr_stack,
-										std::ofstream& ofs,
+										std::ostream& ofs,
 										const Variable& left_op,
 										const Variable& right_op) const
 {
@@ -1046,7 +2937,8 @@ void CodeGenerator::convert_mat_mat_mul(std::vector<Variable>& expr_stack,
 	if (left_dims.rows == 1 && right_dims.cols == 1) {
 		//then we can return a single double
 		std::ostringstream oss;
-		oss << "mat_mat_mul_s(" << left_dims.cols << ", "
+		oss << blas_kernel("mat_mat_mul_s", left_dims.cols)
+			<< "(" << left_dims.cols << ", "
 			<< left_op.name() << ", " << right_op.name()
 			<< ")";
 		expr_stack.emplace_back(oss.str(), VariableType::Scalar,
@@ -1057,7 +2949,9 @@ void CodeGenerator::convert_mat_mat_mul(std::vector<Variable>& expr_stack,
 		ofs << "double " << var_name << "[" << left_dims.rows << "]["
 			<< right_dims.cols << "];" << std::endl;
 		this->put_tabs(ofs);
-		ofs << "mat_mat_mul(" << left_dims.rows << ", "
+		ofs << blas_kernel("mat_mat_mul", static_cast<long>(left_dims.rows) *
+										  left_dims.cols * right_dims.cols)
+			<< "(" << left_dims.rows << ", "
 			<< left_dims.cols << ", " << right_dims.cols << ", "
 			<< left_op.name() << ", " << right_op.name() <<
 			", " << var_name << ");" << std::endl;
@@ -1071,7 +2965,7 @@ void CodeGenerator::convert_mat_mat_mul(std::vector<Variable>& expr_stack,
 }
 
 void CodeGenerator::convert_mat_mat_sub(std::vector<Variable>& expr_stack,
-										std::ofstream& ofs,
+										std::ostream& ofs,
 										const Variable& left_op,
 										const Variable& right_op) const
 {
@@ -1088,7 +2982,7 @@ void CodeGenerator::convert_mat_mat_sub(std::vector<Variable>& expr_stack,
 	ofs << "double " << var_name << "[" << left_dims.rows << "]["
 		<< left_dims.cols << "];" << std::endl;
 	this->put_tabs(ofs);
-	ofs << "mat_mat_sub(" << left_dims.rows << ", "
+	ofs << use_helper("mat_mat_sub") << "(" << left_dims.rows << ", "
 		<< left_dims.cols << ", " << left_op.name() << ", "
 		<< right_op.name() << ", " << var_name << ");"
 		<< std::endl;
@@ -1100,7 +2994,7 @@ void CodeGenerator::convert_mat_mat_sub(std::vector<Variable>& expr_stack,
 }
 
 void CodeGenerator::convert_mat_mat_add(std::vector<Variable>& expr_stack,
-										std::ofstream& ofs,
+										std::ostream& ofs,
 										const Variable& left_op,
 										const Variable& right_op) const
 {
@@ -1118,7 +3012,7 @@ void CodeGenerator::convert_mat_mat_add(std::vector<Variable>& expr_stack,
 	ofs << "double " << var_name << "[" << left_dims.rows << "]["
 		<< left_dims.cols << "];" << std::endl;
 	this->put_tabs(ofs);
-	ofs << "mat_mat_add(" << left_dims.rows << ", "
+	ofs << use_helper("mat_mat_add") << "(" << left_dims.rows << ", "
 		<< left_dims.cols << ", " << left_op.name() << ", "
 		<< right_op.name() << ", " << var_name << ");"
 		<< std::endl;
@@ -1129,9 +3023,38 @@ void CodeGenerator::convert_mat_mat_add(std::vector<Variable>& expr_stack,
 	expr_stack.emplace_back(var_name, VariableType::Matrix, left_dims);
 }
 
+/** Writes a static array of doubles initialized with the given values:
+  *
+  *	static const double name[3] = {
+  *		1, 2.5, 3
+  *	};
+  */
+void CodeGenerator::write_static_table(std::ostream& ofs, const std::string& name,
+									   const std::vector<double>& values,
+									   bool constant) const
+{
+	this->put_tabs(ofs);
+	ofs << "static " << (constant ? "const " : "") << "double " << name << "["
+		<< values.size() << "] = {";
+	for (size_t k = 0; k < values.size(); ++k) {
+		//8 values in each line
+		if (k % 8 == 0) {
+			ofs << std::endl;
+			this->put_tabs(ofs);
+			ofs << "\t";
+		} else {
+			ofs << " ";
+		}
+		ofs << c_literal(values[k]) << ((k + 1 != values.size()) ? "," : "");
+	}
+	ofs << std::endl;
+	this->put_tabs(ofs);
+	ofs << "};" << std::endl;
+}
+
 /** puts tabs by the quantity specified by this->indentation_level to ofs
   */
-void CodeGenerator::put_tabs(std::ofstream& ofs) const
+void CodeGenerator::put_tabs(std::ostream& ofs) const
 {
 	for (int i = 0; i < this->indentation_level; ++i) {
 		ofs << '\t';
@@ -1146,8 +3069,7 @@ void CodeGenerator::put_tabs(std::ofstream& ofs) const
   */
 std::string CodeGenerator::get_unique_name() const
 {
-	static int count = 0;
-	return helper_name_prefix + std::to_string(count++);
+	return helper_name_prefix + std::to_string(unique_name_count++);
 }
 
 /** Base concatenate method. To stop the recursion
@@ -1,7 +1,77 @@
 #pragma once
 #include "symbol_table.hpp"
 #include "definitions.hpp"
+#include "loop_analyzer.hpp"
+#include "dataflow.hpp"
+#include "evaluator.hpp"
 #include <fstream>
+#include <ostream>
+#include <map>
+#include <set>
+
+/** Options that change the shape of the generated C code. By default the
+  * program is optimized with -O1, i.e. the constants are folded and the dead
+  * code is removed, and the other options are off, which produces a plain
+  * sequential C program. compiler_threads is 1, but main sets it to the
+  * number of hardware threads unless --jobs is given.
+  */
+struct CodeGenOptions {
+	//annotate the loops without cross iteration dependences with OpenMP
+	//pragmas. Programs compiled without -fopenmp ignore the pragmas.
+	bool parallel_loops;
+	//split large matrix kernels into tiles run on a pthread worker pool
+	bool threaded_runtime;
+	//run independent assignments between the print statements concurrently
+	//as OpenMP tasks
+	bool task_graph;
+	//call CBLAS for the products with at least blas_min_work multiplications
+	bool blas;
+	long blas_min_work;
+	//include matlangrt.h and call the helpers of libmatlangrt instead of
+	//writing them into the program
+	bool runtime_library;
+	//run the program at compile time and print the precomputed results. The
+	//rest of the program is generated as usual if the budget runs out.
+	bool evaluate;
+	long eval_operations;
+	long eval_memory;
+	//optimization passes to run. See PassManager.
+	int optimization_level;
+	//print the time each pass takes to stderr
+	bool time_passes;
+	//fold the constant subexpressions and propagate the constant scalars
+	bool fold_constants;
+	//remove the assignments whose results are never printed
+	bool eliminate_dead_code;
+	//name of the reentrant function written instead of main. The function
+	//takes the storage of the declared matrices and a callback for the
+	//prints. Empty for main.
+	std::string entry_point;
+	//number of threads compiling the program. The generated code is the same
+	//for any number of threads.
+	unsigned compiler_threads;
+	//number of top level statements in each function of a program split
+	//into translation units. 0 writes the whole program into main.
+	long split_statements;
+	CodeGenOptions()
+		: parallel_loops(false)
+		, threaded_runtime(false)
+		, task_graph(false)
+		, blas(false)
+		, blas_min_work(4096)
+		, runtime_library(false)
+		, evaluate(false)
+		, eval_operations(100000000)
+		, eval_memory(16 << 20)
+		, optimization_level(1)
+		, time_passes(false)
+		, fold_constants(true)
+		, eliminate_dead_code(true)
+		, entry_point()
+		, compiler_threads(1)
+		, split_statements(0)
+	{};
+};
 
 /** Constructed with a pointer to the symbol table that is updated in the
   * previous steps of the compilation.
@@ -15,13 +85,21 @@
   */
 class CodeGenerator {
 public:
-	CodeGenerator(SymbolTable* const sym_table_ptr)
+	CodeGenerator(SymbolTable* const sym_table_ptr,
+				  const CodeGenOptions& t_options = CodeGenOptions())
 		: sym_table(sym_table_ptr)
-		, double_for(false)
+		, options(t_options)
+		, loop_analyzer(sym_table_ptr)
+		, dataflow_analyzer(sym_table_ptr)
+		, open_loops()
 		, indentation_level(0)
 		  //give a kind of unique prefix to the var.s in order to prevent clashes
 		, helper_name_prefix("_E4_")
+		, unique_name_count(0)
 		, line_count(0)
+		, used_helpers()
+		, loaded_matrices()
+		, entry_matrices()
 	{ };
 	~CodeGenerator() {};
 	CodeGenerator(const CodeGenerator&) = default;
@@ -31,11 +109,19 @@ public:
 	//specified with the given output_file_name
 	void generate_c_code(const std::vector<stmt_with_info>& src_file,
 						 const std::string& out_file_name);
+	void generate_c_code(const std::vector<stmt_with_info>& src_file,
+						 std::ostream& ofs);
+	//checks the program and returns it after the optimization passes
+	std::vector<stmt_with_info> optimize(const std::vector<stmt_with_info>& program);
+	//Writes the source and the header of the runtime library with every
+	//helper enabled by the options
+	void generate_runtime(const std::string& header_name,
+						  const std::string& source_name);
 private:
 	//returns a unique name each time called. Used for helper variable naming.
 	std::string get_unique_name() const;
 	//puts indentation amount of tabs
-	void put_tabs						  (std::ofstream&) const;
+	void put_tabs						  (std::ostream&) const;
 	typedef std::vector<Token>::const_iterator citer;
 	//confirms the var's type. If not the same, throws an exception
 	void confirm_type(const Variable& var, const VariableType& var_type) const;
@@ -44,58 +130,138 @@ private:
 	//returns, the passed iterator will be pointing to ExpressionEnd
 	//During the expression conversion, helper variables are created. Thus,
 	//ofs must be passed as a paremeter as well.
-	Variable convert_to_c_expr(citer& first, std::ofstream& ofs) const;
+	Variable convert_to_c_expr(citer& first, std::ostream& ofs) const;
 private:
 	/* HELPER FUNCTIONS */
+	//marks the helper as used and returns its name. Only the used helpers and
+	//their dependencies are written to the output.
+	const std::string& use_helper(const std::string& name) const;
+	std::map<std::string, std::vector<std::string>> helper_dependencies() const;
+	void add_helper_dependencies() const;
+	typedef void (CodeGenerator::*helper_writer)(std::ostream&) const;
+	std::vector<std::pair<std::string, helper_writer>> helper_writers() const;
 	//program structure. Basically calls the other functions.
-	void write_program_structure        (std::ofstream&) const;
+	void write_program_structure        (std::ostream&) const;
 	//preprocessor commands. As of now, only include statements.
-	void write_preprocessor_commands	(std::ofstream&) const;
+	void write_preprocessor_commands	(std::ostream&) const;
+	//worker pool used by the kernels of the threaded runtime
+	void write_thread_pool				(std::ostream&) const;
+	void write_threaded_kernel			(std::ostream&,
+										 const std::string& signature,
+										 const std::string& rows_name,
+										 const std::string& args_init,
+										 const std::string& row_decls,
+										 const std::string& rows_body,
+										 const std::string& work,
+										 const std::string& row_size) const;
 	//These are program structure functions. They are written before the main
 	//function and called when necessary.
-	void write_tr_function		          (std::ofstream&) const;
-	void write_choose_function	          (std::ofstream&) const;
-	void write_print_function	          (std::ofstream&) const;
-	void write_printsep_function          (std::ofstream&) const;
-	void write_matrix_matrix_multiply     (std::ofstream&) const;
-	void write_negative_matrix			  (std::ofstream&) const;
-	void write_matrix_matrix_subtract     (std::ofstream&) const;
-	void write_matrix_matrix_add          (std::ofstream&) const;
-	void write_scalar_matrix_multiply     (std::ofstream&) const;
-	void write_matrix_assign			  (std::ofstream&) const;
+	void write_tr_block_size			  (std::ostream&) const;
+	void write_tr_recursive				  (std::ostream&) const;
+	void write_tr_inplace				  (std::ostream&) const;
+	void write_tr_function		          (std::ostream&) const;
+	void write_choose_function	          (std::ostream&) const;
+	void write_output_buffer			  (std::ostream&) const;
+	void write_print_function	          (std::ostream&) const;
+	void write_print_mat_function		  (std::ostream&) const;
+	void write_printsep_function          (std::ostream&) const;
+	void write_print_sink				  (std::ostream&) const;
+	void write_entry_point				  (std::ostream&) const;
+	//writes the program as functions of options.split_statements top level
+	//statements in translation units of their own
+	void generate_split_c_code			  (const std::vector<stmt_with_info>&,
+										   const std::string& out_file_name);
+	//readers of the load statement
+	void write_binary_loader			  (std::ostream&) const;
+	void write_csv_loader				  (std::ostream&) const;
+	void write_matrix_matrix_multiply     (std::ostream&) const;
+	void write_serial_matrix_multiply     (std::ostream&) const;
+	void write_vector_dot_product		  (std::ostream&) const;
+	void write_negative_matrix			  (std::ostream&) const;
+	void write_matrix_matrix_subtract     (std::ostream&) const;
+	void write_matrix_matrix_add          (std::ostream&) const;
+	void write_scalar_matrix_multiply     (std::ostream&) const;
+	void write_matrix_assign			  (std::ostream&) const;
+	//CBLAS wrappers falling back to the built-in kernels
+	void write_blas_prototypes			  (std::ostream&) const;
+	void write_blas_matrix_multiply		  (std::ostream&) const;
+	void write_blas_scalar_multiply		  (std::ostream&) const;
+	void write_blas_dot_product			  (std::ostream&) const;
+	//returns name + "_blas" if a product with the given number of
+	//multiplications should be computed by CBLAS
+	std::string blas_kernel(const std::string& name, long work) const;
+	//writes the statements starting at src_file[begin]
+	void write_statements				  (std::ostream&,
+											   const std::vector<stmt_with_info>&,
+											   size_t begin);
+	//returns the bounds of the chunks of top level statements written on the
+	//compiler threads. Empty if the statements are written on this thread.
+	std::vector<size_t> statement_chunks (const std::vector<stmt_with_info>&,
+										  size_t begin) const;
+	//writes the chunks on the compiler threads
+	void write_statement_chunks			  (std::ostream&,
+											   const std::vector<stmt_with_info>&,
+											   const std::vector<size_t>& bounds);
+	//writes the output of the evaluated statements and the values they leave
+	void write_evaluated_statements		  (std::ostream&,
+											   const std::vector<stmt_with_info>&,
+											   const EvalResult&);
+	void write_static_table				  (std::ostream&, const std::string& name,
+											   const std::vector<double>& values,
+											   bool constant) const;
 	//Statements that appear inside the   main function.
-	void write_end_for		    		  (std::ofstream&) const;
-	void write_printsep_stmt			  (std::ofstream&) const;
-	void write_scalar_declr				  (std::ofstream&, const std::vector<Token>&) const;
-	void write_vector_declr				  (std::ofstream&, const std::vector<Token>&) const;
-	void write_matrix_declr				  (std::ofstream&, const std::vector<Token>&) const;
-	void write_single_for				  (std::ofstream&, const std::vector<Token>&) const;
-	void write_double_for				  (std::ofstream&, const std::vector<Token>&) const;
-	void write_print_stmt				  (std::ofstream&, const std::vector<Token>&) const;
-	void write_expr_assignment			  (std::ofstream&, const std::vector<Token>&) const;
-	void write_single_subscript_assignment(std::ofstream&, const std::vector<Token>&) const;
-	void write_double_subscript_assignment(std::ofstream&, const std::vector<Token>&) const;
-	void write_list_assignment			  (std::ofstream&, const std::vector<Token>&) const;
+	void write_statement				  (std::ostream&,
+										   const std::vector<stmt_with_info>&,
+										   size_t index);
+	void write_task_region				  (std::ostream&,
+										   const std::vector<stmt_with_info>&,
+										   const TaskRegion&);
+	//a for statement whose closing braces are not written yet
+	struct LoopFrame {
+		int for_count; //number of C for statements. 2 for double for
+		int indentation; //indentation_level before the loop
+		bool parallel;
+		std::string epilogue; //statement written after a parallel loop
+	};
+	void write_end_for		    		  (std::ostream&, const LoopFrame&) const;
+	void write_printsep_stmt			  (std::ostream&) const;
+	void write_scalar_declr				  (std::ostream&, const std::vector<Token>&) const;
+	void write_vector_declr				  (std::ostream&, const std::vector<Token>&) const;
+	void write_matrix_declr				  (std::ostream&, const std::vector<Token>&) const;
+	void write_single_for				  (std::ostream&, const std::vector<Token>&) const;
+	void write_double_for				  (std::ostream&, const std::vector<Token>&) const;
+	//writes the loop as an OpenMP parallel for over an integer iteration count
+	//and returns the statement that sets the loop variable after the loop
+	std::string write_parallel_for		  (std::ostream&, const std::vector<Token>&,
+										   const LoopParallelism&) const;
+	void write_print_stmt				  (std::ostream&, const std::vector<Token>&) const;
+	void write_expr_assignment			  (std::ostream&, const std::vector<Token>&) const;
+	bool write_transpose_assignment		  (std::ostream&, const Variable& lhs,
+										   const std::vector<Token>&) const;
+	void write_single_subscript_assignment(std::ostream&, const std::vector<Token>&) const;
+	void write_double_subscript_assignment(std::ostream&, const std::vector<Token>&) const;
+	void write_list_assignment			  (std::ostream&, const std::vector<Token>&) const;
+	void write_load_stmt				  (std::ostream&, const std::vector<Token>&) const;
 	//The following functions are helpers for convert_to_c_expr
 	//Each function are called when certain preconditions are met. For example,
 	//when two matrices are multiplied, conversion function for mat mat
 	//multiplication is called.
 	void convert_scalar_ops				  (std::vector<Variable>&, const TokenCategory&,
 							    		   const Variable&, const Variable&) const;
-	void convert_scalar_mat_mul 		  (std::vector<Variable>&, std::ofstream&,
+	void convert_scalar_mat_mul 		  (std::vector<Variable>&, std::ostream&,
 							    		   const Variable&, const Variable&) const;
-	void convert_mat_neg				  (std::vector<Variable>&, std::ofstream&,
+	void convert_mat_neg				  (std::vector<Variable>&, std::ostream&,
 										   const Variable&) const;
-	void convert_mat_mat_add    		  (std::vector<Variable>&, std::ofstream&,
+	void convert_mat_mat_add    		  (std::vector<Variable>&, std::ostream&,
 							    		   const Variable&, const Variable&) const;
-	void convert_mat_mat_sub    		  (std::vector<Variable>&, std::ofstream&,
+	void convert_mat_mat_sub    		  (std::vector<Variable>&, std::ostream&,
 							    		   const Variable&, const Variable&) const;
-	void convert_mat_mat_mul    		  (std::vector<Variable>&, std::ofstream&,
+	void convert_mat_mat_mul    		  (std::vector<Variable>&, std::ostream&,
 							    		   const Variable&, const Variable&) const;
-	void convert_function_call  		  (std::vector<Variable>&, std::ofstream&) const;
+	void convert_function_call  		  (std::vector<Variable>&, std::ostream&) const;
 	void convert_tr_function    		  (std::vector<Variable>&,
 							    		   const std::vector<Variable>&,
-							    		   std::ofstream&) const;
+							    		   std::ostream&) const;
 	void convert_sqrt_function  		  (std::vector<Variable>&,
 							    		   const std::vector<Variable>&) const;
 	void convert_choose_function		  (std::vector<Variable>&,
@@ -103,10 +269,23 @@ private:
 	void convert_subscript      		  (citer, std::vector<Variable>&) const;
 private:
 	SymbolTable* const sym_table;
-	bool double_for; //if there is a double loop. Used for indentation
+	const CodeGenOptions options;
+	LoopAnalyzer loop_analyzer;
+	DataflowAnalyzer dataflow_analyzer;
+	std::vector<LoopFrame> open_loops; //innermost loop is at the back
 	int indentation_level; //indentation_level in tabs
 	//used in giving in unique names to helper variables in the resulting program
 	const std::string helper_name_prefix;
+	//number of the names given by get_unique_name. Kept per generator so
+	//that generators on different threads give the same names.
+	mutable int unique_name_count;
 	//the current line we are at. Updated at each iteration of code generation
 	int line_count;
+	//names of the helpers called from main
+	mutable std::set<std::string> used_helpers;
+	//matrices filled by load statements. They are declared as pointers to
+	//rows so that they can point to a memory mapped file.
+	std::set<std::string> loaded_matrices;
+	//index of each matrix in the storage passed to the entry point
+	std::map<std::string, int> entry_matrices;
 };
@@ -0,0 +1,332 @@
+#include "compiler.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "parallel.hpp"
+#include "parser.hpp"
+#include "semantic_analyzer.hpp"
+
+//lines tokenized and parsed by a thread at least
+static const size_t min_lines_per_thread = 1024;
+
+//statements that add a variable to the symbol table
+static bool is_declaration(TokenCategory category)
+{
+	return category == TokenCategory::ScalarDeclaration ||
+		   category == TokenCategory::VectorDeclaration ||
+		   category == TokenCategory::MatrixDeclaration;
+}
+
+std::vector<Compiler::ParsedLine> Compiler::parse_lines(const std::vector<std::string>& lines,
+														unsigned threads)
+{
+	std::vector<ParsedLine> result(lines.size());
+	const size_t chunk_count = std::min<size_t>(threads, lines.size() / min_lines_per_thread);
+	const size_t chunk_size = (lines.size() + chunk_count - 1) / chunk_count;
+	parallel_for(chunk_count, threads, [&](size_t chunk) {
+		//regexes aren't shared between the threads
+		Lexer lexer;
+		const Regex empty_line_rgx(R"(^[[:space:]]*$)");
+		//declarations aren't parsed here, thus the table stays empty
+		SymbolTable sym_table;
+		Parser parser(&sym_table);
+		const size_t end = std::min(lines.size(), (chunk + 1) * chunk_size);
+		for (size_t index = chunk * chunk_size; index < end; ++index) {
+			ParsedLine& line = result[index];
+			try {
+				if (empty_line_rgx.search(lines[index])) {
+					continue;
+				}
+				line.lexed = lexer.tokenize(lines[index]);
+				if (line.lexed.empty()) {
+					continue;
+				}
+				const TokenCategory first = line.lexed.front().category();
+				line.declaration = first == TokenCategory::ScalarType ||
+								   first == TokenCategory::VectorType ||
+								   first == TokenCategory::MatrixType;
+				if (!line.declaration) {
+					line.parsed = line.lexed;
+					line.category = parser.parse(line.parsed);
+				}
+			} catch (const std::runtime_error& e) {
+				line.error = e.what();
+				break;
+			}
+		}
+	});
+	return result;
+}
+
+std::vector<stmt_with_info> Compiler::parse(std::istream& source, SymbolTable* sym_table,
+											ParseCache* cache, unsigned threads)
+{
+	//comments are stripped without deleting any line, thus line numbers are
+	//preserved
+	std::stringstream preprocessed;
+	preprocessor.remove_comments(source, preprocessed);
+	std::vector<std::string> lines;
+	std::string line;
+	while (std::getline(preprocessed, line)) {
+		lines.push_back(line);
+	}
+	//large sources are tokenized and parsed on the threads first. Small ones
+	//are parsed on this thread.
+	std::vector<ParsedLine> parsed_lines;
+	if (cache == nullptr && threads > 1 && lines.size() >= 2 * min_lines_per_thread) {
+		parsed_lines = parse_lines(lines, threads);
+	}
+	Parser parser(sym_table); //parser does the syntax check
+	SemanticAnalyzer sem_analyze(sym_table); //semantic checks
+	//stores the whole file as lines. Each line is a vector of tokens and a
+	//statement type and the line number. See definitions.hpp for more info
+	std::vector<stmt_with_info> source_as_tokens;
+	for (size_t index = 0; index < lines.size(); ++index) {
+		const int line_count = static_cast<int>(index) + 1;
+		try {
+			if (!parsed_lines.empty()) {
+				const ParsedLine& parsed = parsed_lines[index];
+				if (!parsed.error.empty()) {
+					throw std::runtime_error(parsed.error);
+				} else if (parsed.declaration) {
+					//declarations add their variables to the symbol table in
+					//the order they are declared
+					auto token_vec = parsed.lexed;
+					const auto stmt_category = parser.parse(token_vec);
+					source_as_tokens.emplace_back(token_vec, stmt_category, line_count);
+				} else if (!parsed.lexed.empty()) {
+					source_as_tokens.emplace_back(parsed.parsed, parsed.category, line_count);
+				}
+				continue;
+			}
+			ParseCache::Line* cached = cache ? cache->find(lines[index]) : nullptr;
+			if (cached == nullptr) {
+				//whenever we see an empty line, we go to the next line
+				if (empty_line_rgx.search(lines[index])) {
+					if (cache) {
+						cache->insert(lines[index], std::vector<Token>(),
+									  std::vector<Token>(), TokenCategory());
+					}
+					continue;
+				}
+				//tokenize the current line
+				const auto lexed = lexer.tokenize(lines[index]);
+				auto token_vec = lexed;
+				TokenCategory stmt_category = TokenCategory();
+				if (!token_vec.empty()) {
+					//parser does syntax check on the token vector and returns
+					//what kind of statement this particular token vector is
+					stmt_category = parser.parse(token_vec);
+					source_as_tokens.emplace_back(token_vec, stmt_category, line_count);
+				}
+				if (cache) {
+					cache->insert(lines[index], lexed, token_vec, stmt_category);
+				}
+			} else if (!cached->lexed.empty()) {
+				const TokenCategory category = cached->category;
+				if (is_declaration(category)) {
+					//declarations are parsed again to add their variables to
+					//the symbol table
+					auto token_vec = cached->lexed;
+					const auto stmt_category = parser.parse(token_vec);
+					source_as_tokens.emplace_back(token_vec, stmt_category, line_count);
+				} else {
+					source_as_tokens.emplace_back(cached->parsed, category, line_count);
+				}
+			}
+		} catch (const std::runtime_error& e) {
+			//embed line info to the error
+			throw CompileError("Error (Line " + std::to_string(line_count) + "): " +
+							   e.what(), -4);
+		}
+	}
+	//After the whole file passes the syntax check, pass the whole file to
+	//semantic analyzer
+	try {
+		sem_analyze.analyze(source_as_tokens);
+	} catch (const std::runtime_error& e) {
+		throw CompileError(e.what(), -5);
+	}
+	return source_as_tokens;
+}
+
+ParseCache::Line* ParseCache::find(const std::string& text)
+{
+	const auto it = lines.find(text);
+	if (it == lines.end()) {
+		++misses;
+		return nullptr;
+	}
+	++hits;
+	it->second.used = true;
+	return &it->second;
+}
+
+void ParseCache::insert(const std::string& text, const std::vector<Token>& lexed,
+						const std::vector<Token>& parsed, TokenCategory category)
+{
+	lines.emplace(text, Line(lexed, parsed, category));
+}
+
+void ParseCache::evict()
+{
+	for (auto it = lines.begin(); it != lines.end();) {
+		if (it->second.used) {
+			it->second.used = false;
+			++it;
+		} else {
+			it = lines.erase(it);
+		}
+	}
+}
+
+/** Diagnostics are the messages matlang2c prints for the same source. */
+CompileResult Compiler::compile(const std::string& source, const CodeGenOptions& options)
+{
+	std::ostringstream output;
+	CompileResult result = compile(source, output, options);
+	if (result.status == 0) {
+		result.output = output.str();
+	}
+	return result;
+}
+
+CompileResult Compiler::compile(const std::string& source, std::ostream& sink,
+								const CodeGenOptions& options)
+{
+	CompileResult result;
+	std::istringstream source_stream(source);
+	SymbolTable sym_table;
+	const auto start = std::chrono::steady_clock::now();
+	try {
+		const auto program = parse(source_stream, &sym_table, nullptr, options.compiler_threads);
+		const auto parsed = std::chrono::steady_clock::now();
+		result.stats.statements = program.size();
+		result.stats.parse_seconds = std::chrono::duration<double>(parsed - start).count();
+		//expression validity is checked at code generation level
+		CodeGenerator code_gen(&sym_table, options);
+		const auto first_byte = sink.tellp();
+		try {
+			code_gen.generate_c_code(program, sink);
+		} catch (const std::runtime_error& e) {
+			throw CompileError(e.what(), -7);
+		}
+		if (first_byte != std::streampos(-1)) {
+			result.stats.output_bytes = static_cast<size_t>(sink.tellp() - first_byte);
+		}
+		result.stats.generate_seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - parsed).count();
+	} catch (const CompileError& e) {
+		result.status = e.status;
+		result.diagnostics = std::string(e.what()) + "\n";
+	}
+	return result;
+}
+
+CompileResult Compiler::compile_file(const std::string& source_name,
+									const std::string& output_name,
+									const CodeGenOptions& options)
+{
+	CompileResult result;
+	std::ifstream source(source_name.c_str());
+	if (!source) {
+		result.status = -3;
+		result.diagnostics = source_name + " couldn't be opened\n";
+		return result;
+	}
+	SymbolTable sym_table;
+	try {
+		const auto program = parse(source, &sym_table);
+		CodeGenerator code_gen(&sym_table, options);
+		try {
+			code_gen.generate_c_code(program, output_name);
+		} catch (const std::runtime_error& e) {
+			std::remove(output_name.c_str());
+			throw CompileError(e.what(), -7);
+		}
+	} catch (const CompileError& e) {
+		result.status = e.status;
+		result.diagnostics = std::string(e.what()) + "\n";
+	}
+	return result;
+}
+
+//each thread compiles with its own Compiler
+static Compiler& thread_compiler()
+{
+	thread_local Compiler compiler;
+	return compiler;
+}
+
+CompileResult compile_matlang(const std::string& source, const CodeGenOptions& options)
+{
+	return thread_compiler().compile(source, options);
+}
+
+CompileResult compile_matlang(const std::string& source, std::ostream& sink,
+							  const CodeGenOptions& options)
+{
+	return thread_compiler().compile(source, sink, options);
+}
+
+bool parse_option(const std::string& arg, CodeGenOptions& options)
+{
+	//returns the value of a --flag=N option
+	const auto value = [&arg](size_t prefix) {
+		try {
+			return std::stol(arg.substr(prefix));
+		} catch (const std::exception&) {
+			throw CompileError("Error: Invalid value in " + arg, -2);
+		}
+	};
+	if (arg == "--parallel") {
+		options.parallel_loops = true;
+	} else if (arg == "--threads") {
+		options.threaded_runtime = true;
+	} else if (arg == "--tasks") {
+		options.task_graph = true;
+	} else if (arg == "--runtime-lib") {
+		options.runtime_library = true;
+	} else if (arg == "--blas") {
+		options.blas = true;
+	} else if (arg.compare(0, 11, "--blas-min=") == 0) {
+		options.blas_min_work = value(11);
+	} else if (arg == "-O0" || arg == "-O1" || arg == "-O2") {
+		options.optimization_level = arg[2] - '0';
+	} else if (arg == "--time-passes") {
+		options.time_passes = true;
+	} else if (arg == "--no-fold") {
+		options.fold_constants = false;
+	} else if (arg == "--no-dce") {
+		options.eliminate_dead_code = false;
+	} else if (arg == "--eval") {
+		options.evaluate = true;
+	} else if (arg.compare(0, 11, "--eval-ops=") == 0) {
+		options.eval_operations = value(11);
+	} else if (arg.compare(0, 11, "--eval-mem=") == 0) {
+		options.eval_memory = value(11);
+	} else if (arg.compare(0, 8, "--entry=") == 0) {
+		//the name of a C function other than main
+		const std::string name = arg.substr(8);
+		const bool identifier = !name.empty() &&
+			!std::isdigit(static_cast<unsigned char>(name[0])) &&
+			std::all_of(name.begin(), name.end(), [](char c) {
+				return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+			});
+		if (!identifier || name == "main") {
+			throw CompileError("Error: Invalid value in " + arg, -2);
+		}
+		options.entry_point = name;
+	} else if (arg.compare(0, 8, "--split=") == 0) {
+		options.split_statements = value(8);
+		if (options.split_statements <= 0) {
+			throw CompileError("Error: Invalid value in " + arg, -2);
+		}
+	} else {
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,169 @@
+#pragma once
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "code_generator.hpp"
+#include "definitions.hpp"
+#include "lexer.hpp"
+#include "preprocessor.hpp"
+#include "regex.hpp"
+#include "symbol_table.hpp"
+#include "token.hpp"
+
+/** An error of a compilation with the exit status matlang2c returns for it */
+class CompileError : public std::runtime_error {
+public:
+	CompileError(const std::string& message, int t_status)
+		: std::runtime_error(message)
+		, status(t_status)
+	{ };
+	const int status;
+};
+
+/** Statistics of a compilation */
+struct CompileStats {
+	//number of statements in the program
+	size_t statements;
+	//number of bytes of the generated C code
+	size_t output_bytes;
+	//time spent in checking the program and in generating the code
+	double parse_seconds;
+	double generate_seconds;
+	CompileStats()
+		: statements(0)
+		, output_bytes(0)
+		, parse_seconds(0)
+		, generate_seconds(0)
+	{ };
+};
+
+/** Generated C code of a compilation or the message of its error. status is
+  * the exit status of matlang2c.
+  */
+struct CompileResult {
+	int status;
+	std::string output;
+	std::string diagnostics;
+	CompileStats stats;
+	CompileResult()
+		: status(0)
+		, output()
+		, diagnostics()
+		, stats()
+	{ };
+};
+
+/** Tokens and statement type of the lines parsed before, by their text after
+  * the comments are removed. A line's tokens and statement don't depend on
+  * the other lines, thus a line is lexed and parsed again only if its text
+  * changes. Declarations are parsed again from their tokens to fill the
+  * symbol table.
+  */
+class ParseCache {
+public:
+	struct Line {
+		std::vector<Token> lexed;
+		std::vector<Token> parsed;
+		TokenCategory category;
+		//true if the line is in the last parsed source
+		bool used;
+		Line(const std::vector<Token>& t_lexed, const std::vector<Token>& t_parsed,
+			 TokenCategory t_category)
+			: lexed(t_lexed)
+			, parsed(t_parsed)
+			, category(t_category)
+			, used(true)
+		{ };
+	};
+	ParseCache()
+		: lines()
+		, hits(0)
+		, misses(0)
+	{ };
+	//returns the cached line or nullptr
+	Line* find(const std::string& text);
+	//adds a line that is lexed and parsed without an error
+	void insert(const std::string& text, const std::vector<Token>& lexed,
+				const std::vector<Token>& parsed, TokenCategory category);
+	//removes the lines that aren't found or inserted since the last call
+	void evict();
+	//number of the lines found and not found since the cache is created
+	size_t hit_count() const { return hits; };
+	size_t miss_count() const { return misses; };
+private:
+	std::unordered_map<std::string, Line> lines;
+	size_t hits;
+	size_t misses;
+};
+
+/** Compiles sources from memory. The lexer and its regexes are created once
+  * and shared by all the compilations, thus a compiler kept alive compiles
+  * small sources without the startup cost of matlang2c.
+  */
+class Compiler {
+public:
+	Compiler()
+		: preprocessor()
+		, lexer()
+		, empty_line_rgx(R"(^[[:space:]]*$)")
+	{ };
+	//tokenizes, parses and checks the source after its comments are removed.
+	//Declarations are added to sym_table. The lines in the cache aren't
+	//tokenized and parsed again. Without a cache, the lines are tokenized and
+	//parsed on the given number of threads. Throws a CompileError.
+	std::vector<stmt_with_info> parse(std::istream& source, SymbolTable* sym_table,
+									  ParseCache* cache = nullptr, unsigned threads = 1);
+	//compiles the source with the given options to C
+	CompileResult compile(const std::string& source, const CodeGenOptions& options);
+	//writes the C code to the sink instead of the output of the result. On
+	//an error, a part of the code may already be written.
+	CompileResult compile(const std::string& source, std::ostream& sink,
+						  const CodeGenOptions& options);
+	//compiles the source file to the output file. The output file is removed
+	//if the code generation fails. output of the result is empty.
+	CompileResult compile_file(const std::string& source_name, const std::string& output_name,
+							   const CodeGenOptions& options);
+private:
+	//a line tokenized and parsed on a thread
+	struct ParsedLine {
+		std::vector<Token> lexed;
+		std::vector<Token> parsed;
+		TokenCategory category;
+		//declarations are parsed in order to fill the symbol table
+		bool declaration;
+		std::string error;
+		ParsedLine()
+			: lexed()
+			, parsed()
+			, category()
+			, declaration(false)
+			, error()
+		{ };
+	};
+	//tokenizes and parses the lines on the threads. The lines after an
+	//error are skipped.
+	static std::vector<ParsedLine> parse_lines(const std::vector<std::string>& lines,
+											   unsigned threads);
+private:
+	const Preprocessor preprocessor;
+	Lexer lexer;
+	const Regex empty_line_rgx;
+};
+
+/** Library interface of matlang2c. Compiles the source in memory with a
+  * Compiler kept for the calling thread, thus the calls are thread safe and
+  * only the first call on a thread pays for compiling the regexes. Link with
+  * build/libmatlang2c.a -ldl -pthread, built by make library.
+  */
+CompileResult compile_matlang(const std::string& source,
+							  const CodeGenOptions& options = CodeGenOptions());
+CompileResult compile_matlang(const std::string& source, std::ostream& sink,
+							  const CodeGenOptions& options = CodeGenOptions());
+
+//sets the code generation option given with the flag. Returns false if the
+//flag isn't a code generation option. Throws a CompileError if its value is
+//invalid.
+bool parse_option(const std::string& arg, CodeGenOptions& options);
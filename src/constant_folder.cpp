@@ -0,0 +1,346 @@
+#include "constant_folder.hpp"
+#include <algorithm>
+#include <cmath>
+
+std::vector<stmt_with_info> ConstantFolder::fold(const std::vector<stmt_with_info>& src_file)
+{
+	std::vector<stmt_with_info> result;
+	std::map<std::string, double> constants;
+	fold_range(src_file, 0, src_file.size(), constants, result);
+	return result;
+}
+
+/** A scalar is a known constant after it is assigned a constant. Loops kill
+  * the constants written in their body before the loop, since the body may run
+  * any number of times. Constants found in the body are only used in the body.
+  */
+void ConstantFolder::fold_range(const std::vector<stmt_with_info>& src_file,
+								size_t begin, size_t end,
+								std::map<std::string, double>& constants,
+								std::vector<stmt_with_info>& result)
+{
+	for (size_t index = begin; index < end; ++index) {
+		const auto& token_vec = std::get<0>(src_file[index]);
+		const auto category = std::get<1>(src_file[index]);
+		const int line = std::get<2>(src_file[index]);
+		bool is_constant = false;
+		double value = 0;
+		switch (category) {
+			case TokenCategory::SingleForStatement:
+			case TokenCategory::DoubleForStatement:
+			{
+				const size_t loop_end = std::min(loop_analyzer.loop_end(src_file, index),
+												 end);
+				for (size_t i = index; i < loop_end; ++i) {
+					const auto& body_vec = std::get<0>(src_file[i]);
+					switch (std::get<1>(src_file[i])) {
+						case TokenCategory::DoubleForStatement:
+							constants.erase(body_vec.at(4).value());
+							constants.erase(body_vec.at(2).value());
+							break;
+						case TokenCategory::SingleForStatement:
+							constants.erase(body_vec.at(2).value());
+							break;
+						case TokenCategory::ScalarDeclaration:
+							constants.erase(body_vec.at(1).value());
+							break;
+						case TokenCategory::ExprAssignment:
+							constants.erase(body_vec.at(0).value());
+							break;
+						default:
+							break;
+					}
+				}
+				result.emplace_back(fold_statement(token_vec, constants, is_constant,
+												   value), category, line);
+				std::map<std::string, double> body_constants = constants;
+				fold_range(src_file, index + 1, loop_end, body_constants, result);
+				if (loop_end < end) {
+					result.push_back(src_file[loop_end]);
+				}
+				index = loop_end;
+				break;
+			}
+			case TokenCategory::ScalarDeclaration:
+				constants.erase(token_vec.at(1).value());
+				result.push_back(src_file[index]);
+				break;
+			case TokenCategory::ExprAssignment:
+			{
+				const auto folded = fold_statement(token_vec, constants, is_constant,
+												   value);
+				const std::string name = token_vec.at(0).value();
+				std::vector<Token> tokens;
+				//the scalar is a double even if the constant is an int
+				if (is_constant && constant_tokens(value, false, tokens) &&
+					sym_table->lookup(name).type() == VariableType::Scalar)
+				{
+					constants[name] = value;
+				} else {
+					constants.erase(name);
+				}
+				result.emplace_back(folded, category, line);
+				break;
+			}
+			default:
+				result.emplace_back(fold_statement(token_vec, constants, is_constant,
+												   value), category, line);
+				break;
+		}
+	}
+}
+
+std::vector<Token> ConstantFolder::fold_statement(const std::vector<Token>& token_vec,
+								const std::map<std::string, double>& constants,
+								bool& is_constant, double& value)
+{
+	std::vector<Token> result;
+	for (size_t i = 0; i < token_vec.size(); ++i) {
+		result.push_back(token_vec[i]);
+		if (token_vec[i].category() != TokenCategory::ExpressionBegin) {
+			continue;
+		}
+		size_t end = i + 1;
+		while (token_vec.at(end).category() != TokenCategory::ExpressionEnd)
+			++end;
+		const Operand operand = fold_expression(token_vec, token_range(i + 1, end),
+												constants);
+		result.insert(result.end(), operand.tokens.begin(), operand.tokens.end());
+		result.push_back(token_vec[end]);
+		is_constant = operand.constant;
+		value = operand.value;
+		i = end;
+	}
+	return result;
+}
+
+/** Folds the postfix expression in range bottom up. An operation is folded
+  * when all of its operands are constants.
+  */
+ConstantFolder::Operand ConstantFolder::fold_expression(const std::vector<Token>& token_vec,
+								const token_range& range,
+								const std::map<std::string, double>& constants)
+{
+	std::vector<Operand> stack;
+	for (size_t i = range.first; i < range.second; ++i) {
+		const Token& token = token_vec[i];
+		Operand operand{{token}, VariableType::Scalar, Dimensions(1, 1), false, 0,
+						false, {}};
+		switch (token.category()) {
+			case TokenCategory::Integer:
+			case TokenCategory::Real:
+				evaluate(operand, token.category() == TokenCategory::Integer);
+				break;
+			case TokenCategory::Identifier:
+			{
+				const Variable var = sym_table->lookup(token.value());
+				operand.type = var.type();
+				operand.dim = var.dim();
+				size_t next = i + 1;
+				while (next < range.second && token_vec[next].category() ==
+											  TokenCategory::OpenSquareBrackets)
+				{
+					const size_t close = matching_bracket(token_vec, next,
+							TokenCategory::OpenSquareBrackets,
+							TokenCategory::CloseSquareBrackets);
+					//keep the "1 -" making the index 0 based
+					size_t index_end = close;
+					if (close - next > 3 &&
+						token_vec[close - 1].category() == TokenCategory::SubtractionOperator &&
+						token_vec[close - 2].value() == "1")
+					{
+						index_end = close - 2;
+					}
+					const Operand index = fold_expression(token_vec,
+							token_range(next + 1, index_end), constants);
+					operand.tokens.push_back(token_vec[next]);
+					operand.tokens.insert(operand.tokens.end(), index.tokens.begin(),
+										  index.tokens.end());
+					operand.tokens.insert(operand.tokens.end(),
+										  token_vec.begin() + static_cast<long>(index_end),
+										  token_vec.begin() + static_cast<long>(close + 1));
+					next = close + 1;
+				}
+				const auto constant = constants.find(token.value());
+				if (next != i + 1) {
+					operand.type = VariableType::Scalar;
+					operand.dim = Dimensions(1, 1);
+					i = next - 1;
+				} else if (constant != constants.end()) {
+					operand.tokens.clear();
+					constant_tokens(constant->second, false, operand.tokens);
+					evaluate(operand, false);
+				}
+				break;
+			}
+			case TokenCategory::TrFunction:
+			case TokenCategory::SqrtFunction:
+			case TokenCategory::ChooseFunction:
+			{
+				//f ( <arg> , <arg> ... )
+				const size_t close = matching_bracket(token_vec, i + 1,
+													  TokenCategory::OpenParenthesis,
+													  TokenCategory::CloseParenthesis);
+				operand.tokens.push_back(token_vec[i + 1]);
+				std::vector<Operand> args;
+				size_t arg_begin = i + 2;
+				int depth = 0;
+				for (size_t j = arg_begin; j <= close; ++j) {
+					const TokenCategory category = token_vec[j].category();
+					if (category == TokenCategory::OpenParenthesis ||
+						category == TokenCategory::OpenSquareBrackets)
+					{
+						++depth;
+					} else if ((category == TokenCategory::CloseParenthesis ||
+								category == TokenCategory::CloseSquareBrackets) &&
+							   j != close)
+					{
+						--depth;
+					} else if (depth == 0 && (category == TokenCategory::Comma ||
+											  j == close))
+					{
+						args.push_back(fold_expression(token_vec,
+								token_range(arg_begin, j), constants));
+						operand.tokens.insert(operand.tokens.end(),
+											  args.back().tokens.begin(),
+											  args.back().tokens.end());
+						operand.tokens.push_back(token_vec[j]);
+						arg_begin = j + 1;
+					}
+				}
+				bool all_constant = true;
+				for (const auto& arg : args)
+					all_constant = all_constant && arg.constant;
+				if (token.category() == TokenCategory::TrFunction && !args.empty()) {
+					operand.type = args[0].type;
+					operand.dim = Dimensions(args[0].dim.cols, args[0].dim.rows);
+				}
+				if (all_constant && !args.empty()) {
+					//sqrt and choose return doubles
+					evaluate(operand, token.category() == TokenCategory::TrFunction &&
+									  args[0].integral);
+				}
+				i = close;
+				break;
+			}
+			case TokenCategory::AdditionOperator:
+			case TokenCategory::SubtractionOperator:
+			case TokenCategory::MultiplicationOperator:
+			{
+				if (stack.size() < 2) {
+					//let the code generator report it
+					return Operand{std::vector<Token>(token_vec.begin() + static_cast<long>(range.first),
+													  token_vec.begin() + static_cast<long>(range.second)),
+								   VariableType::Scalar, Dimensions(1, 1), false, 0,
+								   false, {}};
+				}
+				const Operand right = stack.back();
+				stack.pop_back();
+				const Operand left = stack.back();
+				stack.pop_back();
+				operand.tokens = left.tokens;
+				operand.tokens.insert(operand.tokens.end(), right.tokens.begin(),
+									  right.tokens.end());
+				operand.tokens.push_back(token);
+				if (left.type == VariableType::Matrix && right.type == VariableType::Matrix) {
+					if (token.category() == TokenCategory::MultiplicationOperator) {
+						operand.dim = Dimensions(left.dim.rows, right.dim.cols);
+						//(1xN) (Nx1) is a scalar
+						operand.type = (operand.dim.rows == 1 && operand.dim.cols == 1)
+										   ? VariableType::Scalar
+										   : VariableType::Matrix;
+					} else {
+						operand.type = VariableType::Matrix;
+						operand.dim = left.dim;
+					}
+				} else if (left.type == VariableType::Matrix) {
+					operand.type = VariableType::Matrix;
+					operand.dim = left.dim;
+				} else if (right.type == VariableType::Matrix) {
+					operand.type = VariableType::Matrix;
+					operand.dim = right.dim;
+				}
+				if (left.constant && right.constant) {
+					evaluate(operand, left.integral && right.integral);
+				} else if (token.category() == TokenCategory::AdditionOperator &&
+						   !right.negated.empty() && right.constant)
+				{
+					//a + (0 - c) => a - c. The result is the same for a
+					//nonzero constant. Matrices are still negated since
+					//a - b and a + (-b) give NaNs of different signs.
+					operand.tokens = left.tokens;
+					operand.tokens.insert(operand.tokens.end(), right.negated.begin(),
+										  right.negated.end());
+					operand.tokens.emplace_back("-", TokenCategory::SubtractionOperator);
+				}
+				break;
+			}
+			default:
+				break;
+		}
+		stack.push_back(operand);
+	}
+	if (stack.size() != 1) {
+		//let the code generator report it
+		return Operand{std::vector<Token>(token_vec.begin() + static_cast<long>(range.first),
+										  token_vec.begin() + static_cast<long>(range.second)),
+					   VariableType::Scalar, Dimensions(1, 1), false, 0, false, {}};
+	}
+	return stack.back();
+}
+
+/** Single literals are kept as they are written. Other constants are
+  * replaced with the tokens of their value.
+  */
+void ConstantFolder::evaluate(Operand& operand, bool integral)
+{
+	if (operand.type != VariableType::Scalar) {
+		return;
+	}
+	double value = 0;
+	Evaluator evaluator(sym_table, EvalBudget{1000000, 1 << 20});
+	if (!evaluator.constant(operand.tokens, token_range(0, operand.tokens.size()),
+							value))
+	{
+		return;
+	}
+	std::vector<Token> tokens;
+	if (!constant_tokens(value, integral, tokens)) {
+		return;
+	}
+	if (operand.tokens.size() != 1) {
+		operand.tokens = tokens;
+	}
+	operand.constant = true;
+	operand.value = value;
+	operand.integral = integral;
+	if (operand.tokens.size() == 3) {
+		//0 <c> -
+		operand.negated.assign(1, operand.tokens[1]);
+	}
+}
+
+/** Non negative constants are a single Integer or Real token. Reals always
+  * have a dot or an exponent so that C doesn't read them as ints. Negative
+  * constants are 0 <c> -. Infinities, NaNs and negative zero have no tokens.
+  */
+bool ConstantFolder::constant_tokens(double value, bool integral,
+									 std::vector<Token>& tokens) const
+{
+	if (!std::isfinite(value) || (std::signbit(value) && !(value < 0))) {
+		return false;
+	}
+	if (value < 0) {
+		tokens.emplace_back("0", TokenCategory::Integer);
+		constant_tokens(-value, integral, tokens);
+		tokens.emplace_back("-", TokenCategory::SubtractionOperator);
+		return true;
+	}
+	std::string text = c_literal(value);
+	if (!integral && text.find_first_of(".e") == std::string::npos) {
+		text += ".0";
+	}
+	tokens.emplace_back(text, integral ? TokenCategory::Integer
+									   : TokenCategory::Real);
+	return true;
+}
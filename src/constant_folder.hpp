@@ -0,0 +1,64 @@
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include "token.hpp"
+#include "symbol_table.hpp"
+#include "definitions.hpp"
+#include "dataflow.hpp"
+#include "evaluator.hpp"
+#include "loop_analyzer.hpp"
+
+/** Folds the constant subexpressions of the postfix expressions of a program
+  * and propagates the scalars holding a known constant into the expressions
+  * reading them, loop bounds included.
+  *
+  * Constants are computed by the Evaluator, thus they are the values the C
+  * program would compute. Negative constants are written as 0 <c> - since
+  * tokens have no sign. A constant that is not finite, is a negative zero or
+  * can't be evaluated (e.g. an int overflow) is left as it is.
+  *
+  * The negation idiom of the parser, a - b => a 0 b - +, is turned back into
+  * a b - when b is a negative constant.
+  */
+class ConstantFolder {
+public:
+	//Takes a ptr to sym_table to get the types of the variables
+	ConstantFolder(const SymbolTable* const sym_table_ptr)
+		: sym_table(sym_table_ptr)
+		, loop_analyzer(sym_table_ptr)
+	{ };
+	//returns the program with folded expressions
+	std::vector<stmt_with_info> fold(const std::vector<stmt_with_info>& src_file);
+private:
+	//a folded subexpression
+	struct Operand {
+		std::vector<Token> tokens;
+		VariableType type;
+		Dimensions dim;
+		bool constant;
+		double value;
+		//true if the value has C type int
+		bool integral;
+		//c of a negative constant 0 <c> -
+		std::vector<Token> negated;
+	};
+	//folds the statements in [begin, end) with the known scalar constants
+	void fold_range(const std::vector<stmt_with_info>& src_file, size_t begin,
+					size_t end, std::map<std::string, double>& constants,
+					std::vector<stmt_with_info>& result);
+	//folds every expression of the statement
+	std::vector<Token> fold_statement(const std::vector<Token>& token_vec,
+									  const std::map<std::string, double>& constants,
+									  bool& is_constant, double& value);
+	Operand fold_expression(const std::vector<Token>& token_vec,
+							const token_range& range,
+							const std::map<std::string, double>& constants);
+	//sets the operand to the value of its tokens if they can be evaluated
+	void evaluate(Operand& operand, bool integral);
+	//returns the tokens of a constant. Returns false if it has no tokens.
+	bool constant_tokens(double value, bool integral, std::vector<Token>& tokens) const;
+private:
+	const SymbolTable* const sym_table;
+	LoopAnalyzer loop_analyzer;
+};
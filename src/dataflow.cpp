@@ -0,0 +1,232 @@
+#include "dataflow.hpp"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <stdexcept>
+
+/** Returns the [begin, end) ranges of all expressions in a statement. Each
+  * range excludes the ExpressionBegin and ExpressionEnd anchors.
+  */
+std::vector<token_range> expression_ranges(const std::vector<Token>& token_vec)
+{
+	std::vector<token_range> ranges;
+	for (size_t i = 0; i < token_vec.size(); ++i) {
+		if (token_vec[i].category() == TokenCategory::ExpressionBegin) {
+			size_t end = i + 1;
+			while (token_vec.at(end).category() != TokenCategory::ExpressionEnd)
+				++end;
+			ranges.emplace_back(i + 1, end);
+			i = end;
+		}
+	}
+	return ranges;
+}
+
+/** Returns the index of the bracket closing the bracket at the given index.
+  */
+size_t matching_bracket(const std::vector<Token>& token_vec, size_t index,
+						const TokenCategory& open, const TokenCategory& close)
+{
+	int depth = 0;
+	for (; index < token_vec.size(); ++index) {
+		if (token_vec[index].category() == open) {
+			++depth;
+		} else if (token_vec[index].category() == close && --depth == 0) {
+			return index;
+		}
+	}
+	throw std::runtime_error("Unmatched bracket");
+}
+
+std::string join_tokens(const std::vector<Token>& token_vec,
+						size_t begin, size_t end)
+{
+	std::string result;
+	for (size_t i = begin; i < end; ++i) {
+		if (i != begin)
+			result += " ";
+		result += token_vec[i].value();
+	}
+	return result;
+}
+
+/** Turns the postfix tokens inside a subscript of an expression into a key
+  * that is comparable with the subscripts of assignment statements.
+  *
+  * Parser appends "1 -" to each index to make it 0 based and puts a constant
+  * 0 as the second index of single subscripts.
+  */
+std::string subscript_key(const std::vector<Token>& token_vec,
+						  size_t begin, size_t end)
+{
+	if (end - begin >= 2 &&
+		token_vec[end - 1].category() == TokenCategory::SubtractionOperator &&
+		token_vec[end - 2].value() == "1")
+	{
+		return join_tokens(token_vec, begin, end - 2);
+	}
+	//single subscript
+	return "1";
+}
+
+/** Appends the accesses of all identifiers in the given postfix expression
+  * to the accesses vector. Identifiers inside subscripts are accesses as well.
+  */
+void collect_reads(const std::vector<Token>& token_vec, const token_range& range,
+				   std::vector<Access>& accesses)
+{
+	for (size_t i = range.first; i < range.second; ++i) {
+		if (token_vec[i].category() != TokenCategory::Identifier) {
+			continue;
+		}
+		Access access{token_vec[i].value(), {}, false};
+		size_t j = i + 1;
+		while (j < range.second &&
+			   token_vec[j].category() == TokenCategory::OpenSquareBrackets)
+		{
+			const size_t close = matching_bracket(token_vec, j,
+					TokenCategory::OpenSquareBrackets,
+					TokenCategory::CloseSquareBrackets);
+			access.keys.push_back(subscript_key(token_vec, j + 1, close));
+			j = close + 1;
+		}
+		accesses.push_back(access);
+	}
+}
+
+/** Returns how many values the postfix expression between [begin, end) leaves
+  * on the evaluation stack. A complete expression leaves exactly one value.
+  */
+int stack_effect(const std::vector<Token>& token_vec, size_t begin, size_t end)
+{
+	int depth = 0;
+	for (size_t i = begin; i < end; ++i) {
+		switch (token_vec[i].category()) {
+			case TokenCategory::Identifier:
+			case TokenCategory::Integer:
+			case TokenCategory::Real:
+				++depth;
+				break;
+			//a function call is a single value. Skip its arguments
+			case TokenCategory::TrFunction:
+			case TokenCategory::SqrtFunction:
+			case TokenCategory::ChooseFunction:
+				++depth;
+				i = matching_bracket(token_vec, i + 1,
+									 TokenCategory::OpenParenthesis,
+									 TokenCategory::CloseParenthesis);
+				break;
+			//subscripts belong to the identifier before them
+			case TokenCategory::OpenSquareBrackets:
+				i = matching_bracket(token_vec, i,
+									 TokenCategory::OpenSquareBrackets,
+									 TokenCategory::CloseSquareBrackets);
+				break;
+			case TokenCategory::AdditionOperator:
+			case TokenCategory::SubtractionOperator:
+			case TokenCategory::MultiplicationOperator:
+				--depth;
+				break;
+			default:
+				break;
+		}
+	}
+	return depth;
+}
+
+/** Appends the accesses of an assignment statement to accesses. Reads of
+  * the indices and the right hand side come before the write.
+  *
+  * Assignments to a subscript keep the index expressions as keys of the write.
+  * Returns false for the statements that are not assignments.
+  */
+bool collect_statement_accesses(const stmt_with_info& stmt,
+								std::vector<Access>& accesses)
+{
+	const auto& token_vec = std::get<0>(stmt);
+	const auto ranges = expression_ranges(token_vec);
+	switch (std::get<1>(stmt)) {
+		case TokenCategory::ExprAssignment:
+		case TokenCategory::ListAssignment:
+			for (const auto& range : ranges)
+				collect_reads(token_vec, range, accesses);
+			accesses.push_back(Access{token_vec.at(0).value(), {}, true});
+			return true;
+		case TokenCategory::SingleSubscriptExprAssignment:
+		case TokenCategory::DoubleSubscriptExprAssignment:
+		{
+			//every range but the last one is an index
+			Access write{token_vec.at(0).value(), {}, true};
+			for (const auto& range : ranges)
+				collect_reads(token_vec, range, accesses);
+			for (size_t i = 0; i + 1 < ranges.size(); ++i) {
+				write.keys.push_back(join_tokens(token_vec, ranges[i].first,
+												 ranges[i].second));
+			}
+			if (write.keys.size() == 1)
+				write.keys.push_back("1");
+			accesses.push_back(write);
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+/** Every write depends on the last write and the reads since then, and every
+  * read depends on the last write of the variable. The rest of the
+  * dependences follow from these transitively.
+  *
+  * Statements are then put on levels: a statement is one level after the
+  * deepest statement it depends on. Statements on the same level are
+  * independent. A region is worth running in parallel if a level contains at
+  * least two heavy statements, that is, statements working on whole matrices.
+  */
+TaskRegion DataflowAnalyzer::task_region(const std::vector<stmt_with_info>& src_file,
+										 size_t begin) const
+{
+	TaskRegion region(begin);
+	std::map<std::string, size_t> last_writer;
+	std::map<std::string, std::vector<size_t>> readers;
+	std::vector<size_t> levels;
+	std::map<size_t, int> heavy_count; //level -> number of heavy statements
+	for (size_t i = 0; begin + i < src_file.size(); ++i) {
+		std::vector<Access> accesses;
+		if (!collect_statement_accesses(src_file[begin + i], accesses))
+			break;
+		std::set<size_t> predecessors;
+		bool heavy = false;
+		for (const auto& access : accesses) {
+			const auto writer = last_writer.find(access.name);
+			if (writer != last_writer.end())
+				predecessors.insert(writer->second);
+			if (access.write) {
+				for (const auto reader : readers[access.name]) {
+					if (reader != i)
+						predecessors.insert(reader);
+				}
+			} else if (access.keys.empty() &&
+					   sym_table->lookup(access.name).type() == VariableType::Matrix)
+			{
+				heavy = true;
+			}
+		}
+		for (const auto& access : accesses) {
+			if (access.write) {
+				last_writer[access.name] = i;
+				readers[access.name].clear();
+			} else {
+				readers[access.name].push_back(i);
+			}
+		}
+		size_t level = 0;
+		for (const auto predecessor : predecessors)
+			level = std::max(level, levels[predecessor] + 1);
+		levels.push_back(level);
+		if (heavy && ++heavy_count[level] == 2)
+			region.parallel = true;
+		region.predecessors.emplace_back(predecessors.begin(), predecessors.end());
+		region.end = begin + i + 1;
+	}
+	return region;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+#include "token.hpp"
+#include "symbol_table.hpp"
+#include "definitions.hpp"
+
+// Helpers that find which variables the statements of a program read and
+// write. Used by the analyses that decide which parts of a program can run
+// in parallel.
+
+/** A single access to a variable. Subscripted accesses keep the index
+  * expressions of their subscripts as keys so that two accesses to the same
+  * matrix can be compared. Single subscripts have "1" as their second key.
+  */
+struct Access {
+	std::string name;
+	std::vector<std::string> keys;
+	bool write;
+};
+
+typedef std::pair<size_t, size_t> token_range;
+
+//returns the [begin, end) ranges of all expressions in a statement
+std::vector<token_range> expression_ranges(const std::vector<Token>& token_vec);
+//returns the index of the bracket closing the bracket at the given index
+size_t matching_bracket(const std::vector<Token>& token_vec, size_t index,
+						const TokenCategory& open, const TokenCategory& close);
+//joins the values of the tokens in [begin, end) with spaces
+std::string join_tokens(const std::vector<Token>& token_vec,
+						size_t begin, size_t end);
+//appends the accesses of the identifiers in the given postfix expression
+void collect_reads(const std::vector<Token>& token_vec, const token_range& range,
+				   std::vector<Access>& accesses);
+//appends the accesses of an assignment statement in the order they happen.
+//Returns false if the statement is not an assignment.
+bool collect_statement_accesses(const stmt_with_info& stmt,
+								std::vector<Access>& accesses);
+//returns how many values the postfix expression in [begin, end) leaves on
+//the evaluation stack
+int stack_effect(const std::vector<Token>& token_vec, size_t begin, size_t end);
+
+/** Dependency DAG of a region of consecutive top level assignments.
+  * Statement i of the region is src_file[begin + i].
+  */
+struct TaskRegion {
+	size_t begin;
+	size_t end;
+	//predecessors[i] are the statements that must finish before statement i
+	std::vector<std::vector<size_t>> predecessors;
+	//true if at least two heavy matrix statements of the region are
+	//independent of each other
+	bool parallel;
+	TaskRegion(size_t t_begin)
+		: begin(t_begin)
+		, end(t_begin)
+		, predecessors()
+		, parallel(false)
+	{};
+};
+
+/** Builds the dependency DAG of the statements of a program.
+  *
+  * Two statements depend on each other if one of them writes a variable the
+  * other one reads or writes. Subscripts are not taken into account. Thus,
+  * writing to different elements of a matrix is still a dependence.
+  */
+class DataflowAnalyzer {
+public:
+	//Takes a ptr to sym_table to get the types of the variables
+	DataflowAnalyzer(const SymbolTable* const sym_table_ptr)
+		: sym_table(sym_table_ptr)
+	{ };
+	//builds the DAG of the assignments starting at src_file[begin]. The region
+	//ends at the first statement that is not an assignment.
+	TaskRegion task_region(const std::vector<stmt_with_info>& src_file,
+						   size_t begin) const;
+private:
+	const SymbolTable* const sym_table;
+};
@@ -0,0 +1,146 @@
+#include "dead_code_eliminator.hpp"
+#include <algorithm>
+
+std::vector<stmt_with_info> DeadCodeEliminator::eliminate(const std::vector<stmt_with_info>& src_file) const
+{
+	std::vector<bool> dead(src_file.size(), false);
+	//nothing is live at the end of the program
+	std::set<std::string> live;
+	analyze_range(src_file, 0, src_file.size(), live, dead);
+	std::vector<stmt_with_info> result;
+	for (size_t i = 0; i < src_file.size(); ++i) {
+		if (!dead[i])
+			result.push_back(src_file[i]);
+	}
+	return result;
+}
+
+/** Loops are analyzed as a whole. Thus, the statements are first grouped into
+  * loops and single statements and then analyzed from the last one.
+  */
+void DeadCodeEliminator::analyze_range(const std::vector<stmt_with_info>& src_file,
+									   size_t begin, size_t end,
+									   std::set<std::string>& live,
+									   std::vector<bool>& dead) const
+{
+	std::vector<token_range> units;
+	for (size_t i = begin; i < end; ++i) {
+		const auto category = std::get<1>(src_file[i]);
+		if (category == TokenCategory::SingleForStatement ||
+			category == TokenCategory::DoubleForStatement)
+		{
+			const size_t loop_end = std::min(loop_analyzer.loop_end(src_file, i), end);
+			units.emplace_back(i, loop_end);
+			i = loop_end;
+		} else {
+			units.emplace_back(i, i);
+		}
+	}
+	for (auto unit = units.rbegin(); unit != units.rend(); ++unit) {
+		const auto category = std::get<1>(src_file[unit->first]);
+		if (category == TokenCategory::SingleForStatement ||
+			category == TokenCategory::DoubleForStatement)
+		{
+			analyze_loop(src_file, unit->first, unit->second, live, dead);
+		} else {
+			dead[unit->first] = analyze_statement(src_file[unit->first], live);
+		}
+	}
+}
+
+/** The body may run any number of times. Thus, the variables live at the end
+  * of the body are the ones live after the loop, the ones read by the loop
+  * header and the ones live at the beginning of the body. The last one is
+  * found by analyzing the body until the set doesn't grow.
+  *
+  * The loop header always assigns the loop variables before the body and the
+  * loop condition reads them after every iteration.
+  */
+void DeadCodeEliminator::analyze_loop(const std::vector<stmt_with_info>& src_file,
+									  size_t index, size_t end,
+									  std::set<std::string>& live,
+									  std::vector<bool>& dead) const
+{
+	const auto& token_vec = std::get<0>(src_file[index]);
+	std::vector<Access> accesses;
+	for (const auto& range : expression_ranges(token_vec))
+		collect_reads(token_vec, range, accesses);
+	std::set<std::string> loop_vars{token_vec.at(2).value()};
+	if (std::get<1>(src_file[index]) == TokenCategory::DoubleForStatement) {
+		loop_vars.insert(token_vec.at(4).value());
+	}
+	std::set<std::string> body_out = live;
+	body_out.insert(loop_vars.begin(), loop_vars.end());
+	for (const auto& access : accesses)
+		body_out.insert(access.name);
+	std::set<std::string> body_in;
+	while (true) {
+		body_in = body_out;
+		analyze_range(src_file, index + 1, end, body_in, dead);
+		const size_t size = body_out.size();
+		body_out.insert(body_in.begin(), body_in.end());
+		if (body_out.size() == size)
+			break;
+	}
+	//end is the closing brace unless the loop is not closed
+	const bool closed = end < src_file.size() &&
+						loop_analyzer.loop_end(src_file, index) == end;
+	bool removable = std::all_of(dead.begin() + static_cast<long>(index + 1),
+								 dead.begin() + static_cast<long>(end),
+								 [](bool stmt_dead) { return stmt_dead; });
+	for (const auto& var : loop_vars)
+		removable = removable && live.count(var) == 0;
+	dead[index] = removable;
+	if (closed) {
+		dead[end] = removable;
+	}
+	if (removable) {
+		return;
+	}
+	live.insert(body_in.begin(), body_in.end());
+	for (const auto& var : loop_vars)
+		live.erase(var);
+	for (const auto& access : accesses)
+		live.insert(access.name);
+}
+
+/** An assignment is dead if the variable it writes is not live. Otherwise,
+  * the variable is live before the assignment only if the assignment writes a
+  * single element of it.
+  */
+bool DeadCodeEliminator::analyze_statement(const stmt_with_info& stmt,
+										   std::set<std::string>& live) const
+{
+	const auto& token_vec = std::get<0>(stmt);
+	std::vector<Access> accesses;
+	switch (std::get<1>(stmt)) {
+		case TokenCategory::PrintStatement:
+			for (const auto& range : expression_ranges(token_vec))
+				collect_reads(token_vec, range, accesses);
+			for (const auto& access : accesses)
+				live.insert(access.name);
+			return false;
+		case TokenCategory::LoadStatement:
+			//kept since it exits the program if the file can't be read
+			live.erase(token_vec.at(2).value());
+			return false;
+		default:
+			break;
+	}
+	if (!collect_statement_accesses(stmt, accesses)) {
+		return false;
+	}
+	//the write is the last access
+	const Access& write = accesses.back();
+	if (live.count(write.name) == 0) {
+		return true;
+	}
+	if (write.keys.empty()) {
+		live.erase(write.name);
+	}
+	for (const auto& access : accesses) {
+		if (!access.write)
+			live.insert(access.name);
+	}
+	return false;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <set>
+#include <string>
+#include <vector>
+#include "token.hpp"
+#include "symbol_table.hpp"
+#include "definitions.hpp"
+#include "dataflow.hpp"
+#include "loop_analyzer.hpp"
+
+/** Removes the statements whose results never reach a print statement.
+  *
+  * A backward liveness analysis finds the variables whose current values may
+  * still be printed. An assignment to a variable that is not live is dead.
+  * Assignments to a whole variable kill it, assignments to a subscript don't.
+  * Liveness of a loop body is iterated until it doesn't change, since the
+  * values written in an iteration may be read by the next one. A loop is
+  * removed when its whole body is dead and its loop variables are not read
+  * after it.
+  *
+  * Print, printsep, load and declaration statements are always kept.
+  */
+class DeadCodeEliminator {
+public:
+	//Takes a ptr to sym_table to find the ends of the loops
+	DeadCodeEliminator(const SymbolTable* const sym_table_ptr)
+		: loop_analyzer(sym_table_ptr)
+	{ };
+	//returns the program without the dead statements
+	std::vector<stmt_with_info> eliminate(const std::vector<stmt_with_info>& src_file) const;
+private:
+	//updates live from the variables live after src_file[end - 1] to the ones
+	//live before src_file[begin] and marks the dead statements in between
+	void analyze_range(const std::vector<stmt_with_info>& src_file, size_t begin,
+					   size_t end, std::set<std::string>& live,
+					   std::vector<bool>& dead) const;
+	void analyze_loop(const std::vector<stmt_with_info>& src_file, size_t index,
+					  size_t end, std::set<std::string>& live,
+					  std::vector<bool>& dead) const;
+	//returns true if the statement is dead
+	bool analyze_statement(const stmt_with_info& stmt,
+						   std::set<std::string>& live) const;
+private:
+	LoopAnalyzer loop_analyzer;
+};
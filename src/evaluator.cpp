@@ -0,0 +1,565 @@
+#include "evaluator.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+/** Writes the value with 17 significant digits which is enough to read back
+  * the same double. Negative zero, infinities and NaNs are written with the
+  * macros of math.h.
+  */
+std::string c_literal(double value)
+{
+	if (std::isnan(value)) {
+		return std::signbit(value) ? "(-NAN)" : "NAN";
+	}
+	if (std::isinf(value)) {
+		return std::signbit(value) ? "(-INFINITY)" : "INFINITY";
+	}
+	std::ostringstream oss;
+	oss.precision(17);
+	oss << value;
+	//-0 would be the int 0
+	if (std::signbit(value) && oss.str() == "-0") {
+		return "-0.0";
+	}
+	return oss.str();
+}
+
+/** Converts a scalar to int as a C cast does. Conversion of a value out of
+  * the range of int is undefined.
+  */
+int to_int(double value)
+{
+	if (!(value > INT_MIN - 1.0 && value < INT_MAX + 1.0)) {
+		throw std::runtime_error("Conversion to int out of range");
+	}
+	return static_cast<int>(value);
+}
+
+EvalResult Evaluator::run(const std::vector<stmt_with_info>& src_file)
+{
+	EvalResult result;
+	size_t index = 0;
+	while (index < src_file.size()) {
+		const auto category = std::get<1>(src_file[index]);
+		size_t next = index + 1;
+		//a for loop is evaluated as a whole
+		if (category == TokenCategory::SingleForStatement ||
+			category == TokenCategory::DoubleForStatement)
+		{
+			next = std::min(loop_analyzer.loop_end(src_file, index) + 1,
+							src_file.size());
+		}
+		saved.clear();
+		const size_t output_size = output.size();
+		const long memory_before = memory;
+		try {
+			execute(src_file, index, next);
+		} catch (const std::runtime_error& e) {
+			//undo the statement
+			for (auto& name_storage : saved) {
+				variables[name_storage.first] = std::move(name_storage.second);
+			}
+			output.erase(output.begin() + static_cast<long>(output_size),
+						 output.end());
+			memory = memory_before;
+			result.stop_line = std::get<2>(src_file[index]);
+			result.stop_reason = e.what();
+			break;
+		}
+		index = next;
+	}
+	result.end = index;
+	result.output = output;
+	for (const auto& name_storage : variables) {
+		const auto& defined = name_storage.second.defined;
+		if (std::find(defined.begin(), defined.end(), true) != defined.end()) {
+			result.values[name_storage.first] = name_storage.second.data;
+		}
+	}
+	return result;
+}
+
+bool Evaluator::constant(const std::vector<Token>& token_vec,
+						 const token_range& range, double& value)
+{
+	try {
+		const Value result = evaluate(token_vec, range);
+		if (result.type != VariableType::Scalar) {
+			return false;
+		}
+		value = result.data[0];
+		return true;
+	} catch (const std::runtime_error&) {
+		return false;
+	}
+}
+
+void Evaluator::charge(long count)
+{
+	operations += count;
+	if (operations > budget.operations) {
+		throw std::runtime_error("Operation budget exceeded");
+	}
+}
+
+/** Checks if count more doubles fit in the memory budget. Temporary values
+  * are only checked, the others are added to the used memory by the caller.
+  */
+void Evaluator::allocate(long count)
+{
+	if (memory + count * static_cast<long>(sizeof(double)) > budget.memory) {
+		throw std::runtime_error("Memory budget exceeded");
+	}
+}
+
+void Evaluator::execute(const std::vector<stmt_with_info>& src_file,
+						size_t begin, size_t end)
+{
+	for (size_t index = begin; index < end; ++index) {
+		const auto& token_vec = std::get<0>(src_file[index]);
+		const auto category = std::get<1>(src_file[index]);
+		charge(1);
+		switch (category) {
+			case TokenCategory::ScalarDeclaration:
+			case TokenCategory::VectorDeclaration:
+			case TokenCategory::MatrixDeclaration:
+			{
+				//a declaration in a loop body is a new uninitialized variable
+				//in each iteration
+				const std::string name = token_vec.at(1).value();
+				const Dimensions dim = sym_table->lookup(name).dim();
+				const size_t size = static_cast<size_t>(dim.rows) *
+									static_cast<size_t>(dim.cols);
+				if (variables.count(name) == 0) {
+					allocate(static_cast<long>(size));
+					memory += static_cast<long>(size * sizeof(double));
+				}
+				Storage& storage = modify(name);
+				storage.data.assign(size, 0);
+				storage.defined.assign(size, false);
+				break;
+			}
+			case TokenCategory::SingleForStatement:
+			case TokenCategory::DoubleForStatement:
+			{
+				const size_t loop_end = std::min(loop_analyzer.loop_end(src_file, index),
+												 src_file.size());
+				execute_for(src_file, index, loop_end, 0);
+				index = loop_end;
+				break;
+			}
+			case TokenCategory::PrintStatement:
+			{
+				const Value value = evaluate(token_vec,
+											 expression_ranges(token_vec).at(0));
+				allocate(static_cast<long>(value.data.size()));
+				memory += static_cast<long>(value.data.size() * sizeof(double));
+				output.push_back(PrintedValue{category, value.type,
+											  Dimensions(value.rows, value.cols),
+											  value.data});
+				break;
+			}
+			case TokenCategory::PrintSepStatement:
+				output.push_back(PrintedValue{category, VariableType::Scalar,
+											  Dimensions(0, 0), {}});
+				break;
+			case TokenCategory::ExprAssignment:
+			case TokenCategory::SingleSubscriptExprAssignment:
+			case TokenCategory::DoubleSubscriptExprAssignment:
+			case TokenCategory::ListAssignment:
+				assign(token_vec, category);
+				break;
+			case TokenCategory::LoadStatement:
+				throw std::runtime_error("Load statement reads a file at runtime");
+			default:
+				throw std::runtime_error("Unexpected statement");
+		}
+	}
+}
+
+/** Runs the loop of the given depth as its C for statement:
+  *
+  *	for (i = <expr1>; i < <expr2> + 1; i += <expr3>)
+  *
+  * The bound and the step are evaluated again in each iteration. Depth 1 is
+  * the inner loop of a double for statement.
+  */
+void Evaluator::execute_for(const std::vector<stmt_with_info>& src_file,
+							size_t index, size_t end, size_t depth)
+{
+	const auto& token_vec = std::get<0>(src_file[index]);
+	const bool is_double =
+		std::get<1>(src_file[index]) == TokenCategory::DoubleForStatement;
+	const auto ranges = expression_ranges(token_vec);
+	//	0   1 2  3  4
+	// for ( i in ...		OR		for ( i , j in ...
+	const std::string name = token_vec.at(2 + 2 * depth).value();
+	const size_t first = 3 * depth;
+	const Value one{VariableType::Scalar, 1, 1, {1}, true};
+	double value = evaluate_scalar(token_vec, ranges.at(first));
+	while (true) {
+		Storage& storage = modify(name);
+		storage.data.at(0) = value;
+		storage.defined.at(0) = true;
+		charge(1);
+		const Value bound = binary_operation(TokenCategory::AdditionOperator,
+											 evaluate(token_vec, ranges.at(first + 1)),
+											 one);
+		if (bound.type != VariableType::Scalar ||
+			!(read_element(name, 0, 0) < bound.data[0]))
+		{
+			break;
+		}
+		if (is_double && depth == 0) {
+			execute_for(src_file, index, end, 1);
+		} else {
+			execute(src_file, index + 1, end);
+		}
+		//the body may change the loop variable
+		value = read_element(name, 0, 0) +
+				evaluate_scalar(token_vec, ranges.at(first + 2));
+	}
+}
+
+void Evaluator::assign(const std::vector<Token>& token_vec,
+					   const TokenCategory& category)
+{
+	const std::string name = token_vec.at(0).value();
+	const Dimensions dim = sym_table->lookup(name).dim();
+	const auto ranges = expression_ranges(token_vec);
+	if (category == TokenCategory::ExprAssignment) {
+		const Value value = evaluate(token_vec, ranges.at(0));
+		if (value.rows != dim.rows || value.cols != dim.cols) {
+			throw std::runtime_error("Assignment of a different size");
+		}
+		charge(static_cast<long>(value.data.size()));
+		Storage& storage = modify(name);
+		storage.data = value.data;
+		storage.defined.assign(value.data.size(), true);
+	} else if (category == TokenCategory::ListAssignment) {
+		if (ranges.size() != static_cast<size_t>(dim.rows) *
+							 static_cast<size_t>(dim.cols))
+		{
+			throw std::runtime_error("List assignment of a different size");
+		}
+		//elements are stored in order as the generated C code does, thus an
+		//element may read the ones before it
+		for (size_t k = 0; k < ranges.size(); ++k) {
+			const double value = evaluate_scalar(token_vec, ranges[k]);
+			Storage& storage = modify(name);
+			storage.data[k] = value;
+			storage.defined[k] = true;
+		}
+	} else {
+		//A[(int)<expr> - 1][0]		OR		A[(int)<expr> - 1][(int)<expr> - 1]
+		const long row = static_cast<long>(to_int(evaluate_scalar(token_vec,
+																  ranges.at(0)))) - 1;
+		long col = 0;
+		if (category == TokenCategory::DoubleSubscriptExprAssignment) {
+			col = static_cast<long>(to_int(evaluate_scalar(token_vec,
+														   ranges.at(1)))) - 1;
+		}
+		const double value = evaluate_scalar(token_vec, ranges.back());
+		if (row < 0 || row >= dim.rows || col < 0 || col >= dim.cols) {
+			throw std::runtime_error("Subscript out of bounds");
+		}
+		Storage& storage = modify(name);
+		const size_t element = static_cast<size_t>(row * dim.cols + col);
+		storage.data[element] = value;
+		storage.defined[element] = true;
+	}
+}
+
+Evaluator::Storage& Evaluator::modify(const std::string& name)
+{
+	Storage& storage = variables[name];
+	if (saved.count(name) == 0) {
+		allocate(static_cast<long>(storage.data.size()));
+		saved[name] = storage;
+	}
+	return storage;
+}
+
+double Evaluator::evaluate_scalar(const std::vector<Token>& token_vec,
+								  const token_range& range)
+{
+	const Value value = evaluate(token_vec, range);
+	if (value.type != VariableType::Scalar) {
+		throw std::runtime_error("Expected a scalar");
+	}
+	return value.data[0];
+}
+
+/** Evaluates the postfix expression in range. Subscripts and function calls
+  * are evaluated as a single operand.
+  */
+Evaluator::Value Evaluator::evaluate(const std::vector<Token>& token_vec,
+									 const token_range& range)
+{
+	std::vector<Value> stack;
+	for (size_t i = range.first; i < range.second; ++i) {
+		const Token& token = token_vec[i];
+		switch (token.category()) {
+			case TokenCategory::Integer:
+			{
+				//leading zeros make an octal literal in C
+				if (token.value().size() > 1 && token.value()[0] == '0') {
+					throw std::runtime_error("Octal literal");
+				}
+				stack.push_back(Value{VariableType::Scalar, 1, 1,
+									  {std::stod(token.value())}, true});
+				break;
+			}
+			case TokenCategory::Real:
+				stack.push_back(Value{VariableType::Scalar, 1, 1,
+									  {std::stod(token.value())}, false});
+				break;
+			case TokenCategory::Identifier:
+				if (i + 1 < range.second && token_vec[i + 1].category() ==
+											TokenCategory::OpenSquareBrackets)
+				{
+					//A [(int) <expr> 1 - ] [(int) <expr> 1 - ]
+					size_t close = 0;
+					const int row = subscript(token_vec, i + 1, close);
+					const int col = subscript(token_vec, close + 1, close);
+					stack.push_back(Value{VariableType::Scalar, 1, 1,
+										  {read_element(token.value(), row, col)},
+										  false});
+					i = close;
+				} else {
+					stack.push_back(read(token.value()));
+				}
+				break;
+			case TokenCategory::TrFunction:
+			case TokenCategory::SqrtFunction:
+			case TokenCategory::ChooseFunction:
+			{
+				size_t close = 0;
+				stack.push_back(call(token_vec, i, close));
+				i = close;
+				break;
+			}
+			case TokenCategory::AdditionOperator:
+			case TokenCategory::SubtractionOperator:
+			case TokenCategory::MultiplicationOperator:
+			{
+				if (stack.size() < 2) {
+					throw std::runtime_error("Malformed expression");
+				}
+				const Value right = std::move(stack.back());
+				stack.pop_back();
+				const Value left = std::move(stack.back());
+				stack.pop_back();
+				stack.push_back(binary_operation(token.category(), left, right));
+				break;
+			}
+			default:
+				throw std::runtime_error("Unexpected token in expression");
+		}
+	}
+	if (stack.size() != 1) {
+		throw std::runtime_error("Malformed expression");
+	}
+	return stack.back();
+}
+
+Evaluator::Value Evaluator::read(const std::string& name)
+{
+	const auto it = variables.find(name);
+	if (it == variables.end() ||
+		std::find(it->second.defined.begin(), it->second.defined.end(),
+				  false) != it->second.defined.end())
+	{
+		throw std::runtime_error("Read of an uninitialized value");
+	}
+	const Variable var = sym_table->lookup(name);
+	charge(static_cast<long>(it->second.data.size()));
+	allocate(static_cast<long>(it->second.data.size()));
+	return Value{var.type(), var.dim().rows, var.dim().cols, it->second.data,
+				 false};
+}
+
+double Evaluator::read_element(const std::string& name, int row, int col)
+{
+	const auto it = variables.find(name);
+	const Dimensions dim = sym_table->lookup(name).dim();
+	if (row < 0 || row >= dim.rows || col < 0 || col >= dim.cols) {
+		throw std::runtime_error("Subscript out of bounds");
+	}
+	const size_t element = static_cast<size_t>(row) * static_cast<size_t>(dim.cols) +
+						   static_cast<size_t>(col);
+	if (it == variables.end() || !it->second.defined.at(element)) {
+		throw std::runtime_error("Read of an uninitialized value");
+	}
+	return it->second.data[element];
+}
+
+/** Evaluates the subscript whose opening bracket is at open and sets close
+  * to the index of its closing bracket. Parser already subtracts 1 inside
+  * the brackets.
+  */
+int Evaluator::subscript(const std::vector<Token>& token_vec, size_t open,
+						 size_t& close)
+{
+	close = matching_bracket(token_vec, open, TokenCategory::OpenSquareBrackets,
+							 TokenCategory::CloseSquareBrackets);
+	return to_int(evaluate_scalar(token_vec, token_range(open + 1, close)));
+}
+
+/** Evaluates the function call starting at index and sets close to the
+  * index of its closing parenthesis. Arguments are separated with commas.
+  */
+Evaluator::Value Evaluator::call(const std::vector<Token>& token_vec,
+								 size_t index, size_t& close)
+{
+	close = matching_bracket(token_vec, index + 1, TokenCategory::OpenParenthesis,
+							 TokenCategory::CloseParenthesis);
+	std::vector<Value> args;
+	size_t begin = index + 2;
+	int depth = 0;
+	for (size_t i = begin; i <= close; ++i) {
+		const TokenCategory category = token_vec[i].category();
+		if (category == TokenCategory::OpenParenthesis ||
+			category == TokenCategory::OpenSquareBrackets)
+		{
+			++depth;
+		} else if ((category == TokenCategory::CloseParenthesis ||
+					category == TokenCategory::CloseSquareBrackets) && i != close)
+		{
+			--depth;
+		} else if (depth == 0 && (category == TokenCategory::Comma || i == close)) {
+			args.push_back(evaluate(token_vec, token_range(begin, i)));
+			begin = i + 1;
+		}
+	}
+	for (const auto& arg : args) {
+		if (&arg != &args.front() && arg.type != VariableType::Scalar) {
+			throw std::runtime_error("Expected a scalar");
+		}
+	}
+	charge(1);
+	switch (token_vec[index].category()) {
+		case TokenCategory::TrFunction:
+		{
+			const Value& arg = args.at(0);
+			if (arg.type == VariableType::Scalar) {
+				return arg;
+			}
+			charge(static_cast<long>(arg.data.size()));
+			Value result{VariableType::Matrix, arg.cols, arg.rows,
+						 std::vector<double>(arg.data.size()), false};
+			for (int i = 0; i < arg.rows; ++i) {
+				for (int j = 0; j < arg.cols; ++j) {
+					result.data[static_cast<size_t>(j * arg.rows + i)] =
+						arg.data[static_cast<size_t>(i * arg.cols + j)];
+				}
+			}
+			return result;
+		}
+		case TokenCategory::SqrtFunction:
+			if (args.at(0).type != VariableType::Scalar) {
+				throw std::runtime_error("Expected a scalar");
+			}
+			return Value{VariableType::Scalar, 1, 1, {std::sqrt(args[0].data[0])},
+						 false};
+		default:
+		{
+			//choose(int condition, double first, double second, double third)
+			if (args.size() != 4 || args[0].type != VariableType::Scalar) {
+				throw std::runtime_error("Expected 4 scalars");
+			}
+			const int condition = to_int(args[0].data[0]);
+			const Value& chosen = (condition == 0) ? args[1]
+												   : (condition > 0) ? args[2]
+																	 : args[3];
+			return Value{VariableType::Scalar, 1, 1, {chosen.data[0]}, false};
+		}
+	}
+}
+
+Evaluator::Value Evaluator::binary_operation(const TokenCategory& op,
+											 const Value& left,
+											 const Value& right)
+{
+	const bool left_scalar = left.type == VariableType::Scalar;
+	const bool right_scalar = right.type == VariableType::Scalar;
+	if (left_scalar && right_scalar) {
+		charge(1);
+		const double l = left.data[0];
+		const double r = right.data[0];
+		double result = (op == TokenCategory::AdditionOperator) ? l + r
+					  : (op == TokenCategory::SubtractionOperator) ? l - r
+																   : l * r;
+		if (left.integral && right.integral) {
+			//int overflow is undefined
+			if (std::fabs(l) > INT_MAX || std::fabs(r) > INT_MAX ||
+				std::fabs(result) > INT_MAX)
+			{
+				throw std::runtime_error("Integer overflow");
+			}
+			//ints have no negative zero
+			result += 0.0;
+		}
+		return Value{VariableType::Scalar, 1, 1, {result},
+					 left.integral && right.integral};
+	}
+	if (left_scalar || right_scalar) {
+		const Value& matrix = left_scalar ? right : left;
+		const double scalar = left_scalar ? left.data[0] : right.data[0];
+		Value result{VariableType::Matrix, matrix.rows, matrix.cols,
+					 std::vector<double>(matrix.data.size()), false};
+		charge(static_cast<long>(matrix.data.size()));
+		allocate(static_cast<long>(matrix.data.size()));
+		if (op == TokenCategory::MultiplicationOperator) {
+			for (size_t i = 0; i < matrix.data.size(); ++i)
+				result.data[i] = scalar * matrix.data[i];
+		} else if (op == TokenCategory::SubtractionOperator && left_scalar) {
+			//0 - <matrix> is the negative of the matrix
+			for (size_t i = 0; i < matrix.data.size(); ++i)
+				result.data[i] = -matrix.data[i];
+		} else {
+			throw std::runtime_error("Cannot add or subtract matrix and scalar");
+		}
+		return result;
+	}
+	if (op != TokenCategory::MultiplicationOperator) {
+		if (left.rows != right.rows || left.cols != right.cols) {
+			throw std::runtime_error("Dimension mismatch");
+		}
+		Value result{VariableType::Matrix, left.rows, left.cols,
+					 std::vector<double>(left.data.size()), false};
+		charge(static_cast<long>(left.data.size()));
+		allocate(static_cast<long>(left.data.size()));
+		for (size_t i = 0; i < left.data.size(); ++i) {
+			result.data[i] = (op == TokenCategory::AdditionOperator)
+								? left.data[i] + right.data[i]
+								: left.data[i] - right.data[i];
+		}
+		return result;
+	}
+	if (left.cols != right.rows) {
+		throw std::runtime_error("Dimension mismatch");
+	}
+	const size_t rows = static_cast<size_t>(left.rows);
+	const size_t common = static_cast<size_t>(left.cols);
+	const size_t cols = static_cast<size_t>(right.cols);
+	charge(static_cast<long>(rows * common * cols));
+	allocate(static_cast<long>(rows * cols));
+	//(1xN) (Nx1) is a scalar
+	Value result{(rows == 1 && cols == 1) ? VariableType::Scalar
+										  : VariableType::Matrix,
+				 left.rows, right.cols, std::vector<double>(rows * cols), false};
+	for (size_t i = 0; i < rows; ++i) {
+		for (size_t j = 0; j < cols; ++j) {
+			double sum = 0;
+			for (size_t k = 0; k < common; ++k) {
+				sum += left.data[i * common + k] * right.data[k * cols + j];
+			}
+			result.data[i * cols + j] = sum;
+		}
+	}
+	return result;
+}
@@ -0,0 +1,142 @@
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include "token.hpp"
+#include "symbol_table.hpp"
+#include "definitions.hpp"
+#include "dataflow.hpp"
+#include "loop_analyzer.hpp"
+
+/** Limits of the compile time evaluation. Every arithmetic operation and
+  * every copied matrix element is an operation. Memory is the number of bytes
+  * of the variables, the temporary matrices and the printed values.
+  */
+struct EvalBudget {
+	long operations;
+	long memory;
+};
+
+/** A print or printsep statement run at compile time. Values of a printsep
+  * are empty.
+  */
+struct PrintedValue {
+	TokenCategory statement;
+	VariableType type;
+	Dimensions dim;
+	std::vector<double> values;
+};
+
+/** Result of the compile time evaluation of a program.
+  *
+  * Statements before src_file[end] are evaluated. If end is the size of the
+  * program, output is everything the program prints. Otherwise, the rest of
+  * the program starts with the variables in values. Elements that are not
+  * assigned yet are 0.
+  */
+struct EvalResult {
+	size_t end;
+	//line number of the statement where the evaluation stopped
+	int stop_line;
+	std::string stop_reason;
+	std::vector<PrintedValue> output;
+	//variables with at least one assigned element in row major order
+	std::map<std::string, std::vector<double>> values;
+	EvalResult()
+		: end(0)
+		, stop_line(0)
+		, stop_reason()
+		, output()
+		, values()
+	{};
+};
+
+//returns a C expression with the exact value of the given double
+std::string c_literal(double value);
+
+/** Runs a program at compile time. MatLang programs don't read any input
+  * except the load statements, thus most of them can be run by the compiler.
+  *
+  * The program is run one top level statement at a time and a for loop is run
+  * as a whole. If a statement exceeds the budget, loads a file, reads an
+  * uninitialized value or does something undefined in C such as indexing out
+  * of bounds or an int overflow, its changes are undone and the evaluation
+  * stops before it.
+  *
+  * Values are computed as the generated C code computes them. Integer literals
+  * are C ints, every other value is a double and matrix products sum in the
+  * same order as the built-in kernels.
+  */
+class Evaluator {
+public:
+	Evaluator(const SymbolTable* const sym_table_ptr, const EvalBudget& t_budget)
+		: sym_table(sym_table_ptr)
+		, loop_analyzer(sym_table_ptr)
+		, budget(t_budget)
+		, operations(0)
+		, memory(0)
+		, variables()
+		, saved()
+		, output()
+	{ };
+	Evaluator(const Evaluator&) = default;
+	Evaluator& operator=(const Evaluator&) = default;
+	//evaluates the statements of src_file until one of them can't be evaluated
+	EvalResult run(const std::vector<stmt_with_info>& src_file);
+	//evaluates a postfix expression of numbers. Returns false if the
+	//expression has any identifiers or can't be evaluated.
+	bool constant(const std::vector<Token>& token_vec, const token_range& range,
+				  double& value);
+private:
+	//a scalar or a matrix computed by an expression
+	struct Value {
+		VariableType type;
+		int rows;
+		int cols;
+		std::vector<double> data;
+		//true if the value has C type int. Only integer literals and the
+		//operations between them are ints.
+		bool integral;
+	};
+	//contents of a variable. Elements that are not assigned are not defined.
+	struct Storage {
+		std::vector<double> data;
+		std::vector<bool> defined;
+		Storage()
+			: data()
+			, defined()
+		{};
+	};
+	void charge(long count);
+	void allocate(long count);
+	//runs the statements in [begin, end)
+	void execute(const std::vector<stmt_with_info>& src_file, size_t begin,
+				 size_t end);
+	//runs the for statement at src_file[index] whose body ends at end
+	void execute_for(const std::vector<stmt_with_info>& src_file, size_t index,
+					 size_t end, size_t depth);
+	void assign(const std::vector<Token>& token_vec, const TokenCategory& category);
+	//returns the storage of the variable and saves it to be able to undo the
+	//current top level statement
+	Storage& modify(const std::string& name);
+	Value evaluate(const std::vector<Token>& token_vec, const token_range& range);
+	double evaluate_scalar(const std::vector<Token>& token_vec,
+						   const token_range& range);
+	Value read(const std::string& name);
+	double read_element(const std::string& name, int row, int col);
+	//returns the index of a subscript after the (int) cast
+	int subscript(const std::vector<Token>& token_vec, size_t open, size_t& close);
+	Value call(const std::vector<Token>& token_vec, size_t index, size_t& close);
+	Value binary_operation(const TokenCategory& op, const Value& left,
+						   const Value& right);
+private:
+	const SymbolTable* const sym_table;
+	LoopAnalyzer loop_analyzer;
+	const EvalBudget budget;
+	long operations;
+	long memory;
+	std::map<std::string, Storage> variables;
+	//variables before the current top level statement changed them
+	std::map<std::string, Storage> saved;
+	std::vector<PrintedValue> output;
+};
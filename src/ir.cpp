@@ -0,0 +1,272 @@
+#include "ir.hpp"
+#include <set>
+#include <stdexcept>
+
+std::vector<std::string> written_variables(const stmt_with_info& stmt)
+{
+	const auto& token_vec = std::get<0>(stmt);
+	switch (std::get<1>(stmt)) {
+		case TokenCategory::ExprAssignment:
+		case TokenCategory::ListAssignment:
+		case TokenCategory::SingleSubscriptExprAssignment:
+		case TokenCategory::DoubleSubscriptExprAssignment:
+			return {token_vec.at(0).value()};
+		case TokenCategory::LoadStatement:
+			return {token_vec.at(2).value()};
+		case TokenCategory::SingleForStatement:
+			return {token_vec.at(2).value()};
+		case TokenCategory::DoubleForStatement:
+			return {token_vec.at(2).value(), token_vec.at(4).value()};
+		default:
+			return {};
+	}
+}
+
+IRProgram IRBuilder::build(const std::vector<stmt_with_info>& src_file)
+{
+	IRProgram program;
+	versions.clear();
+	last_versions.clear();
+	//indices of the for statements of the open loops in program.statements
+	std::vector<size_t> open_loops;
+	for (size_t index = 0; index < src_file.size(); ++index) {
+		const auto& token_vec = std::get<0>(src_file[index]);
+		const auto category = std::get<1>(src_file[index]);
+		IRStatement stmt{category, std::get<2>(src_file[index]), token_vec, {}, "", 0, {}};
+		const bool is_for = category == TokenCategory::SingleForStatement ||
+							category == TokenCategory::DoubleForStatement;
+		if (is_for) {
+			//the header is run before every iteration. Thus, it sees the
+			//versions defined by the phis.
+			std::set<std::string> written;
+			const size_t loop_end = loop_analyzer.loop_end(src_file, index);
+			for (size_t i = index; i < loop_end; ++i) {
+				for (const auto& name : written_variables(src_file[i]))
+					written.insert(name);
+			}
+			for (const auto& name : written) {
+				const int entry = versions[name];
+				stmt.phis.push_back(IRPhi{name, define(name), entry, 0});
+			}
+			open_loops.push_back(program.statements.size());
+		} else if (category == TokenCategory::CloseCurlyBraces && !open_loops.empty()) {
+			for (auto& phi : program.statements[open_loops.back()].phis) {
+				phi.back = versions[phi.name];
+				versions[phi.name] = phi.version;
+			}
+			open_loops.pop_back();
+		}
+		for (const auto& range : expression_ranges(token_vec))
+			stmt.expressions.push_back(build_expression(program, token_vec, range));
+		const auto written = written_variables(src_file[index]);
+		if (!is_for && !written.empty()) {
+			stmt.def = written[0];
+			stmt.version = define(stmt.def);
+		}
+		program.statements.push_back(stmt);
+	}
+	return program;
+}
+
+int IRBuilder::define(const std::string& name)
+{
+	versions[name] = ++last_versions[name];
+	return versions[name];
+}
+
+/** Types and dimensions follow the rules of the code generator. The program
+  * is already checked by the code generator, thus every expression is valid.
+  */
+size_t IRBuilder::build_expression(IRProgram& program, const std::vector<Token>& token_vec,
+								   const token_range& range)
+{
+	std::vector<size_t> stack;
+	for (size_t i = range.first; i < range.second; ++i) {
+		const Token& token = token_vec[i];
+		IRValue value{IROpcode::Constant, VariableType::Scalar, Dimensions(1, 1), "", 0,
+					  {}, {token}};
+		switch (token.category()) {
+			case TokenCategory::Integer:
+			case TokenCategory::Real:
+				break;
+			case TokenCategory::Identifier:
+			{
+				const Variable var = sym_table->lookup(token.value());
+				value.op = IROpcode::Use;
+				value.type = var.type();
+				value.dim = var.dim();
+				value.name = token.value();
+				value.version = versions[token.value()];
+				size_t next = i + 1;
+				while (next < range.second && token_vec[next].category() ==
+											  TokenCategory::OpenSquareBrackets)
+				{
+					const size_t close = matching_bracket(token_vec, next,
+							TokenCategory::OpenSquareBrackets,
+							TokenCategory::CloseSquareBrackets);
+					value.op = IROpcode::Element;
+					value.type = VariableType::Scalar;
+					value.dim = Dimensions(1, 1);
+					value.operands.push_back(build_expression(program, token_vec,
+							token_range(next + 1, close)));
+					value.tokens.push_back(token_vec[next]);
+					value.tokens.push_back(token_vec[close]);
+					next = close + 1;
+				}
+				i = next - 1;
+				break;
+			}
+			case TokenCategory::TrFunction:
+			case TokenCategory::SqrtFunction:
+			case TokenCategory::ChooseFunction:
+			{
+				//f ( <arg> , <arg> ... )
+				const size_t close = matching_bracket(token_vec, i + 1,
+													  TokenCategory::OpenParenthesis,
+													  TokenCategory::CloseParenthesis);
+				value.op = token.category() == TokenCategory::TrFunction
+							   ? IROpcode::Transpose
+							   : token.category() == TokenCategory::SqrtFunction
+									 ? IROpcode::Sqrt
+									 : IROpcode::Choose;
+				value.tokens.push_back(token_vec[i + 1]);
+				size_t arg_begin = i + 2;
+				int depth = 0;
+				for (size_t j = arg_begin; j <= close; ++j) {
+					const TokenCategory category = token_vec[j].category();
+					if (category == TokenCategory::OpenParenthesis ||
+						category == TokenCategory::OpenSquareBrackets)
+					{
+						++depth;
+					} else if ((category == TokenCategory::CloseParenthesis ||
+								category == TokenCategory::CloseSquareBrackets) &&
+							   j != close)
+					{
+						--depth;
+					} else if (depth == 0 && (category == TokenCategory::Comma ||
+											  j == close))
+					{
+						value.operands.push_back(build_expression(program, token_vec,
+								token_range(arg_begin, j)));
+						value.tokens.push_back(token_vec[j]);
+						arg_begin = j + 1;
+					}
+				}
+				if (value.op == IROpcode::Transpose) {
+					const IRValue& arg = program.values.at(value.operands.at(0));
+					value.type = arg.type;
+					value.dim = Dimensions(arg.dim.cols, arg.dim.rows);
+				}
+				i = close;
+				break;
+			}
+			case TokenCategory::AdditionOperator:
+			case TokenCategory::SubtractionOperator:
+			case TokenCategory::MultiplicationOperator:
+			{
+				if (stack.size() < 2) {
+					throw std::runtime_error("IRBuilder: Missing operand");
+				}
+				const size_t right_index = stack.back();
+				stack.pop_back();
+				const size_t left_index = stack.back();
+				stack.pop_back();
+				const IRValue& left = program.values[left_index];
+				const IRValue& right = program.values[right_index];
+				value.op = token.category() == TokenCategory::AdditionOperator
+							   ? IROpcode::Add
+							   : token.category() == TokenCategory::SubtractionOperator
+									 ? IROpcode::Subtract
+									 : IROpcode::Multiply;
+				value.operands = {left_index, right_index};
+				if (left.type == VariableType::Matrix && right.type == VariableType::Matrix) {
+					if (value.op == IROpcode::Multiply) {
+						value.dim = Dimensions(left.dim.rows, right.dim.cols);
+						//(1xN) (Nx1) is a scalar
+						value.type = (value.dim.rows == 1 && value.dim.cols == 1)
+										 ? VariableType::Scalar
+										 : VariableType::Matrix;
+					} else {
+						value.type = VariableType::Matrix;
+						value.dim = left.dim;
+					}
+				} else if (left.type == VariableType::Matrix) {
+					value.type = VariableType::Matrix;
+					value.dim = left.dim;
+				} else if (right.type == VariableType::Matrix) {
+					value.type = VariableType::Matrix;
+					value.dim = right.dim;
+				}
+				break;
+			}
+			default:
+				throw std::runtime_error("IRBuilder: Unexpected token " + token.value());
+		}
+		program.values.push_back(value);
+		stack.push_back(program.values.size() - 1);
+	}
+	if (stack.size() != 1) {
+		throw std::runtime_error("IRBuilder: Invalid expression");
+	}
+	return stack.back();
+}
+
+//appends the postfix tokens of the value
+static void lower_value(const IRProgram& program, size_t index, std::vector<Token>& tokens)
+{
+	const IRValue& value = program.values[index];
+	switch (value.op) {
+		case IROpcode::Constant:
+		case IROpcode::Use:
+			tokens.push_back(value.tokens.at(0));
+			break;
+		case IROpcode::Element:
+			//A [ <row> ] [ <col> ]
+			tokens.push_back(value.tokens.at(0));
+			for (size_t i = 0; i < value.operands.size(); ++i) {
+				tokens.push_back(value.tokens.at(1 + 2 * i));
+				lower_value(program, value.operands[i], tokens);
+				tokens.push_back(value.tokens.at(2 + 2 * i));
+			}
+			break;
+		case IROpcode::Add:
+		case IROpcode::Subtract:
+		case IROpcode::Multiply:
+			lower_value(program, value.operands.at(0), tokens);
+			lower_value(program, value.operands.at(1), tokens);
+			tokens.push_back(value.tokens.at(0));
+			break;
+		case IROpcode::Transpose:
+		case IROpcode::Sqrt:
+		case IROpcode::Choose:
+			//f ( <arg> , <arg> ... )
+			tokens.push_back(value.tokens.at(0));
+			tokens.push_back(value.tokens.at(1));
+			for (size_t i = 0; i < value.operands.size(); ++i) {
+				lower_value(program, value.operands[i], tokens);
+				tokens.push_back(value.tokens.at(2 + i));
+			}
+			break;
+	}
+}
+
+std::vector<stmt_with_info> lower(const IRProgram& program)
+{
+	std::vector<stmt_with_info> result;
+	for (const auto& stmt : program.statements) {
+		std::vector<Token> token_vec;
+		size_t expression = 0;
+		for (size_t i = 0; i < stmt.tokens.size(); ++i) {
+			token_vec.push_back(stmt.tokens[i]);
+			if (stmt.tokens[i].category() != TokenCategory::ExpressionBegin) {
+				continue;
+			}
+			lower_value(program, stmt.expressions.at(expression++), token_vec);
+			while (stmt.tokens.at(i).category() != TokenCategory::ExpressionEnd)
+				++i;
+			token_vec.push_back(stmt.tokens[i]);
+		}
+		result.emplace_back(token_vec, stmt.category, stmt.line);
+	}
+	return result;
+}
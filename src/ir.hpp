@@ -0,0 +1,113 @@
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include "token.hpp"
+#include "symbol_table.hpp"
+#include "definitions.hpp"
+#include "dataflow.hpp"
+#include "loop_analyzer.hpp"
+
+// Typed SSA form of a program. Every expression is a tree of values that
+// know their type and dimensions, and every write to a variable defines a
+// new version of it. Statements keep their source tokens so that the program
+// can be lowered back to the postfix statements the code generator emits.
+
+enum class IROpcode {
+	Constant,	//a literal
+	Use,		//a whole variable
+	Element,	//an element of a matrix. Operands are the 0 based indices
+	Add,
+	Subtract,
+	Multiply,
+	Transpose,
+	Sqrt,
+	Choose
+};
+
+struct IRValue {
+	IROpcode op;
+	VariableType type;
+	Dimensions dim;
+	//variable read by Use and Element and its version
+	std::string name;
+	int version;
+	//indices of the operands in IRProgram::values
+	std::vector<size_t> operands;
+	//source tokens of the value itself: the literal, the identifier and the
+	//brackets of its subscripts, the operator or the function name followed by
+	//its parentheses and commas
+	std::vector<Token> tokens;
+};
+
+/** A variable written in a loop gets a new version at the loop header. It is
+  * the entry version in the first iteration and the back version, the one at
+  * the end of the body, in the others. The version after the loop is the one
+  * defined at the header.
+  */
+struct IRPhi {
+	std::string name;
+	int version;
+	int entry;
+	int back;
+};
+
+struct IRStatement {
+	TokenCategory category;
+	int line;
+	//source tokens of the statement. Expression ranges are replaced by the
+	//lowered expressions.
+	std::vector<Token> tokens;
+	//root values of the expressions in the order they appear
+	std::vector<size_t> expressions;
+	//variable written by the statement and its new version. Subscript
+	//assignments and loads define a new version as well.
+	std::string def;
+	int version;
+	//variables defined by a for statement
+	std::vector<IRPhi> phis;
+};
+
+struct IRProgram {
+	std::vector<IRValue> values;
+	std::vector<IRStatement> statements;
+	IRProgram()
+		: values()
+		, statements()
+	{};
+};
+
+/** Builds the SSA form of a program. Versions start from 0, which is the
+  * value of a variable before its first assignment.
+  */
+class IRBuilder {
+public:
+	//Takes a ptr to sym_table to get the types of the variables
+	IRBuilder(const SymbolTable* const sym_table_ptr)
+		: sym_table(sym_table_ptr)
+		, loop_analyzer(sym_table_ptr)
+		, versions()
+		, last_versions()
+	{ };
+	IRBuilder(const IRBuilder&) = default;
+	IRBuilder& operator=(const IRBuilder&) = default;
+	IRProgram build(const std::vector<stmt_with_info>& src_file);
+private:
+	//appends the values of the postfix expression and returns its root
+	size_t build_expression(IRProgram& program, const std::vector<Token>& token_vec,
+							const token_range& range);
+	//returns a new version of the variable
+	int define(const std::string& name);
+private:
+	const SymbolTable* const sym_table;
+	LoopAnalyzer loop_analyzer;
+	//current version of every variable
+	std::map<std::string, int> versions;
+	std::map<std::string, int> last_versions;
+};
+
+//returns the postfix statements of the program
+std::vector<stmt_with_info> lower(const IRProgram& program);
+//returns the variables written by the statement: the assigned variable or the
+//loop variables. Returns an empty vector for the other statements.
+std::vector<std::string> written_variables(const stmt_with_info& stmt);
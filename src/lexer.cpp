@@ -4,6 +4,8 @@
 
 Lexer::Lexer()
 	: tok_rep()
+	, white_space_rgx(R"(^[[:space:]]$)")
+	, empty_line_rgx(R"(^[[:space:]]+$)")
 {
 }
 
@@ -22,10 +24,6 @@ std::vector<Token> Lexer::tokenize(const std::string& line)
 	std::string compound_str;
 	//Flag to indicate that iterator is one past the last elem of line
 	const char End_char = '\0';
-	//regex for finding any whitespace: space, tab, \r, etc. Check [:space:].
-	Regex white_space_rgx(R"(^[[:space:]]$)");
-	//regex for finding empty lines and skipping them
-	Regex empty_line_rgx(R"(^[[:space:]]+$)");
 	//if empty line, nothing to do. Return an empty token vector
 	if (line.size() == 0 || empty_line_rgx.search(line)) {
 		return token_vec;
@@ -35,6 +33,24 @@ std::vector<Token> Lexer::tokenize(const std::string& line)
 	for (size_t iter = 0; iter <= line.size(); ++iter) { //iterate over line
 		//if iter has passed the last elem, assign the flag value.
 		char sub = (iter != line.size()) ? line[iter] : End_char;
+		//a string literal is everything up to the next double quote. Its
+		//token value doesn't contain the quotes.
+		if (sub == '"') {
+			if (compound_str != "") {
+				std::ostringstream oss;
+				oss << "No meaning can be given to " << compound_str
+					<< std::endl;
+				throw std::runtime_error(oss.str());
+			}
+			const size_t closing = line.find('"', iter + 1);
+			if (closing == std::string::npos) {
+				throw std::runtime_error("String literal: Closing quote expected");
+			}
+			token_vec.emplace_back(line.substr(iter + 1, closing - iter - 1),
+								   TokenCategory::StringLiteral);
+			iter = closing;
+			continue;
+		}
 		//if the current character is any of the ones below, we MAY have a
 		//recursively defined value. Must accumulate digits.
 		if (tok_rep.representation(TokenCategory::Identifier).search(sub)
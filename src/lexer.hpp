@@ -27,6 +27,7 @@ private:
 		TokenCategory::TrFunction,
 		TokenCategory::SqrtFunction,
 		TokenCategory::ChooseFunction,
+		TokenCategory::LoadFunction,
 		TokenCategory::Identifier,
 		TokenCategory::OpenSquareBrackets,
 		TokenCategory::CloseSquareBrackets,
@@ -45,4 +46,8 @@ private:
 		TokenCategory::Dot
 	};
 	const TokenRepresentation tok_rep;
+	//regex for finding any whitespace: space, tab, \r, etc. Check [:space:].
+	const Regex white_space_rgx;
+	//regex for finding empty lines and skipping them
+	const Regex empty_line_rgx;
 };
@@ -0,0 +1,169 @@
+#include "loop_analyzer.hpp"
+#include <cmath>
+#include <map>
+#include "dataflow.hpp"
+
+/** Returns true if the postfix expression in range is of the form
+  * name + <expression> or <expression> + name.
+  */
+bool is_reduction(const std::vector<Token>& token_vec, const token_range& range,
+				  const std::string& name)
+{
+	const size_t begin = range.first;
+	const size_t end = range.second;
+	if (end - begin < 3 ||
+		token_vec[end - 1].category() != TokenCategory::AdditionOperator)
+	{
+		return false;
+	}
+	//name + <expression>
+	if (token_vec[begin].category() == TokenCategory::Identifier &&
+		token_vec[begin].value() == name &&
+		stack_effect(token_vec, begin + 1, end - 1) == 1)
+	{
+		return true;
+	}
+	//<expression> + name
+	return token_vec[end - 2].category() == TokenCategory::Identifier &&
+		   token_vec[end - 2].value() == name &&
+		   stack_effect(token_vec, begin, end - 2) == 1;
+}
+
+/** Returns true if all accesses to the given matrix are subscripted with the
+  * loop variable at the same position.
+  */
+bool is_sliced(const std::vector<Access>& accesses, const std::string& name,
+			   const std::string& loop_var)
+{
+	for (size_t position = 0; position < 2; ++position) {
+		bool sliced = true;
+		for (const auto& access : accesses) {
+			if (access.name != name)
+				continue;
+			if (access.keys.size() != 2 || access.keys[position] != loop_var) {
+				sliced = false;
+				break;
+			}
+		}
+		if (sliced)
+			return true;
+	}
+	return false;
+}
+
+size_t LoopAnalyzer::loop_end(const std::vector<stmt_with_info>& src_file,
+							  size_t for_index) const
+{
+	int depth = 0;
+	for (size_t i = for_index; i < src_file.size(); ++i) {
+		switch (std::get<1>(src_file[i])) {
+			case TokenCategory::SingleForStatement:
+			case TokenCategory::DoubleForStatement:
+				++depth;
+				break;
+			case TokenCategory::CloseCurlyBraces:
+				if (--depth == 0)
+					return i;
+				break;
+			default:
+				break;
+		}
+	}
+	//loop is not closed. Its body extends to the end of the file
+	return src_file.size();
+}
+
+/** Collects every access in the body of the loop in program order and
+  * checks the conditions listed in the class documentation.
+  */
+LoopParallelism LoopAnalyzer::analyze(const std::vector<stmt_with_info>& src_file,
+									  size_t for_index) const
+{
+	LoopParallelism result;
+	const auto& for_tokens = std::get<0>(src_file.at(for_index));
+	const bool is_double =
+		std::get<1>(src_file.at(for_index)) == TokenCategory::DoubleForStatement;
+	//	0   1 2  3  4
+	// for ( i in ...		OR		for ( i , j in ...
+	const std::string outer_var = for_tokens.at(2).value();
+	std::set<std::string> loop_vars{outer_var};
+	if (is_double)
+		loop_vars.insert(for_tokens.at(4).value());
+	const auto bounds = expression_ranges(for_tokens);
+	//step of the outer loop must be a positive integer constant. Propagated
+	//constants are reals with an integer value.
+	const auto& step = bounds.at(2);
+	if (step.second - step.first != 1 ||
+		(for_tokens.at(step.first).category() != TokenCategory::Integer &&
+		 for_tokens.at(step.first).category() != TokenCategory::Real))
+	{
+		return result;
+	}
+	const double step_value = std::stod(for_tokens.at(step.first).value());
+	if (!(step_value > 0) || !(std::floor(step_value) >= step_value)) {
+		return result;
+	}
+	//accesses of the outer loop bounds are kept apart. The inner loop bounds
+	//are evaluated in every iteration, thus they are a part of the body.
+	std::vector<Access> outer_bound_reads;
+	std::vector<Access> accesses;
+	for (size_t i = 0; i < bounds.size(); ++i) {
+		collect_reads(for_tokens, bounds[i], (i < 3) ? outer_bound_reads
+													 : accesses);
+	}
+	//scalar name -> number of statements updating it as s = s + <expr>
+	std::map<std::string, int> reductions;
+	const size_t end_index = this->loop_end(src_file, for_index);
+	for (size_t i = for_index + 1; i < end_index; ++i) {
+		const auto& token_vec = std::get<0>(src_file[i]);
+		//printing fixes the order of the iterations. Nested loops and
+		//declarations are not analyzed.
+		if (!collect_statement_accesses(src_file[i], accesses))
+			return result;
+		const std::string name = token_vec.at(0).value();
+		if (std::get<1>(src_file[i]) == TokenCategory::ExprAssignment &&
+			sym_table->lookup(name).type() == VariableType::Scalar &&
+			is_reduction(token_vec, expression_ranges(token_vec).at(0), name))
+		{
+			++reductions[name];
+		}
+	}
+	std::set<std::string> written;
+	for (const auto& access : accesses) {
+		if (access.write)
+			written.insert(access.name);
+	}
+	for (const auto& name : written) {
+		if (loop_vars.count(name) != 0)
+			return result;
+		for (const auto& access : outer_bound_reads) {
+			if (access.name == name)
+				return result;
+		}
+		if (sym_table->lookup(name).type() == VariableType::Matrix) {
+			if (!is_sliced(accesses, name, outer_var))
+				return result;
+			continue;
+		}
+		int access_count = 0;
+		const Access* first_access = nullptr;
+		for (const auto& access : accesses) {
+			if (access.name == name) {
+				++access_count;
+				if (first_access == nullptr)
+					first_access = &access;
+			}
+		}
+		//each reduction statement reads and writes the scalar exactly once
+		const auto it = reductions.find(name);
+		if (it != reductions.end() && access_count == 2 * it->second) {
+			result.reduction_vars.insert(name);
+		} else if (first_access->write) {
+			result.private_vars.insert(name);
+		} else {
+			return result;
+		}
+	}
+	result.parallel = true;
+	return result;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <set>
+#include <string>
+#include <vector>
+#include "token.hpp"
+#include "symbol_table.hpp"
+#include "definitions.hpp"
+
+/** Result of the dependence analysis of a single for loop.
+  *
+  * If parallel is false, iterations of the loop depend on each other and the
+  * loop must stay serial. Otherwise, the iterations of the outermost loop can
+  * be run concurrently when the listed scalars are made private to each
+  * iteration or combined with a reduction.
+  */
+struct LoopParallelism {
+	bool parallel;
+	//scalars whose first access in an iteration is a write
+	std::set<std::string> private_vars;
+	//scalars that are only updated with s = s + <expression>
+	std::set<std::string> reduction_vars;
+	LoopParallelism()
+		: parallel(false)
+		, private_vars()
+		, reduction_vars()
+	{};
+};
+
+/** Decides if the iterations of a SingleForStatement or a DoubleForStatement
+  * can be run in parallel.
+  *
+  * The analysis is conservative. A loop is parallel only if
+  *
+  *	1. its body contains only assignments (no print, printsep, declaration or
+  *	   nested for statement),
+  *	2. its step is a positive integer constant and neither its bounds nor its
+  *	   loop variables are written in the body,
+  *	3. every matrix written in the body is only written through subscripts and
+  *	   every access to such a matrix uses the outer loop variable as the same
+  *	   subscript. This way, each iteration works on a different slice,
+  *	4. every scalar written in the body is either a reduction variable or is
+  *	   written before it is read in each iteration.
+  */
+class LoopAnalyzer {
+public:
+	//Takes a ptr to sym_table to get the types of the variables
+	LoopAnalyzer(const SymbolTable* const sym_table_ptr)
+		: sym_table(sym_table_ptr)
+	{ };
+	//analyzes the loop starting at src_file[for_index]
+	LoopParallelism analyze(const std::vector<stmt_with_info>& src_file,
+							size_t for_index) const;
+	//returns the index of the statement closing the loop at src_file[for_index]
+	size_t loop_end(const std::vector<stmt_with_info>& src_file,
+					size_t for_index) const;
+private:
+	const SymbolTable* const sym_table;
+};
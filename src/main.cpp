@@ -1,16 +1,25 @@
 #include <iostream>
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <iomanip>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <fstream>
 #include <stdexcept>
-#include "regex.hpp"
-#include "preprocessor.hpp"
-#include "lexer.hpp"
-#include "parser.hpp"
-#include "token.hpp"
+#include <thread>
 #include "symbol_table.hpp"
 #include "code_generator.hpp"
-#include "semantic_analyzer.hpp"
+#include "compiler.hpp"
+#include "server.hpp"
+#include "batch.hpp"
+#include "watcher.hpp"
+#include "ir.hpp"
+#include "bytecode.hpp"
+#include "vm.hpp"
+#include "binary_cache.hpp"
+#include "asm_generator.hpp"
 #include "definitions.hpp"
 
 /** Prints how to call the program from the shell
@@ -22,6 +31,88 @@ void print_usage(const std::string& program_name)
 	std::cout << "Usage:" << std::endl;
 	std::cout << program_name << " SOURCE_FILE" << std::endl;
 	std::cout << program_name << " SOURCE_FILE -o OUTPUT_FILE" << std::endl;
+	std::cout << program_name << " SOURCE_FILE SOURCE_FILE... [--jobs=N]" << std::endl;
+	std::cout << program_name << " --manifest=LIST_FILE [--jobs=N]" << std::endl;
+	std::cout << program_name << " --emit-runtime OUTPUT_DIR" << std::endl;
+	std::cout << program_name << " --server=SOCKET" << std::endl;
+	std::cout << "Options:" << std::endl;
+	std::cout << "  --parallel  run independent for loops in parallel with OpenMP"
+		<< std::endl;
+	std::cout << "  --threads   run large matrix kernels on a pthread worker pool"
+		<< std::endl;
+	std::cout << "  --tasks     run independent assignments concurrently with OpenMP"
+		<< std::endl;
+	std::cout << "  --blas      compute large products with CBLAS" << std::endl;
+	std::cout << "  --blas-min=N  minimum number of multiplications of a product"
+		" computed with CBLAS (default: 4096)" << std::endl;
+	std::cout << "  --eval      run the program at compile time and print the"
+		" results" << std::endl;
+	std::cout << "  --eval-ops=N  maximum number of operations run at compile"
+		" time (default: 100000000)" << std::endl;
+	std::cout << "  --eval-mem=N  maximum number of bytes used at compile time"
+		" (default: 16777216)" << std::endl;
+	std::cout << "  --run       run the program without compiling it to C"
+		<< std::endl;
+	std::cout << "  --asm       write x86-64 assembly calling libmatlangrt instead"
+		" of C (experimental)" << std::endl;
+	std::cout << "  --exec      compile the program to a shared object in the cache"
+		" and run it" << std::endl;
+	std::cout << "  --cache-stats  print the cache hits and misses and the time"
+		" spent in --exec" << std::endl;
+	std::cout << "  --manifest=LIST_FILE  also compile the source files listed in"
+		" LIST_FILE, one on each line" << std::endl;
+	std::cout << "  --jobs=N    compile N source files at a time or a source file on"
+		" N threads (default: number of hardware threads)" << std::endl;
+	std::cout << "  --entry=NAME  write a reentrant function NAME taking the matrices"
+		" and a print callback instead of main" << std::endl;
+	std::cout << "  --split=N   write functions of N top level statements into C"
+		" files of their own and a Makefile fragment building them" << std::endl;
+	std::cout << "  --watch     compile the source again each time it changes. Only"
+		" the changed lines are parsed again" << std::endl;
+	std::cout << "  --server=SOCKET  compile the sources sent to the Unix socket"
+		<< std::endl;
+	std::cout << "  --connect=SOCKET  compile the source with the server listening"
+		" on the socket" << std::endl;
+	std::cout << "  -O0, -O1, -O2  optimization level (default: -O1)" << std::endl;
+	std::cout << "  --time-passes  print the time each optimization pass takes"
+			  << std::endl;
+	std::cout << "  --no-fold   don't fold constant expressions" << std::endl;
+	std::cout << "  --no-dce    don't remove the assignments that are never printed"
+			  << std::endl;
+	std::cout << "  --runtime-lib  call the helpers of libmatlangrt instead of"
+		" writing them" << std::endl;
+	std::cout << "  --emit-runtime  write matlangrt.h and matlangrt.c of"
+		" libmatlangrt to OUTPUT_DIR" << std::endl;
+}
+
+typedef std::chrono::duration<double, std::milli> milliseconds;
+
+/** Loads the shared object of the key from the cache and calls its main.
+  * Returns the exit status of the program.
+  */
+int run_cached(const BinaryCache& cache, const std::string& key, bool hit,
+			   double translate_ms, double compile_ms, bool print_stats)
+{
+	const auto start = std::chrono::steady_clock::now();
+	BinaryCache::program_main program = nullptr;
+	CacheStats stats{0, 0};
+	try {
+		program = BinaryCache::load(cache.object_path(key));
+		stats = cache.record(hit);
+	} catch (const std::runtime_error& e) {
+		std::cout << e.what() << std::endl;
+		return -9;
+	}
+	const milliseconds load_time = std::chrono::steady_clock::now() - start;
+	if (print_stats) {
+		std::cerr << std::fixed << std::setprecision(3) << "cache "
+				  << (hit ? "hit " : "miss ") << key << ": translate "
+				  << translate_ms << " ms, compile " << compile_ms << " ms, load "
+				  << load_time.count() << " ms (" << stats.hits << " hits, "
+				  << stats.misses << " misses)" << std::endl;
+	}
+	std::cout.flush();
+	return program();
 }
 
 /** Strips the last extension from the file name.
@@ -34,77 +125,301 @@ std::string strip_extensions(const std::string& str)
 	return str.substr(0, str.rfind('.'));
 }
 
+/** Compiles the source files and the files listed in the manifest on a pool
+  * of threads. The errors of each file are printed in the given order with
+  * the name of the file. Returns the exit status of the first file that
+  * failed.
+  */
+int compile_batch(const std::vector<std::string>& args, const std::string& manifest_name,
+				  const CodeGenOptions& options, unsigned threads, bool single_only)
+{
+	if (single_only || options.time_passes) {
+		std::cout << "Error: --run, --exec, --asm, --connect and --time-passes can't"
+			" be used with more than one source file" << std::endl;
+		return -2;
+	}
+	std::vector<std::string> sources = args;
+	if (!manifest_name.empty()) {
+		try {
+			const auto listed = read_manifest(manifest_name);
+			sources.insert(sources.end(), listed.begin(), listed.end());
+		} catch (const std::runtime_error& e) {
+			std::cout << e.what() << std::endl;
+			return -3;
+		}
+	}
+	std::vector<BatchJob> jobs;
+	for (const auto& source : sources) {
+		jobs.emplace_back(source, strip_extensions(source) + ".c");
+	}
+	CodeGenOptions file_options = options;
+	file_options.compiler_threads = 1;
+	BatchCompiler(file_options, threads).compile(jobs);
+	int status = 0;
+	for (const auto& job : jobs) {
+		std::istringstream diagnostics(job.result.diagnostics);
+		std::string line;
+		while (std::getline(diagnostics, line)) {
+			std::cout << job.source_name << ": " << line << std::endl;
+		}
+		if (status == 0) {
+			status = job.result.status;
+		}
+	}
+	return status;
+}
+
 int main(int argc, char** argv)
 {
-	//argc == 2 --> only the source file is given
-	//argc == 4 --> source file and target C file is given
-	if (argc != 2 && argc != 4) { //only 2 and 4 is accepted
+	//flags may be given anywhere. The rest are positional arguments
+	CodeGenOptions options;
+	bool emit_runtime = false;
+	bool run = false;
+	bool exec = false;
+	bool assembly = false;
+	bool cache_stats = false;
+	bool watch = false;
+	std::string server_socket;
+	std::string client_socket;
+	std::string manifest_name;
+	long jobs = 0;
+	std::vector<std::string> args;
+	//flags that change the program, in the order they are given
+	std::vector<std::string> flags;
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+		try {
+			if (parse_option(arg, options)) {
+				flags.push_back(arg);
+				continue;
+			}
+		} catch (const CompileError& e) {
+			std::cout << e.what() << std::endl;
+			return e.status;
+		}
+		if (arg == "--emit-runtime") {
+			emit_runtime = true;
+		} else if (arg == "--run") {
+			run = true;
+			flags.push_back(arg);
+		} else if (arg == "--asm") {
+			assembly = true;
+			flags.push_back(arg);
+		} else if (arg == "--exec") {
+			exec = true;
+		} else if (arg == "--cache-stats") {
+			cache_stats = true;
+		} else if (arg == "--watch") {
+			watch = true;
+		} else if (arg.compare(0, 9, "--server=") == 0) {
+			server_socket = arg.substr(9);
+		} else if (arg.compare(0, 10, "--connect=") == 0) {
+			client_socket = arg.substr(10);
+		} else if (arg.compare(0, 11, "--manifest=") == 0) {
+			manifest_name = arg.substr(11);
+		} else if (arg.compare(0, 7, "--jobs=") == 0) {
+			try {
+				jobs = std::stol(arg.substr(7));
+			} catch (const std::exception&) {
+				jobs = -1;
+			}
+			if (jobs <= 0) {
+				std::cout << "Error: Invalid value in " << arg << std::endl;
+				return -2;
+			}
+		} else {
+			args.push_back(arg);
+		}
+	}
+	//the server only takes the flags of the requests
+	if (!server_socket.empty()) {
+		if (!args.empty()) {
+			print_usage(argv[0]);
+			return -1;
+		}
+		try {
+			CompileServer(server_socket).run();
+		} catch (const std::runtime_error& e) {
+			std::cout << e.what() << std::endl;
+			return -9;
+		}
+	}
+	//only the output directory of the runtime library is given
+	if (emit_runtime) {
+		if (args.size() != 1) {
+			print_usage(argv[0]);
+			return -1;
+		}
+		SymbolTable sym_table;
+		CodeGenerator code_gen(&sym_table, options);
+		try {
+			code_gen.generate_runtime(args[0] + "/matlangrt.h",
+									  args[0] + "/matlangrt.c");
+		} catch (const std::runtime_error& e) {
+			std::cout << e.what() << std::endl;
+			return -8;
+		}
+		return 0;
+	}
+	//a single source is compiled on every hardware thread unless told
+	//otherwise. The files of a batch are compiled on a thread each.
+	options.compiler_threads = jobs > 0 ? static_cast<unsigned>(jobs)
+										: std::max(1u, std::thread::hardware_concurrency());
+	//many source files or a manifest --> every file is compiled to its
+	//default output name
+	const bool output_given = std::find(args.begin(), args.end(), "-o") != args.end();
+	if (!manifest_name.empty() || (args.size() > 1 && !output_given)) {
+		return compile_batch(args, manifest_name, options, static_cast<unsigned>(jobs),
+							 run || exec || assembly || !client_socket.empty());
+	}
+	//1 argument --> only the source file is given
+	//3 arguments --> source file and target C file is given
+	if (args.size() != 1 && args.size() != 3) { //only 1 and 3 is accepted
 		print_usage(argv[0]);
 		return -1;
 		//if the output file is given, flag must be -o
-	} else if (argc == 4 && std::string(argv[2]) != "-o") {
+	} else if (args.size() == 3 && args[1] != "-o") {
 		std::cout << "Error: Output file must be given after -o flag"
 			<< std::endl;
 		return -2;
 	}
-	//argc == 2 or argc == 4
-	const std::string Source_name = argv[1];
-	const std::string Default_output_name = strip_extensions(Source_name) +".c";
-	// if we have only one cmd argument, produce a result with a default name.
-	const std::string Output_name = (argc == 2) ? Default_output_name : argv[3];
-	//preprocessor strips comments from the file without deleting any line
-	//this way, line numbers are preserved
-	Preprocessor pp;
-	const std::string Preprocessed_name = pp.remove_comments(Source_name);
-	//we work on the preprocessed file
-	std::ifstream source_file(Preprocessed_name.c_str());
+	const std::string Source_name = args[0];
+	const auto start = std::chrono::steady_clock::now();
+	//with --exec, the program is only translated and compiled if it is not
+	//in the cache. The C file is written into the cache.
+	std::unique_ptr<BinaryCache> cache;
+	std::string cache_key;
+	if (exec) {
+		if (args.size() != 1 || run || options.runtime_library) {
+			std::cout << "Error: --exec can't be used with -o, --run or"
+				" --runtime-lib" << std::endl;
+			return -2;
+		}
+		try {
+			cache.reset(new BinaryCache(BinaryCache::default_directory()));
+			cache_key = cache->key(Source_name, flags);
+		} catch (const std::runtime_error& e) {
+			std::cout << e.what() << std::endl;
+			return -9;
+		}
+		if (cache->contains(cache_key)) {
+			return run_cached(*cache, cache_key, true, 0, 0, cache_stats);
+		}
+	}
+	//the entry point is only written as C
+	if (!options.entry_point.empty() && (run || exec || assembly)) {
+		std::cout << "Error: --entry can't be used with --run, --exec or --asm"
+			<< std::endl;
+		return -2;
+	}
+	//the parts are written into C files of their own
+	if (options.split_statements > 0 &&
+		(run || exec || assembly || watch || !client_socket.empty()))
+	{
+		std::cout << "Error: --split can't be used with --run, --exec, --asm,"
+			" --watch or --connect" << std::endl;
+		return -2;
+	}
+	//the assembly is run with the kernels of libmatlangrt
+	if (assembly && (run || exec || options.parallel_loops || options.threaded_runtime ||
+					 options.task_graph || options.blas || options.evaluate))
+	{
+		std::cout << "Error: --asm can't be used with --run, --exec, --parallel,"
+			" --threads, --tasks, --blas or --eval" << std::endl;
+		return -2;
+	}
+	const std::string Default_output_name = strip_extensions(Source_name) +
+											(assembly ? ".s" : ".c");
+	// if we have only one argument, produce a result with a default name.
+	const std::string Output_name = exec ? cache->source_path(cache_key)
+								  : (args.size() == 1) ? Default_output_name
+													   : args[2];
+	std::ifstream source_file(Source_name.c_str());
 	if (!source_file) {
-		std::cout << Preprocessed_name << " couldn't be opened" << std::endl;
+		std::cout << Source_name << " couldn't be opened" << std::endl;
 		return -3;
 	}
-	SymbolTable sym_table;
-	Lexer lexer; //lexer tokenizes the source file
-	Parser parser(&sym_table); //parser does the syntax check
-	SemanticAnalyzer sem_analyze(&sym_table); //semantic checks
-	//generates the code. Does semantic checks on expressions
-	CodeGenerator code_gen(&sym_table);
-	std::string line; //holds the current line
-	int line_count = 0;
-	//stores the whole file as lines. Each line is a vector of tokens and a
-	//statement type and the line number. See definitions.hpp for more info
-	std::vector<stmt_with_info> source_as_tokens;
-	Regex empty_line_rgx(R"(^[[:space:]]*$)");
-	while (std::getline(source_file, line)) {
-		++line_count;
-		//whenever we see an empty line, we go to the next line
-		if (!empty_line_rgx.search(line)) {
-			try {
-				//tokenize the current line
-				auto token_vec = lexer.tokenize(line);
-				if (token_vec.empty()) {
-					continue;
-				}
-				//parser does syntax check on the token vector and returns
-				//what kind of statement this particular token vector is
-				auto stmt_category = parser.parse(token_vec);
-				source_as_tokens.emplace_back(token_vec, stmt_category, line_count);
-			} catch (std::runtime_error e) {
-				//embed line info to the error and quit the program
-				//no file is generated up to this point. Thus, no extra cleanup
-				std::cout << "Error (Line " << line_count << "): " <<
-					e.what() << std::endl;
-				return -4;
+	//the compile server generates the code
+	if (!client_socket.empty()) {
+		if (run || exec || assembly) {
+			std::cout << "Error: --connect can't be used with --run, --exec or --asm"
+				<< std::endl;
+			return -2;
+		}
+		std::ostringstream source;
+		source << source_file.rdbuf();
+		CompileResult result;
+		try {
+			result = CompileClient(client_socket).compile(source.str(), flags);
+		} catch (const std::runtime_error& e) {
+			std::cout << e.what() << std::endl;
+			return -9;
+		}
+		std::cout << result.diagnostics;
+		if (result.status == 0) {
+			std::ofstream ofs(Output_name.c_str());
+			if (!(ofs << result.output)) {
+				std::cout << "Error: " << Output_name
+					<< " couldn't be opened to write the output" << std::endl;
+				return -7;
 			}
 		}
+		return result.status;
+	}
+	//the source is compiled again each time it is saved
+	if (watch) {
+		if (run || exec || assembly) {
+			std::cout << "Error: --watch can't be used with --run, --exec or --asm"
+				<< std::endl;
+			return -2;
+		}
+		Watcher(Source_name, Output_name, options).run();
 	}
-	//After the whole file passes the syntax check, pass the whole file to
-	//semantic analyzer and code generator respectively.
+	SymbolTable sym_table;
+	Compiler compiler;
+	std::vector<stmt_with_info> source_as_tokens;
 	try {
-		//if there is any semantic errors, catch the error, print and quit
-		sem_analyze.analyze(source_as_tokens);
-	} catch (std::runtime_error e) {
+		//syntax and semantic checks. Nothing is generated up to this point.
+		source_as_tokens = compiler.parse(source_file, &sym_table, nullptr,
+										  options.compiler_threads);
+	} catch (const CompileError& e) {
 		std::cout << e.what() << std::endl;
-		return -5;
+		return e.status;
+	}
+	//generates the code. Does semantic checks on expressions
+	CodeGenerator code_gen(&sym_table, options);
+	//the program is run by the virtual machine or written as assembly
+	//instead of writing a C file
+	if (run || assembly) {
+		Bytecode bytecode;
+		try {
+			const auto program = code_gen.optimize(source_as_tokens);
+			bytecode = BytecodeCompiler(&sym_table).compile(
+				IRBuilder(&sym_table).build(program));
+			if (assembly) {
+				AsmGenerator(bytecode).generate(Output_name);
+			}
+		} catch (const std::runtime_error& e) {
+			std::cout << e.what() << std::endl;
+			if (assembly) {
+				std::remove(Output_name.c_str());
+			}
+			return -7;
+		}
+		if (assembly) {
+			return 0;
+		}
+		VirtualMachine machine(bytecode);
+		try {
+			machine.run();
+		} catch (const std::runtime_error& e) {
+			//the compiled program has printed the output before the error
+			machine.out_flush();
+			//the C program writes its errors to stderr and exits with 1
+			std::cerr << e.what() << std::endl;
+			return 1;
+		}
+		return 0;
 	}
 	try {
 		//code generator starts generating some code as soon as it starts
@@ -115,10 +430,22 @@ int main(int argc, char** argv)
 	} catch(std::runtime_error e) {
 		std::cout << e.what() << std::endl;
 		std::remove(Output_name.c_str());
-		std::remove(Preprocessed_name.c_str());
 		return -7;
 	}
-	//At this point, all the job is done. Delete the preprocessed file
-	std::remove(Preprocessed_name.c_str());
+	if (exec) {
+		const auto translated = std::chrono::steady_clock::now();
+		try {
+			cache->build(Output_name, cache_key, options);
+		} catch (const std::runtime_error& e) {
+			std::cout << e.what() << std::endl;
+			std::remove(Output_name.c_str());
+			return -9;
+		}
+		std::remove(Output_name.c_str());
+		const milliseconds translate_time = translated - start;
+		const milliseconds compile_time = std::chrono::steady_clock::now() - translated;
+		return run_cached(*cache, cache_key, false, translate_time.count(),
+						  compile_time.count(), cache_stats);
+	}
 	return 0;
 }
@@ -0,0 +1,28 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/** Calls f(i) for each i in [0, count) on at most threads threads. The
+  * calling thread is one of them. f must not throw.
+  */
+template<typename F>
+void parallel_for(size_t count, unsigned threads, const F& f)
+{
+	const size_t workers = std::min<size_t>(threads, count);
+	std::atomic<size_t> next(0);
+	const auto work = [&]() {
+		for (size_t i = next++; i < count; i = next++) {
+			f(i);
+		}
+	};
+	std::vector<std::thread> pool;
+	for (size_t i = 1; i < workers; ++i) {
+		pool.emplace_back(work);
+	}
+	work();
+	for (auto& thread : pool) {
+		thread.join();
+	}
+}
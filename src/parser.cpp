@@ -635,6 +635,17 @@ void Parser::initialize_rules()
 		TokenCategory::AssignmentOperator,
 		TokenCategory::InitializerList,
 	};
+
+	//load(A, "file") fills A from a file at runtime
+	prod_rules[TokenCategory::LoadStatement] =
+	{
+		TokenCategory::LoadFunction,
+		TokenCategory::OpenParenthesis,
+		TokenCategory::Identifier,
+		TokenCategory::Comma,
+		TokenCategory::StringLiteral,
+		TokenCategory::CloseParenthesis
+	};
 }
 
 /** Replaces the expression between the given indices [begin, end) in
@@ -104,6 +104,7 @@ private:
 		TokenCategory::TrFunction,
 		TokenCategory::SqrtFunction,
 		TokenCategory::ChooseFunction,
+		TokenCategory::LoadFunction,
 		TokenCategory::Identifier,
 		TokenCategory::OpenSquareBrackets,
 		TokenCategory::CloseSquareBrackets,
@@ -119,7 +120,8 @@ private:
 		TokenCategory::MultiplicationOperator,
 		TokenCategory::Comma,
 		TokenCategory::DoubleColon,
-		TokenCategory::Dot
+		TokenCategory::Dot,
+		TokenCategory::StringLiteral
 	};
 	const std::set<TokenCategory> nonterminal_categories {
 		TokenCategory::ScalarDeclaration,
@@ -134,6 +136,7 @@ private:
 		TokenCategory::SingleSubscriptExprAssignment,
 		TokenCategory::DoubleSubscriptExprAssignment,
 		TokenCategory::ListAssignment,
+		TokenCategory::LoadStatement,
 		TokenCategory::Expression,
 		TokenCategory::Term,
 		TokenCategory::Factor,
@@ -0,0 +1,63 @@
+#include "pass_manager.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include "constant_folder.hpp"
+#include "dead_code_eliminator.hpp"
+#include "ir.hpp"
+#include "value_numbering.hpp"
+
+std::vector<std::pair<std::string, PassManager::pass_function>> PassManager::passes() const
+{
+	std::vector<std::pair<std::string, pass_function>> result;
+	if (options.optimization_level >= 1 && options.fold_constants) {
+		result.emplace_back("constant-folding", &PassManager::fold_constants);
+	}
+	if (options.optimization_level >= 2) {
+		result.emplace_back("value-numbering", &PassManager::number_values);
+	}
+	//the matrices of an entry point are read by its caller
+	if (options.optimization_level >= 1 && options.eliminate_dead_code &&
+		options.entry_point.empty())
+	{
+		result.emplace_back("dead-code-elimination", &PassManager::eliminate_dead_code);
+	}
+	return result;
+}
+
+std::vector<stmt_with_info> PassManager::run(const std::vector<stmt_with_info>& src_file) const
+{
+	std::vector<stmt_with_info> result = src_file;
+	for (const auto& pass : passes()) {
+		const auto start = std::chrono::steady_clock::now();
+		result = (this->*pass.second)(result);
+		const std::chrono::duration<double, std::milli> elapsed =
+			std::chrono::steady_clock::now() - start;
+		if (options.time_passes) {
+			std::cerr << std::left << std::setw(24) << pass.first << std::right
+					  << std::fixed << std::setprecision(3) << std::setw(10)
+					  << elapsed.count() << " ms " << std::setw(8) << result.size()
+					  << " statements" << std::endl;
+		}
+	}
+	return result;
+}
+
+std::vector<stmt_with_info> PassManager::fold_constants(const std::vector<stmt_with_info>& src_file) const
+{
+	return ConstantFolder(sym_table).fold(src_file);
+}
+
+std::vector<stmt_with_info> PassManager::number_values(const std::vector<stmt_with_info>& src_file) const
+{
+	IRProgram program = IRBuilder(sym_table).build(src_file);
+	if (ValueNumbering().run(program) == 0) {
+		return src_file;
+	}
+	return lower(program);
+}
+
+std::vector<stmt_with_info> PassManager::eliminate_dead_code(const std::vector<stmt_with_info>& src_file) const
+{
+	return DeadCodeEliminator(sym_table).eliminate(src_file);
+}
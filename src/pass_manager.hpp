@@ -0,0 +1,42 @@
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+#include "symbol_table.hpp"
+#include "definitions.hpp"
+#include "code_generator.hpp"
+
+/** Runs the optimization passes selected by the optimization level on a
+  * program.
+  *
+  * -O0 runs no passes. -O1 folds the constants and removes the dead code.
+  * -O2 also builds the SSA form of the program and reuses the matrices
+  * already computed. Passes working on the SSA form lower it back to the
+  * postfix statements the code generator emits.
+  *
+  * With the time_passes option, the time and the number of statements after
+  * each pass are printed to stderr.
+  */
+class PassManager {
+public:
+	//Takes a ptr to sym_table to get the types of the variables
+	PassManager(const SymbolTable* const sym_table_ptr, const CodeGenOptions& t_options)
+		: sym_table(sym_table_ptr)
+		, options(t_options)
+	{ };
+	PassManager(const PassManager&) = default;
+	PassManager& operator=(const PassManager&) = default;
+	//returns the optimized program
+	std::vector<stmt_with_info> run(const std::vector<stmt_with_info>& src_file) const;
+private:
+	typedef std::vector<stmt_with_info> (PassManager::*pass_function)(
+			const std::vector<stmt_with_info>&) const;
+	//names and functions of the passes in the order they run
+	std::vector<std::pair<std::string, pass_function>> passes() const;
+	std::vector<stmt_with_info> fold_constants(const std::vector<stmt_with_info>&) const;
+	std::vector<stmt_with_info> number_values(const std::vector<stmt_with_info>&) const;
+	std::vector<stmt_with_info> eliminate_dead_code(const std::vector<stmt_with_info>&) const;
+private:
+	const SymbolTable* const sym_table;
+	const CodeGenOptions options;
+};
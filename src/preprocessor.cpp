@@ -17,12 +17,27 @@ const std::string Preprocessor::remove_comments(const std::string& source_name)
 	if (!output_file) {
 		throw std::runtime_error(Output_name + " couldn't be opened!");
 	}
+	this->remove_comments(source_file, output_file);
+	return Output_name;
+}
+
+void Preprocessor::remove_comments(std::istream& source, std::ostream& output) const
+{
 	std::string line;
-	while (std::getline(source_file, line)) { //read each line
-		// get the substring until the first # in a line.
-		// if there is no #, line is not changed
-		line = line.substr(0, line.find('#'));
-		output_file << line << std::endl;
+	while (std::getline(source, line)) { //read each line
+		// get the substring until the first # in a line that is not in a
+		// string literal. if there is no such #, line is not changed
+		bool in_string = false;
+		size_t i = 0;
+		for (; i < line.size(); ++i) {
+			if (line[i] == '"') {
+				in_string = !in_string;
+			} else if (line[i] == '#' && !in_string) {
+				break;
+			}
+		}
+		line = line.substr(0, i);
+		output << line << '\n';
 	}
-	return Output_name;
+	output.flush();
 }
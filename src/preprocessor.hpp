@@ -1,5 +1,7 @@
 #pragma once
 
+#include <istream>
+#include <ostream>
 #include <string>
 
 /** Preprocesses the given file before the tokenizing begins
@@ -9,6 +11,9 @@ public:
 	//Preprocessed files are added an extension
 	const std::string File_extension{".pp"};
 	//removes comments from the file without deleting any lines
-	//in order to preserve the line number information
+	//in order to preserve the line number information. A # in a string
+	//literal doesn't start a comment
 	const std::string remove_comments(const std::string& source_name);
+	//removes comments from the source read from the stream
+	void remove_comments(std::istream& source, std::ostream& output) const;
 };
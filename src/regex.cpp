@@ -35,21 +35,20 @@ Regex::Regex(const Regex& other)
 	this->assign(this->regex_pattern, this->regex_flags);
 }
 
+//the compiled regex is taken from other without compiling it again
 Regex::Regex(Regex&& other)
-	: compiled(nullptr, regfree)
-	, regex_pattern(other.regex_pattern)
+	: compiled(std::move(other.compiled))
+	, regex_pattern(std::move(other.regex_pattern))
 	, regex_flags(other.regex_flags)
 {
-	*this = std::move(other);
 }
 
 Regex& Regex::operator=(Regex&& other)
 {
 	if (this != &other) {
-		this->regex_pattern = other.regex_pattern;
+		this->compiled = std::move(other.compiled);
+		this->regex_pattern = std::move(other.regex_pattern);
 		this->regex_flags = other.regex_flags;
-		this->assign(this->regex_pattern, this->regex_flags);
-		other.compiled.reset(nullptr);
 	}
 	return *this;
 }
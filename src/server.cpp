@@ -0,0 +1,265 @@
+#include "server.hpp"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+//longest header line accepted
+static const size_t max_header = 4096;
+//largest source accepted
+static const size_t max_request = 64 << 20;
+//seconds a connection may wait for the next bytes of a request
+static const long read_timeout = 60;
+
+static std::string system_error(const std::string& prefix)
+{
+	return "Error: " + prefix + ": " + std::strerror(errno);
+}
+
+static sockaddr_un socket_address(const std::string& path)
+{
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(address.sun_path)) {
+		throw std::runtime_error("Error: socket path " + path + " is too long");
+	}
+	std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+	return address;
+}
+
+static void write_all(int fd, const std::string& data)
+{
+	size_t written = 0;
+	while (written < data.size()) {
+		const ssize_t count = write(fd, data.data() + written, data.size() - written);
+		if (count < 0 && errno == EINTR)
+			continue;
+		if (count <= 0) {
+			throw std::runtime_error(system_error("write"));
+		}
+		written += static_cast<size_t>(count);
+	}
+}
+
+/** Reads from fd until buffer holds count bytes. Returns false at the end of
+  * the stream.
+  */
+static bool fill(int fd, std::string& buffer, size_t count)
+{
+	char chunk[65536];
+	while (buffer.size() < count) {
+		const ssize_t received = read(fd, chunk, sizeof(chunk));
+		if (received < 0 && errno == EINTR)
+			continue;
+		if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+			throw std::runtime_error("Error: read timed out");
+		}
+		if (received < 0) {
+			throw std::runtime_error(system_error("read"));
+		}
+		if (received == 0) {
+			return false;
+		}
+		buffer.append(chunk, static_cast<size_t>(received));
+	}
+	return true;
+}
+
+/** Takes the header line and the count bytes after it from the buffer. Returns
+  * false if the stream ends before the header.
+  */
+static bool read_message(int fd, std::string& buffer, std::string& header,
+						 std::string& body, size_t (*body_size)(const std::string&))
+{
+	size_t newline = buffer.find('\n');
+	while (newline == std::string::npos) {
+		if (buffer.size() > max_header) {
+			throw std::runtime_error("Error: header is too long");
+		}
+		if (!fill(fd, buffer, buffer.size() + 1)) {
+			if (buffer.empty())
+				return false;
+			throw std::runtime_error("Error: unexpected end of stream");
+		}
+		newline = buffer.find('\n');
+	}
+	header = buffer.substr(0, newline);
+	const size_t count = body_size(header);
+	if (!fill(fd, buffer, newline + 1 + count)) {
+		throw std::runtime_error("Error: unexpected end of stream");
+	}
+	body = buffer.substr(newline + 1, count);
+	buffer.erase(0, newline + 1 + count);
+	return true;
+}
+
+//<source bytes> [<flag> ...]
+static size_t request_size(const std::string& header)
+{
+	std::istringstream iss(header);
+	size_t count = 0;
+	if (!(iss >> count)) {
+		throw std::runtime_error("Error: malformed request");
+	}
+	if (count > max_request) {
+		throw std::runtime_error("Error: request is too large");
+	}
+	return count;
+}
+
+//<status> <C bytes> <diagnostics bytes>
+static size_t response_size(const std::string& header)
+{
+	std::istringstream iss(header);
+	int status = 0;
+	size_t output = 0;
+	size_t diagnostics = 0;
+	if (!(iss >> status >> output >> diagnostics)) {
+		throw std::runtime_error("Error: malformed response");
+	}
+	return output + diagnostics;
+}
+
+void CompileServer::run()
+{
+	//a client closing its connection early must not stop the server
+	std::signal(SIGPIPE, SIG_IGN);
+	const sockaddr_un address = socket_address(socket_path);
+	const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0) {
+		throw std::runtime_error(system_error("socket"));
+	}
+	//the socket of a previous server is replaced
+	unlink(socket_path.c_str());
+	if (bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+		listen(listener, SOMAXCONN) != 0)
+	{
+		const std::string error = system_error(socket_path);
+		close(listener);
+		throw std::runtime_error(error);
+	}
+	while (true) {
+		const int fd = accept(listener, nullptr, nullptr);
+		if (fd < 0) {
+			if (errno == EINTR || errno == ECONNABORTED)
+				continue;
+			const std::string error = system_error("accept");
+			close(listener);
+			throw std::runtime_error(error);
+		}
+		//a client waiting for its next bytes is disconnected
+		timeval timeout;
+		timeout.tv_sec = read_timeout;
+		timeout.tv_usec = 0;
+		setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+		//a slow client doesn't hold up the others
+		try {
+			std::thread([fd]() {
+				serve(fd);
+				close(fd);
+			}).detach();
+		} catch (const std::system_error& e) {
+			std::cerr << "Error: " << e.what() << std::endl;
+			close(fd);
+		}
+	}
+}
+
+/** A malformed request, a read timeout or a failed write closes the
+  * connection.
+  */
+void CompileServer::serve(int fd)
+{
+	std::string buffer;
+	std::string header;
+	std::string source;
+	try {
+		while (read_message(fd, buffer, header, source, request_size)) {
+			std::istringstream iss(header);
+			size_t count = 0;
+			iss >> count;
+			std::vector<std::string> flags;
+			std::string flag;
+			while (iss >> flag)
+				flags.push_back(flag);
+			const CompileResult result = handle(source, flags);
+			write_all(fd, std::to_string(result.status) + " " +
+						  std::to_string(result.output.size()) + " " +
+						  std::to_string(result.diagnostics.size()) + "\n" +
+						  result.output + result.diagnostics);
+		}
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+	}
+}
+
+CompileResult CompileServer::handle(const std::string& source,
+									const std::vector<std::string>& flags)
+{
+	CodeGenOptions options;
+	for (const auto& flag : flags) {
+		try {
+			if (!parse_option(flag, options)) {
+				throw CompileError("Error: " + flag + " can't be used with the"
+								   " compile server", -2);
+			}
+		} catch (const CompileError& e) {
+			CompileResult result;
+			result.status = e.status;
+			result.diagnostics = std::string(e.what()) + "\n";
+			return result;
+		}
+	}
+	//each connection thread compiles with a Compiler of its own
+	return compile_matlang(source, options);
+}
+
+CompileClient::CompileClient(const std::string& socket_path)
+	: fd(socket(AF_UNIX, SOCK_STREAM, 0))
+	, buffer()
+{
+	if (fd < 0) {
+		throw std::runtime_error(system_error("socket"));
+	}
+	const sockaddr_un address = socket_address(socket_path);
+	if (connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+		const std::string error = system_error(socket_path);
+		close(fd);
+		throw std::runtime_error(error);
+	}
+}
+
+CompileClient::~CompileClient()
+{
+	close(fd);
+}
+
+CompileResult CompileClient::compile(const std::string& source,
+									 const std::vector<std::string>& flags)
+{
+	std::string request = std::to_string(source.size());
+	for (const auto& flag : flags) {
+		request += " " + flag;
+	}
+	write_all(fd, request + "\n" + source);
+	std::string header;
+	std::string body;
+	if (!read_message(fd, buffer, header, body, response_size)) {
+		throw std::runtime_error("Error: the compile server closed the connection");
+	}
+	CompileResult result;
+	size_t output_size = 0;
+	std::istringstream(header) >> result.status >> output_size;
+	result.output = body.substr(0, output_size);
+	result.diagnostics = body.substr(output_size);
+	return result;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "compiler.hpp"
+
+/** Compile server listening on a Unix domain socket.
+  *
+  * A client sends any number of requests on a connection and gets a response
+  * for each of them in order:
+  *
+  *	request:  <source bytes> [<flag> ...]\n<source>
+  *	response: <status> <C bytes> <diagnostics bytes>\n<C code><diagnostics>
+  *
+  * Flags are the code generation flags of matlang2c separated by spaces.
+  * status and diagnostics are the exit status and the output of matlang2c
+  * for the same source and flags. Each connection is served on a thread of
+  * its own, which compiles with its own Compiler, thus the regexes are
+  * compiled once for each connection. Sources larger than 64 MiB are refused
+  * and a connection is closed when a request doesn't arrive in 60 seconds.
+  */
+class CompileServer {
+public:
+	CompileServer(const std::string& t_socket_path)
+		: socket_path(t_socket_path)
+	{ };
+	//serves the clients until the process is killed
+	[[noreturn]] void run();
+private:
+	//serves the requests of the connection until the client closes it
+	static void serve(int fd);
+	static CompileResult handle(const std::string& source,
+								const std::vector<std::string>& flags);
+private:
+	const std::string socket_path;
+};
+
+/** Client of a CompileServer. The connection is kept open between the
+  * requests.
+  */
+class CompileClient {
+public:
+	//connects to the server
+	CompileClient(const std::string& socket_path);
+	~CompileClient();
+	CompileClient(const CompileClient&) = delete;
+	CompileClient& operator=(const CompileClient&) = delete;
+	CompileResult compile(const std::string& source, const std::vector<std::string>& flags);
+private:
+	int fd;
+	//bytes received after the last response
+	std::string buffer;
+};
@@ -48,6 +48,8 @@ void TokenRepresentation::initialize_regex()
 		Regex(R"(^sqrt$)");
 	Category_to_regex[TokenCategory::ChooseFunction] =
 		Regex(R"(^choose$)");
+	Category_to_regex[TokenCategory::LoadFunction] =
+		Regex(R"(^load$)");
 	Category_to_regex[TokenCategory::Identifier] =
 		Regex(R"(^[_[:alpha:]][_[:alnum:]]*$)");
 	Category_to_regex[TokenCategory::OpenSquareBrackets] =
@@ -127,6 +129,9 @@ std::ostream& operator<<(std::ostream& os, const TokenCategory& category)
 		case TokenCategory::ChooseFunction:
 			os << "ChooseFunction";
 			break;
+		case TokenCategory::LoadFunction:
+			os << "LoadFunction";
+			break;
 		case TokenCategory::Identifier:
 			os << "Identifier";
 			break;
@@ -175,6 +180,9 @@ std::ostream& operator<<(std::ostream& os, const TokenCategory& category)
 		case TokenCategory::Dot:
 			os << "Dot";
 			break;
+		case TokenCategory::StringLiteral:
+			os << "StringLiteral";
+			break;
 		case TokenCategory::ScalarDeclaration:
 			os << "ScalarDeclaration";
 			break;
@@ -211,6 +219,9 @@ std::ostream& operator<<(std::ostream& os, const TokenCategory& category)
 		case TokenCategory::ListAssignment:
 			os << "ListAssignment";
 			break;
+		case TokenCategory::LoadStatement:
+			os << "LoadStatement";
+			break;
 		case TokenCategory::Expression:
 			os << "Expression";
 			break;
@@ -21,6 +21,7 @@ enum class TokenCategory {
 	TrFunction,
 	SqrtFunction,
 	ChooseFunction,
+	LoadFunction,
 	Identifier,
 	OpenSquareBrackets,
 	CloseSquareBrackets,
@@ -37,6 +38,7 @@ enum class TokenCategory {
 	Comma,
 	DoubleColon,
 	Dot,
+	StringLiteral,
 	/* NONTERMINALS START */
 	ScalarDeclaration,
 	VectorDeclaration,
@@ -50,6 +52,7 @@ enum class TokenCategory {
 	SingleSubscriptExprAssignment,
 	DoubleSubscriptExprAssignment,
 	ListAssignment,
+	LoadStatement,
 	Expression,
 	Term,
 	Factor,
@@ -0,0 +1,120 @@
+#include "value_numbering.hpp"
+
+int ValueNumbering::run(IRProgram& program)
+{
+	available.assign(1, {});
+	current.clear();
+	int count = 0;
+	//for statements of the open loops
+	std::vector<size_t> open_loops;
+	for (size_t index = 0; index < program.statements.size(); ++index) {
+		const IRStatement& stmt = program.statements[index];
+		const bool is_for = stmt.category == TokenCategory::SingleForStatement ||
+							stmt.category == TokenCategory::DoubleForStatement;
+		if (is_for) {
+			for (const auto& phi : stmt.phis)
+				current[phi.name] = phi.version;
+		} else if (stmt.category == TokenCategory::CloseCurlyBraces &&
+				   !open_loops.empty())
+		{
+			available.pop_back();
+			for (const auto& phi : program.statements[open_loops.back()].phis)
+				current[phi.name] = phi.version;
+			open_loops.pop_back();
+			continue;
+		}
+		std::map<size_t, std::string> keys;
+		for (const auto root : stmt.expressions)
+			key(program, root, keys);
+		for (const auto root : stmt.expressions)
+			count += replace(program, root, keys);
+		if (is_for) {
+			//values before the loop stay available in the body
+			available.push_back(available.back());
+			open_loops.push_back(index);
+		} else if (!stmt.def.empty()) {
+			current[stmt.def] = stmt.version;
+			if (stmt.category != TokenCategory::ExprAssignment) {
+				continue;
+			}
+			//keys are computed before the replacement. Keys of the operations
+			//and the function calls have parentheses.
+			const size_t root = stmt.expressions.at(0);
+			const std::string& root_key = keys.at(root);
+			if (program.values[root].type != VariableType::Matrix ||
+				root_key.find('(') == std::string::npos)
+			{
+				continue;
+			}
+			//keep the variable already holding the value
+			const auto holder = available.back().find(root_key);
+			if (holder == available.back().end() ||
+				current[holder->second.first] != holder->second.second)
+			{
+				available.back()[root_key] = std::make_pair(stmt.def, stmt.version);
+			}
+		}
+	}
+	return count;
+}
+
+const std::string& ValueNumbering::key(const IRProgram& program, size_t index,
+									   std::map<size_t, std::string>& keys) const
+{
+	const IRValue& value = program.values[index];
+	std::string result;
+	switch (value.op) {
+		case IROpcode::Constant:
+			result = value.tokens.at(0).value();
+			break;
+		case IROpcode::Use:
+			result = value.name + "#" + std::to_string(value.version);
+			break;
+		case IROpcode::Element:
+			result = value.name + "#" + std::to_string(value.version);
+			for (const auto operand : value.operands)
+				result += "[" + key(program, operand, keys) + "]";
+			break;
+		case IROpcode::Add:
+		case IROpcode::Subtract:
+		case IROpcode::Multiply:
+			result = "(" + key(program, value.operands.at(0), keys) + " " +
+					 value.tokens.at(0).value() + " " +
+					 key(program, value.operands.at(1), keys) + ")";
+			break;
+		case IROpcode::Transpose:
+		case IROpcode::Sqrt:
+		case IROpcode::Choose:
+			result = value.tokens.at(0).value() + "(";
+			for (const auto operand : value.operands)
+				result += key(program, operand, keys) + ",";
+			result += ")";
+			break;
+	}
+	return keys[index] = result;
+}
+
+/** Replaces the outermost expressions that are available */
+int ValueNumbering::replace(IRProgram& program, size_t index,
+							const std::map<size_t, std::string>& keys)
+{
+	const IRValue& value = program.values[index];
+	if (value.type == VariableType::Matrix && value.op != IROpcode::Use &&
+		value.op != IROpcode::Constant)
+	{
+		const auto holder = available.back().find(keys.at(index));
+		if (holder != available.back().end() &&
+			current[holder->second.first] == holder->second.second)
+		{
+			const std::string& name = holder->second.first;
+			program.values[index] = IRValue{IROpcode::Use, value.type, value.dim, name,
+											holder->second.second, {},
+											{Token(name, TokenCategory::Identifier)}};
+			return 1;
+		}
+	}
+	int count = 0;
+	for (const auto operand : value.operands)
+		count += replace(program, operand, keys);
+	return count;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ir.hpp"
+
+/** Replaces the matrix expressions whose value is already held by a variable
+  * with the variable.
+  *
+  * Two expressions have the same value if they apply the same operations to
+  * the same versions of the same variables. After X = <expr>, later uses of
+  * <expr> read X as long as the version of X is the one defined there. Values
+  * computed in a loop body are available only in the rest of the body.
+  *
+  * Only matrix expressions are replaced. Scalar expressions are cheap and are
+  * left to the C compiler.
+  */
+class ValueNumbering {
+public:
+	ValueNumbering()
+		: available()
+		, current()
+	{ };
+	//returns the number of replaced expressions
+	int run(IRProgram& program);
+private:
+	//computes the keys of the value and its operands
+	const std::string& key(const IRProgram& program, size_t index,
+						   std::map<size_t, std::string>& keys) const;
+	int replace(IRProgram& program, size_t index,
+				const std::map<size_t, std::string>& keys);
+private:
+	//key of an expression -> variable and version holding its value. The
+	//back is the innermost loop.
+	std::vector<std::map<std::string, std::pair<std::string, int>>> available;
+	//current version of every variable
+	std::map<std::string, int> current;
+};
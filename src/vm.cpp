@@ -0,0 +1,499 @@
+#include "vm.hpp"
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+//sizes of the output buffer and the chunks of the csv loader of the C programs
+static const size_t out_bytes = 65536;
+static const size_t csv_chunk = 1 << 20;
+
+//message of perror
+static std::string system_error(const std::string& prefix)
+{
+	return prefix + ": " + std::strerror(errno);
+}
+
+static std::string line_error(int line, const std::string& msg)
+{
+	return "Error (Line " + std::to_string(line) + "): " + msg;
+}
+
+//writes every byte, retrying after partial writes
+static void write_all(int fd, const char* data, size_t count)
+{
+	while (count > 0) {
+		const ssize_t written = ::write(fd, data, count);
+		if (written < 0) {
+			throw std::runtime_error(system_error("write"));
+		}
+		data += written;
+		count -= static_cast<size_t>(written);
+	}
+}
+
+void VirtualMachine::run()
+{
+	scalars.assign(static_cast<size_t>(bytecode.scalar_count), 0);
+	matrices.clear();
+	for (const auto& dim : bytecode.matrices) {
+		matrices.push_back(Matrix{dim.rows, dim.cols,
+								  std::vector<double>(static_cast<size_t>(dim.rows) *
+													  static_cast<size_t>(dim.cols))});
+	}
+	out_buf.assign(out_bytes, 0);
+	out_len = 0;
+	bin_fd = -2;
+	//result of the kernels that may write to one of their operands
+	Matrix scratch{0, 0, std::vector<double>()};
+	const auto& code = bytecode.code;
+	size_t pc = 0;
+	while (pc < code.size()) {
+		const Instruction& ins = code[pc];
+		++pc;
+		switch (ins.op) {
+			case OpCode::LoadConstant:
+				scalars[ins.dst] = bytecode.constants[ins.a];
+				break;
+			case OpCode::MoveScalar:
+				scalars[ins.dst] = scalars[ins.a];
+				break;
+			case OpCode::MoveMatrix:
+				matrices[ins.dst].data = matrices[ins.a].data;
+				break;
+			case OpCode::Add:
+				scalars[ins.dst] = scalars[ins.a] + scalars[ins.b];
+				break;
+			case OpCode::Subtract:
+				scalars[ins.dst] = scalars[ins.a] - scalars[ins.b];
+				break;
+			case OpCode::Multiply:
+				scalars[ins.dst] = scalars[ins.a] * scalars[ins.b];
+				break;
+			case OpCode::MatrixAdd:
+			case OpCode::MatrixSubtract:
+			{
+				const auto& left = matrices[ins.a].data;
+				const auto& right = matrices[ins.b].data;
+				auto& result = matrices[ins.dst].data;
+				for (size_t i = 0; i < result.size(); ++i) {
+					result[i] = (ins.op == OpCode::MatrixAdd) ? left[i] + right[i]
+															  : left[i] - right[i];
+				}
+				break;
+			}
+			case OpCode::MatrixMultiply:
+				matrix_multiply(matrices[ins.a], matrices[ins.b], scratch);
+				matrices[ins.dst].data.swap(scratch.data);
+				break;
+			case OpCode::DotProduct:
+			{
+				const auto& left = matrices[ins.a].data;
+				const auto& right = matrices[ins.b].data;
+				double sum = 0;
+				for (size_t k = 0; k < left.size(); ++k) {
+					sum += left[k] * right[k];
+				}
+				scalars[ins.dst] = sum;
+				break;
+			}
+			case OpCode::ScalarMultiply:
+			{
+				const double scalar = scalars[ins.a];
+				const auto& matrix = matrices[ins.b].data;
+				auto& result = matrices[ins.dst].data;
+				for (size_t i = 0; i < result.size(); ++i) {
+					result[i] = scalar * matrix[i];
+				}
+				break;
+			}
+			case OpCode::Negate:
+			{
+				const auto& matrix = matrices[ins.a].data;
+				auto& result = matrices[ins.dst].data;
+				for (size_t i = 0; i < result.size(); ++i) {
+					result[i] = -matrix[i];
+				}
+				break;
+			}
+			case OpCode::Transpose:
+			{
+				const Matrix& matrix = matrices[ins.a];
+				scratch.data.resize(matrix.data.size());
+				for (int i = 0; i < matrix.rows; ++i) {
+					for (int j = 0; j < matrix.cols; ++j) {
+						scratch.data[static_cast<size_t>(j) * matrix.rows + i] =
+							matrix.data[static_cast<size_t>(i) * matrix.cols + j];
+					}
+				}
+				matrices[ins.dst].data.swap(scratch.data);
+				break;
+			}
+			case OpCode::Sqrt:
+				scalars[ins.dst] = std::sqrt(scalars[ins.a]);
+				break;
+			case OpCode::Choose:
+			{
+				const int condition = to_int(scalars[ins.a]);
+				scalars[ins.dst] = (condition == 0) ? scalars[ins.b]
+								 : (condition > 0) ? scalars[ins.c]
+												   : scalars[ins.d];
+				break;
+			}
+			case OpCode::ReadElement:
+			{
+				const Matrix& matrix = matrices[ins.a];
+				const int row = to_index(scalars[ins.b], matrix.rows, ins.line);
+				const int col = to_index(scalars[ins.c], matrix.cols, ins.line);
+				scalars[ins.dst] = matrix.data[static_cast<size_t>(row) * matrix.cols + col];
+				break;
+			}
+			case OpCode::WriteElement:
+			{
+				Matrix& matrix = matrices[ins.dst];
+				//(int)<expr> - 1
+				const int row = to_index(scalars[ins.a], INT_MAX, ins.line) - 1;
+				const int col = (ins.b < 0) ? 0
+											: to_index(scalars[ins.b], INT_MAX, ins.line) - 1;
+				if (row < 0 || row >= matrix.rows || col < 0 || col >= matrix.cols) {
+					throw std::runtime_error(line_error(ins.line, "Subscript out of bounds"));
+				}
+				matrix.data[static_cast<size_t>(row) * matrix.cols + col] = scalars[ins.c];
+				break;
+			}
+			case OpCode::SetElement:
+				matrices[ins.dst].data[ins.a] = scalars[ins.b];
+				break;
+			case OpCode::Print:
+				if (binary_out()) {
+					bin_record(1, 1, &scalars[ins.a]);
+				} else {
+					out_double(scalars[ins.a]);
+					out_str("\n");
+				}
+				break;
+			case OpCode::PrintMatrix:
+			{
+				const Matrix& matrix = matrices[ins.a];
+				if (binary_out()) {
+					bin_record(matrix.rows, matrix.cols, matrix.data.data());
+					break;
+				}
+				for (int i = 0; i < matrix.rows; ++i) {
+					for (int j = 0; j < matrix.cols; ++j) {
+						out_double(matrix.data[static_cast<size_t>(i) * matrix.cols + j]);
+						if (j != matrix.cols - 1)
+							out_str("\t");
+					}
+					out_str("\n");
+				}
+				break;
+			}
+			case OpCode::PrintSep:
+				if (binary_out())
+					bin_record(0, 0, nullptr);
+				else
+					out_str("----------\n");
+				break;
+			case OpCode::Load:
+				load(bytecode.strings[ins.a], matrices[ins.dst]);
+				break;
+			case OpCode::JumpIfNotLess:
+				if (!(scalars[ins.a] < scalars[ins.b]))
+					pc = static_cast<size_t>(ins.dst);
+				break;
+			case OpCode::Jump:
+				pc = static_cast<size_t>(ins.dst);
+				break;
+		}
+	}
+	out_flush();
+}
+
+/** Converts a scalar to int as the (int) cast of the compiled program does
+  * on x86-64. NaNs and the values out of the int range become INT_MIN.
+  */
+int VirtualMachine::to_int(double value)
+{
+	if (!(value > INT_MIN - 1.0 && value < INT_MAX + 1.0)) {
+		return INT_MIN;
+	}
+	return static_cast<int>(value);
+}
+
+/** Converts a scalar to int as a C cast does and checks that it is less
+  * than size. Negative values are only allowed if size is INT_MAX.
+  */
+int VirtualMachine::to_index(double value, int size, int line) const
+{
+	if (!(value > INT_MIN - 1.0 && value < INT_MAX + 1.0)) {
+		throw std::runtime_error(line_error(line, "Conversion to int out of range"));
+	}
+	const int result = static_cast<int>(value);
+	if (size != INT_MAX && (result < 0 || result >= size)) {
+		throw std::runtime_error(line_error(line, "Subscript out of bounds"));
+	}
+	return result;
+}
+
+/** Same order of additions as mat_mat_mul. */
+void VirtualMachine::matrix_multiply(const Matrix& left, const Matrix& right,
+									 Matrix& result)
+{
+	const size_t rows = static_cast<size_t>(left.rows);
+	const size_t common = static_cast<size_t>(left.cols);
+	const size_t cols = static_cast<size_t>(right.cols);
+	result.data.resize(rows * cols);
+	for (size_t i = 0; i < rows; ++i) {
+		for (size_t j = 0; j < cols; ++j) {
+			double sum = 0;
+			for (size_t k = 0; k < common; ++k) {
+				sum += left.data[i * common + k] * right.data[k * cols + j];
+			}
+			result.data[i * cols + j] = sum;
+		}
+	}
+}
+
+void VirtualMachine::load(const std::string& path, Matrix& matrix) const
+{
+	const std::string suffix = ".csv";
+	if (path.size() >= suffix.size() &&
+		path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0)
+	{
+		load_csv(path, matrix);
+	} else {
+		load_binary(path, matrix);
+	}
+}
+
+/** Reads the file as rt_load_csv does: in chunks, line by line. */
+void VirtualMachine::load_csv(const std::string& path, Matrix& matrix) const
+{
+	FILE* file = std::fopen(path.c_str(), "r");
+	if (file == nullptr) {
+		throw std::runtime_error(system_error(path));
+	}
+	std::vector<char> buf(csv_chunk + 1);
+	size_t len = 0;
+	int row = 0;
+	int line_num = 0;
+	bool eof = false;
+	try {
+		while (!eof) {
+			len += std::fread(buf.data() + len, 1, csv_chunk - len, file);
+			if (std::ferror(file)) {
+				throw std::runtime_error(system_error(path));
+			}
+			eof = std::feof(file) != 0;
+			char* p = buf.data();
+			char* const end = buf.data() + len;
+			*end = '\0';
+			//the last line of a chunk is kept for the next chunk unless it is
+			//the last line of the file
+			while (p != end) {
+				char* newline = static_cast<char*>(std::memchr(p, '\n',
+															   static_cast<size_t>(end - p)));
+				if (newline == nullptr) {
+					if (!eof)
+						break;
+					newline = end;
+				}
+				*newline = '\0';
+				++line_num;
+				//skip the blank lines
+				char* line = p;
+				while (*line == ' ' || *line == '\t' || *line == '\r')
+					++line;
+				if (*line != '\0') {
+					if (row >= matrix.rows) {
+						throw std::runtime_error(path + ":" + std::to_string(line_num) +
+												 ": too many rows");
+					}
+					double* const values = matrix.data.data() +
+										   static_cast<size_t>(row) * matrix.cols;
+					int j = 0;
+					for (; j < matrix.cols; ++j) {
+						char* value_end = nullptr;
+						values[j] = std::strtod(line, &value_end);
+						if (value_end == line)
+							break;
+						line = value_end;
+						while (*line == ' ' || *line == '\t' || *line == '\r')
+							++line;
+						if (j != matrix.cols - 1) {
+							if (*line != ',')
+								break;
+							++line;
+						}
+					}
+					if (j != matrix.cols || *line != '\0') {
+						throw std::runtime_error(path + ":" + std::to_string(line_num) +
+												 ": expected " +
+												 std::to_string(matrix.cols) + " values");
+					}
+					++row;
+				}
+				p = (newline == end) ? end : newline + 1;
+			}
+			if (p == buf.data() && len == csv_chunk) {
+				throw std::runtime_error(path + ":" + std::to_string(line_num + 1) +
+										 ": line is too long");
+			}
+			len = static_cast<size_t>(end - p);
+			std::memmove(buf.data(), p, len);
+		}
+	} catch (const std::runtime_error&) {
+		std::fclose(file);
+		throw;
+	}
+	std::fclose(file);
+	if (row != matrix.rows) {
+		throw std::runtime_error(path + ": expected " + std::to_string(matrix.rows) +
+								 " rows, found " + std::to_string(row));
+	}
+}
+
+/** Reads a binary record as rt_load_bin does. The size of the file is
+  * checked before its header.
+  */
+void VirtualMachine::load_binary(const std::string& path, Matrix& matrix) const
+{
+	const size_t bytes = matrix.data.size() * sizeof(double);
+	const std::string shape = std::to_string(matrix.rows) + "x" +
+							  std::to_string(matrix.cols);
+	FILE* file = std::fopen(path.c_str(), "rb");
+	if (file == nullptr) {
+		throw std::runtime_error(system_error(path));
+	}
+	std::vector<unsigned char> content(8 + bytes + 1);
+	const size_t size = std::fread(content.data(), 1, content.size(), file);
+	const bool failed = std::ferror(file) != 0;
+	std::fclose(file);
+	if (failed) {
+		throw std::runtime_error(system_error(path));
+	}
+	if (size != 8 + bytes) {
+		throw std::runtime_error(path + ": expected a " + shape + " matrix");
+	}
+	int32_t header[2] = {0, 0};
+	for (size_t i = 0; i < 2; ++i) {
+		uint32_t value = 0;
+		for (size_t k = 0; k < 4; ++k) {
+			value |= static_cast<uint32_t>(content[4 * i + k]) << (8 * k);
+		}
+		header[i] = static_cast<int32_t>(value);
+	}
+	if (header[0] != matrix.rows || header[1] != matrix.cols) {
+		throw std::runtime_error(path + ": expected a " + shape + " matrix, found " +
+								 std::to_string(header[0]) + "x" +
+								 std::to_string(header[1]));
+	}
+	for (size_t i = 0; i < matrix.data.size(); ++i) {
+		uint64_t bits = 0;
+		for (size_t k = 0; k < 8; ++k) {
+			bits |= static_cast<uint64_t>(content[8 + 8 * i + k]) << (8 * k);
+		}
+		std::memcpy(&matrix.data[i], &bits, sizeof(double));
+	}
+}
+
+/** Chooses the output mode at the first print as rt_binary_out does. */
+bool VirtualMachine::binary_out()
+{
+	if (bin_fd == -2) {
+		const char* path = std::getenv("MATLANG_BINARY_OUT");
+		if (path == nullptr || path[0] == '\0') {
+			bin_fd = -1;
+		} else if (std::strcmp(path, "-") == 0) {
+			bin_fd = 1;
+		} else {
+			bin_fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			if (bin_fd < 0) {
+				throw std::runtime_error(system_error(path));
+			}
+		}
+	}
+	return bin_fd >= 0;
+}
+
+void VirtualMachine::out_flush()
+{
+	if (bin_fd >= 0) {
+		write_all(bin_fd, out_buf.data(), out_len);
+	} else {
+		std::fwrite(out_buf.data(), 1, out_len, stdout);
+		std::fflush(stdout);
+	}
+	out_len = 0;
+}
+
+//returns the end of the buffer after making room for count characters
+char* VirtualMachine::out_reserve(size_t count)
+{
+	if (out_len + count > out_buf.size())
+		out_flush();
+	return out_buf.data() + out_len;
+}
+
+void VirtualMachine::out_str(const char* str)
+{
+	for (; *str; ++str) {
+		*out_reserve(1) = *str;
+		++out_len;
+	}
+}
+
+void VirtualMachine::out_double(double value)
+{
+	char* const out = out_reserve(32);
+	out_len += static_cast<size_t>(std::snprintf(out, 32, "%g", value));
+}
+
+/** Writes the header and the values in little endian order. Records larger
+  * than half of the buffer are written without a copy.
+  */
+void VirtualMachine::bin_record(int rows, int cols, const double* data)
+{
+	const size_t count = static_cast<size_t>(rows) * static_cast<size_t>(cols);
+	const int32_t header[2] = {rows, cols};
+	if (count * sizeof(double) > out_buf.size() / 2) {
+		std::vector<char> record(sizeof(header) + count * sizeof(double));
+		char* p = record.data();
+		for (const int32_t value : header) {
+			const uint32_t bits = static_cast<uint32_t>(value);
+			for (size_t k = 0; k < 4; ++k)
+				*p++ = static_cast<char>((bits >> (8 * k)) & 0xff);
+		}
+		for (size_t i = 0; i < count; ++i) {
+			uint64_t bits = 0;
+			std::memcpy(&bits, &data[i], sizeof(double));
+			for (size_t k = 0; k < 8; ++k)
+				*p++ = static_cast<char>((bits >> (8 * k)) & 0xff);
+		}
+		out_flush();
+		write_all(bin_fd, record.data(), record.size());
+		return;
+	}
+	for (const int32_t value : header) {
+		const uint32_t bits = static_cast<uint32_t>(value);
+		char* const out = out_reserve(4);
+		for (size_t k = 0; k < 4; ++k)
+			out[k] = static_cast<char>((bits >> (8 * k)) & 0xff);
+		out_len += 4;
+	}
+	for (size_t i = 0; i < count; ++i) {
+		uint64_t bits = 0;
+		std::memcpy(&bits, &data[i], sizeof(double));
+		char* const out = out_reserve(8);
+		for (size_t k = 0; k < 8; ++k)
+			out[k] = static_cast<char>((bits >> (8 * k)) & 0xff);
+		out_len += 8;
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "bytecode.hpp"
+
+/** Runs bytecode without compiling it to C.
+  *
+  * Kernels, printing and loading follow the helpers written into the
+  * generated C programs, thus the output of the VM is the output of the
+  * compiled program: printed values are formatted with %g, go through an
+  * output buffer of the same size and are written as binary records when
+  * MATLANG_BINARY_OUT is set.
+  *
+  * Errors are thrown as runtime_errors with the message the C program would
+  * print to stderr before exiting with status 1. Output still in the buffer
+  * is dropped just as the C program drops it. Reading out of the bounds of a
+  * matrix or converting a value out of the range of int is an error as well,
+  * although it is undefined in C.
+  */
+class VirtualMachine {
+public:
+	VirtualMachine(const Bytecode& t_bytecode)
+		: bytecode(t_bytecode)
+		, scalars()
+		, matrices()
+		, out_buf()
+		, out_len(0)
+		, bin_fd(-2)
+	{ };
+	void run();
+	//writes the buffered output. Called before an error of run is reported.
+	void out_flush();
+private:
+	struct Matrix {
+		int rows;
+		int cols;
+		std::vector<double> data;
+	};
+	static int to_int(double value);
+	int to_index(double value, int size, int line) const;
+	void matrix_multiply(const Matrix& left, const Matrix& right, Matrix& result);
+	void load(const std::string& path, Matrix& matrix) const;
+	void load_csv(const std::string& path, Matrix& matrix) const;
+	void load_binary(const std::string& path, Matrix& matrix) const;
+	/* OUTPUT */
+	bool binary_out();
+	char* out_reserve(size_t count);
+	void out_str(const char* str);
+	void out_double(double value);
+	void bin_record(int rows, int cols, const double* data);
+private:
+	const Bytecode bytecode;
+	std::vector<double> scalars;
+	std::vector<Matrix> matrices;
+	std::vector<char> out_buf;
+	size_t out_len;
+	//-2 if the output mode is not chosen yet, -1 for text output
+	int bin_fd;
+};
@@ -0,0 +1,81 @@
+#include "watcher.hpp"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <sys/stat.h>
+
+//time between two checks of the source file
+static const std::chrono::milliseconds poll_interval(100);
+
+//true if the file is replaced or modified after the first stat
+static bool changed(const struct stat& before, const struct stat& after)
+{
+	return before.st_ino != after.st_ino || before.st_size != after.st_size ||
+		   before.st_mtim.tv_sec != after.st_mtim.tv_sec ||
+		   before.st_mtim.tv_nsec != after.st_mtim.tv_nsec;
+}
+
+void Watcher::run()
+{
+	struct stat last;
+	bool exists = stat(source_name.c_str(), &last) == 0;
+	rebuild();
+	while (true) {
+		std::this_thread::sleep_for(poll_interval);
+		struct stat current;
+		//the file may be missing while an editor replaces it
+		if (stat(source_name.c_str(), &current) != 0 ||
+			(exists && !changed(last, current)))
+		{
+			continue;
+		}
+		last = current;
+		exists = true;
+		rebuild();
+	}
+}
+
+int Watcher::rebuild()
+{
+	const auto start = std::chrono::steady_clock::now();
+	std::ifstream source(source_name.c_str());
+	if (!source) {
+		std::cout << source_name << " couldn't be opened" << std::endl;
+		return -3;
+	}
+	const size_t hits = cache.hit_count();
+	const size_t misses = cache.miss_count();
+	SymbolTable sym_table;
+	std::ostringstream output;
+	try {
+		const auto program = compiler.parse(source, &sym_table, &cache);
+		CodeGenerator code_gen(&sym_table, options);
+		try {
+			code_gen.generate_c_code(program, output);
+		} catch (const std::runtime_error& e) {
+			throw CompileError(e.what(), -7);
+		}
+	} catch (const CompileError& e) {
+		std::cout << e.what() << std::endl;
+		return e.status;
+	}
+	//the lines of the previous versions aren't needed anymore
+	cache.evict();
+	std::ofstream ofs(output_name.c_str());
+	if (!(ofs << output.str())) {
+		std::cout << "Error: " << output_name
+			<< " couldn't be opened to write the output" << std::endl;
+		return -7;
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	const size_t parsed = cache.miss_count() - misses;
+	std::cout << "Compiled " << source_name << " to " << output_name << " in "
+			  << std::fixed << std::setprecision(3) << elapsed.count() << " s ("
+			  << parsed << " of " << parsed + cache.hit_count() - hits
+			  << " lines parsed)" << std::endl;
+	return 0;
+}
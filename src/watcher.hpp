@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include "code_generator.hpp"
+#include "compiler.hpp"
+
+/** Compiles a source file to C again each time it changes.
+  *
+  * The lines of the source are kept in a ParseCache, thus only the changed
+  * lines are lexed and parsed again. The symbol table is filled again from
+  * the declarations, and the program is checked and generated as a whole
+  * since the optimization passes work across the statements. The C file is
+  * only replaced if the source compiles.
+  */
+class Watcher {
+public:
+	Watcher(const std::string& t_source_name, const std::string& t_output_name,
+			const CodeGenOptions& t_options)
+		: source_name(t_source_name)
+		, output_name(t_output_name)
+		, options(t_options)
+		, compiler()
+		, cache()
+	{ };
+	//compiles the source whenever it changes until the process is killed
+	[[noreturn]] void run();
+	//compiles the source and prints the result. Returns the exit status of
+	//matlang2c for the source.
+	int rebuild();
+private:
+	const std::string source_name;
+	const std::string output_name;
+	const CodeGenOptions options;
+	Compiler compiler;
+	ParseCache cache;
+};
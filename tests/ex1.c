@@ -0,0 +1,300 @@
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/uio.h>
+void mat_mat_mul(int size1_1, int common_size, int size2_2, double mat1[size1_1][common_size], double mat2[common_size][size2_2], double result[size1_1][size2_2])
+{
+	int i;
+	int j;
+	int k;
+	for (i = 0; i < size1_1; ++i) {
+		for (j = 0; j < size2_2; ++j) {
+			double sum = 0;
+			for (k = 0; k < common_size; ++k) {
+				sum += mat1[i][k] * mat2[k][j];
+			}
+			result[i][j] = sum;
+		}
+	}
+}
+
+void mat_assign(int size1, int size2, double mat[size1][size2], double result[size1][size2])
+{
+	int i;
+	int j;
+	for (i = 0; i < size1; ++i) {
+		for (j = 0; j < size2; ++j) {
+			result[i][j] = mat[i][j];
+		}
+	}
+}
+#ifndef RT_OUT_BYTES
+#define RT_OUT_BYTES 65536
+#endif
+char rt_out_buf[RT_OUT_BYTES];
+int rt_out_len = 0;
+
+#ifndef RT_BINARY_OUT
+#define RT_BINARY_OUT 0
+#endif
+int rt_bin_fd = -2;
+
+int rt_binary_out()
+{
+	if (rt_bin_fd == -2) {
+		const char* path = getenv("MATLANG_BINARY_OUT");
+		if (path == 0)
+			path = RT_BINARY_OUT;
+		if (path == 0 || path[0] == '\0') {
+			rt_bin_fd = -1;
+		} else if (strcmp(path, "-") == 0) {
+			rt_bin_fd = 1;
+		} else {
+			rt_bin_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			if (rt_bin_fd < 0) {
+				perror(path);
+				exit(1);
+			}
+		}
+	}
+	return rt_bin_fd >= 0;
+}
+
+void rt_writev_all(struct iovec* iov, int count)
+{
+	while (count > 0) {
+		ssize_t written = writev(rt_bin_fd, iov, count);
+		if (written < 0) {
+			perror("writev");
+			_exit(1);
+		}
+		while (count > 0 && (size_t)written >= iov->iov_len) {
+			written -= (ssize_t)iov->iov_len;
+			++iov;
+			--count;
+		}
+		if (count > 0) {
+			iov->iov_base = (char*)iov->iov_base + written;
+			iov->iov_len -= (size_t)written;
+		}
+	}
+}
+
+void rt_out_flush()
+{
+	const int len = rt_out_len;
+	rt_out_len = 0;
+	if (rt_bin_fd >= 0) {
+		struct iovec iov;
+		iov.iov_base = rt_out_buf;
+		iov.iov_len = (size_t)len;
+		rt_writev_all(&iov, 1);
+	} else {
+		fwrite(rt_out_buf, 1, len, stdout);
+		fflush(stdout);
+	}
+}
+
+char* rt_out_reserve(int count)
+{
+	if (rt_out_len + count > RT_OUT_BYTES)
+		rt_out_flush();
+	return rt_out_buf + rt_out_len;
+}
+
+void rt_out_str(const char* str)
+{
+	for (; *str; ++str) {
+		*rt_out_reserve(1) = *str;
+		++rt_out_len;
+	}
+}
+
+const double rt_pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+void rt_out_double(double value)
+{
+	char* const out = rt_out_reserve(32);
+	char* p = out;
+	const double abs_value = fabs(value);
+	char digits[6];
+	int count = 6;
+	int exponent;
+	long scaled;
+	double m;
+	int i;
+	if (value < 0)
+		*p++ = '-';
+	if (abs_value < 1e6 && abs_value == (long)abs_value && (value != 0 || !signbit(value))) {
+		scaled = (long)abs_value;
+		i = 0;
+		do {
+			digits[i++] = (char)('0' + scaled % 10);
+			scaled /= 10;
+		} while (scaled != 0);
+		while (i > 0)
+			*p++ = digits[--i];
+		rt_out_len += (int)(p - out);
+		return;
+	}
+	if (!(abs_value >= 1e-15 && abs_value < 1e21)) {
+		rt_out_len += snprintf(out, 32, "%g", value);
+		return;
+	}
+	exponent = (int)floor(log10(abs_value));
+	for (i = 0; i < 2; ++i) {
+		m = (exponent <= 5) ? abs_value * rt_pow10[5 - exponent] : abs_value / rt_pow10[exponent - 5];
+		if (m < 1e5)
+			--exponent;
+		else if (m >= 1e6)
+			++exponent;
+		else
+			break;
+	}
+	if (fabs(m - floor(m) - 0.5) < 1e-6) {
+		rt_out_len += snprintf(out, 32, "%g", value);
+		return;
+	}
+	scaled = (long)(m + 0.5);
+	if (scaled == 1000000) {
+		scaled = 100000;
+		++exponent;
+	}
+	for (i = 5; i >= 0; --i) {
+		digits[i] = (char)('0' + scaled % 10);
+		scaled /= 10;
+	}
+	while (count > 1 && digits[count - 1] == '0')
+		--count;
+	if (exponent >= -4 && exponent < 6) {
+		if (exponent < 0) {
+			*p++ = '0';
+			*p++ = '.';
+			for (i = -1; i > exponent; --i)
+				*p++ = '0';
+			for (i = 0; i < count; ++i)
+				*p++ = digits[i];
+		} else {
+			for (i = 0; i <= exponent; ++i)
+				*p++ = digits[i];
+			if (count > exponent + 1)
+				*p++ = '.';
+			for (; i < count; ++i)
+				*p++ = digits[i];
+		}
+	} else {
+		*p++ = digits[0];
+		if (count > 1)
+			*p++ = '.';
+		for (i = 1; i < count; ++i)
+			*p++ = digits[i];
+		*p++ = 'e';
+		*p++ = (exponent < 0) ? '-' : '+';
+		exponent = (exponent < 0) ? -exponent : exponent;
+		*p++ = (char)('0' + exponent / 10);
+		*p++ = (char)('0' + exponent % 10);
+	}
+	rt_out_len += (int)(p - out);
+}
+
+void rt_bin_put(const void* value, int size)
+{
+	char* const out = rt_out_reserve(size);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	int i;
+	for (i = 0; i < size; ++i)
+		out[i] = ((const char*)value)[size - 1 - i];
+#else
+	memcpy(out, value, (size_t)size);
+#endif
+	rt_out_len += size;
+}
+
+void rt_bin_record(int rows, int cols, const double* data)
+{
+	const int32_t header[2] = {rows, cols};
+	const size_t bytes = (size_t)rows * (size_t)cols * sizeof(double);
+	size_t i;
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__
+	if (bytes > RT_OUT_BYTES / 2) {
+		struct iovec iov[2];
+		rt_out_flush();
+		iov[0].iov_base = (void*)header;
+		iov[0].iov_len = sizeof(header);
+		iov[1].iov_base = (void*)data;
+		iov[1].iov_len = bytes;
+		rt_writev_all(iov, 2);
+		return;
+	}
+#endif
+	rt_bin_put(&header[0], 4);
+	rt_bin_put(&header[1], 4);
+	for (i = 0; i < bytes / sizeof(double); ++i)
+		rt_bin_put(&data[i], sizeof(double));
+}
+
+void print(double value)
+{
+	if (rt_binary_out()) {
+		rt_bin_record(1, 1, &value);
+		return;
+	}
+	rt_out_double(value);
+	rt_out_str("\n");
+}
+
+void print_mat(int size1, int size2, double matrix[size1][size2])
+{
+	int i;
+	int j;
+	if (rt_binary_out()) {
+		rt_bin_record(size1, size2, &matrix[0][0]);
+		return;
+	}
+	for (i = 0; i < size1; ++i) {
+		for (j = 0; j < size2; ++j) {
+			rt_out_double(matrix[i][j]);
+			if (j != size2 - 1)
+				rt_out_str("\t");
+		}
+		rt_out_str("\n");
+	}
+}
+
+int main()
+{
+	atexit(rt_out_flush);
+	double i;
+	double n;
+	double x[2][1];
+	double y[2][1];
+	double A[2][2];
+	double B[2][2];
+	static const double _E4_5[2] = {
+		1, 1
+	};
+	memcpy(&x[0][0], _E4_5, sizeof(_E4_5));
+	static const double _E4_6[4] = {
+		1, 1, 1, 0
+	};
+	memcpy(&A[0][0], _E4_6, sizeof(_E4_6));
+	static const double _E4_7[4] = {
+		1, 0, 0, 1
+	};
+	memcpy(&B[0][0], _E4_7, sizeof(_E4_7));
+	print_mat(2, 1, x);
+	for (i = 1; i < 10.0 + 1; i += 1) {
+		double _E4_8[2][2];
+		mat_mat_mul(2, 2, 2, A, B, _E4_8);
+		mat_assign(2, 2, _E4_8, B);
+		double _E4_9[2][1];
+		mat_mat_mul(2, 2, 1, B, x, _E4_9);
+		mat_assign(2, 1, _E4_9, y);
+		print(y[(int)(1-1)][(int)0]);
+	}
+	return 0;
+}
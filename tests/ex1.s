@@ -0,0 +1,187 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$48, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 12
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 12
+	movsd	%xmm2, .Lm0+0(%rip)
+	# line 12
+	movsd	.Lc1(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 12
+	movsd	%xmm3, .Lm0+8(%rip)
+	# line 13
+	movsd	.Lc2(%rip), %xmm4
+	movsd	%xmm4, -16(%rbp)
+	# line 13
+	movsd	%xmm4, .Lm1+0(%rip)
+	# line 13
+	movsd	.Lc3(%rip), %xmm3
+	movsd	%xmm3, -8(%rbp)
+	# line 13
+	movsd	%xmm3, .Lm1+8(%rip)
+	# line 13
+	movsd	.Lc4(%rip), %xmm2
+	movsd	%xmm2, -24(%rbp)
+	# line 13
+	movsd	%xmm2, .Lm1+16(%rip)
+	# line 13
+	movsd	.Lc5(%rip), %xmm5
+	movsd	%xmm5, -32(%rbp)
+	# line 13
+	movsd	%xmm5, .Lm1+24(%rip)
+	# line 14
+	movsd	.Lc6(%rip), %xmm6
+	movsd	%xmm6, -32(%rbp)
+	# line 14
+	movsd	%xmm6, .Lm2+0(%rip)
+	# line 14
+	movsd	.Lc7(%rip), %xmm5
+	movsd	%xmm5, -24(%rbp)
+	# line 14
+	movsd	%xmm5, .Lm2+8(%rip)
+	# line 14
+	movsd	.Lc8(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 14
+	movsd	%xmm2, .Lm2+16(%rip)
+	# line 14
+	movsd	.Lc9(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 14
+	movsd	%xmm3, .Lm2+24(%rip)
+	# line 15
+	movl	$2, %edi
+	movl	$1, %esi
+	leaq	.Lm0(%rip), %rdx
+	call	print_mat@PLT
+	# line 16
+	movsd	.Lc10(%rip), %xmm2
+	movsd	%xmm2, -40(%rbp)
+.Lpc22:
+	# line 16
+	movsd	.Lc11(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 16
+	movsd	.Lc12(%rip), %xmm3
+	movsd	%xmm3, -24(%rbp)
+	# line 16
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -16(%rbp)
+	# line 16
+	movsd	-40(%rbp), %xmm5
+	ucomisd	%xmm5, %xmm4
+	jbe	.Lpc35
+	# line 17
+	movl	$2, %edi
+	movl	$2, %esi
+	movl	$2, %edx
+	leaq	.Lm1(%rip), %rcx
+	leaq	.Lm2(%rip), %r8
+	leaq	.Lscratch(%rip), %r9
+	call	mat_mat_mul@PLT
+	movl	$2, %edi
+	movl	$2, %esi
+	leaq	.Lscratch(%rip), %rdx
+	leaq	.Lm2(%rip), %rcx
+	call	mat_assign@PLT
+	# line 18
+	movl	$2, %edi
+	movl	$2, %esi
+	movl	$1, %edx
+	leaq	.Lm2(%rip), %rcx
+	leaq	.Lm0(%rip), %r8
+	leaq	.Lm3(%rip), %r9
+	call	mat_mat_mul@PLT
+	# line 19
+	movsd	.Lc13(%rip), %xmm2
+	movsd	%xmm2, -24(%rbp)
+	# line 19
+	movsd	.Lc14(%rip), %xmm3
+	movsd	%xmm3, -8(%rbp)
+	# line 19
+	cvttsd2si	%xmm2, %eax
+	cvttsd2si	%xmm3, %ecx
+	imull	$1, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm3(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm4
+	movsd	%xmm4, -16(%rbp)
+	# line 19
+	movapd	%xmm4, %xmm0
+	call	print@PLT
+	# line 16
+	movsd	.Lc15(%rip), %xmm2
+	movsd	%xmm2, -16(%rbp)
+	# line 16
+	movsd	-40(%rbp), %xmm3
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -40(%rbp)
+	# line 16
+	jmp	.Lpc22
+.Lpc35:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	4607182418800017408
+.Lc1:
+	.quad	4607182418800017408
+.Lc2:
+	.quad	4607182418800017408
+.Lc3:
+	.quad	4607182418800017408
+.Lc4:
+	.quad	4607182418800017408
+.Lc5:
+	.quad	0
+.Lc6:
+	.quad	4607182418800017408
+.Lc7:
+	.quad	0
+.Lc8:
+	.quad	0
+.Lc9:
+	.quad	4607182418800017408
+.Lc10:
+	.quad	4607182418800017408
+.Lc11:
+	.quad	4607182418800017408
+.Lc12:
+	.quad	4621819117588971520
+.Lc13:
+	.quad	0
+.Lc14:
+	.quad	0
+.Lc15:
+	.quad	4607182418800017408
+	.bss
+	.balign	32
+.Lm0:
+	.zero	16
+	.balign	32
+.Lm1:
+	.zero	32
+	.balign	32
+.Lm2:
+	.zero	32
+	.balign	32
+.Lm3:
+	.zero	16
+	.balign	32
+.Lscratch:
+	.zero	32
+	.section	.note.GNU-stack,"",@progbits
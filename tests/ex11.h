@@ -0,0 +1,41 @@
+#ifndef EX11_H
+#define EX11_H
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/uio.h>
+void tr_rec(int rows, int cols, const double* src, int src_stride, double* dst, int dst_stride);
+void mat_mat_mul(int size1_1, int common_size, int size2_2, double mat1[size1_1][common_size], double mat2[common_size][size2_2], double result[size1_1][size2_2]);
+void mat_assign(int size1, int size2, double mat[size1][size2], double result[size1][size2]);
+void tr(int size1, int size2, double matrix[size1][size2], double result[size2][size1]);
+int rt_binary_out();
+void rt_writev_all(struct iovec* iov, int count);
+void rt_out_flush();
+char* rt_out_reserve(int count);
+void rt_out_str(const char* str);
+void rt_out_double(double value);
+void rt_bin_put(const void* value, int size);
+void rt_bin_record(int rows, int cols, const double* data);
+void print_mat(int size1, int size2, double matrix[size1][size2]);
+void printsep();
+int rt_csv_line(char* line, const char* path, int line_num, int cols, double* row);
+double* rt_load_csv(const char* path, int rows, int cols, double* storage);
+struct rt_state {
+	double _E4_2[3][4];
+	double (*A)[4];
+	double G[4][4];
+	double w[4][1];
+	double i;
+};
+void rt_part_1(struct rt_state* rt_s);
+void rt_part_2(struct rt_state* rt_s);
+void rt_part_3(struct rt_state* rt_s);
+void rt_part_4(struct rt_state* rt_s);
+void rt_part_5(struct rt_state* rt_s);
+void rt_part_6(struct rt_state* rt_s);
+void rt_part_7(struct rt_state* rt_s);
+#endif
@@ -0,0 +1,182 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$128, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 8
+	leaq	.Ls0(%rip), %rdi
+	movl	$3, %esi
+	movl	$4, %edx
+	leaq	.Lm0(%rip), %rcx
+	call	rt_load_csv@PLT
+	# line 9
+	movl	$3, %edi
+	movl	$4, %esi
+	leaq	.Lm0(%rip), %rdx
+	call	print_mat@PLT
+	# line 10
+	call	printsep@PLT
+	# line 11
+	movl	$3, %edi
+	movl	$4, %esi
+	leaq	.Lm0(%rip), %rdx
+	leaq	.Lm2(%rip), %rcx
+	call	tr@PLT
+	# line 11
+	movl	$4, %edi
+	movl	$3, %esi
+	movl	$4, %edx
+	leaq	.Lm2(%rip), %rcx
+	leaq	.Lm0(%rip), %r8
+	leaq	.Lm1(%rip), %r9
+	call	mat_mat_mul@PLT
+	# line 12
+	movl	$4, %edi
+	movl	$4, %esi
+	leaq	.Lm1(%rip), %rdx
+	call	print_mat@PLT
+	# line 13
+	call	printsep@PLT
+	# line 15
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+.Lpc8:
+	# line 15
+	movsd	.Lc1(%rip), %xmm2
+	movsd	%xmm2, -16(%rbp)
+	# line 15
+	movsd	-8(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc28
+	# line 16
+	movsd	.Lc2(%rip), %xmm4
+	movsd	%xmm4, -16(%rbp)
+	# line 16
+	movsd	.Lc3(%rip), %xmm2
+	movsd	%xmm2, -24(%rbp)
+	# line 16
+	movapd	%xmm3, %xmm5
+	subsd	%xmm2, %xmm5
+	movsd	%xmm5, -32(%rbp)
+	# line 16
+	cvttsd2si	%xmm4, %eax
+	cvttsd2si	%xmm5, %ecx
+	imull	$4, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm6
+	movsd	%xmm6, -40(%rbp)
+	# line 16
+	movsd	.Lc4(%rip), %xmm7
+	movsd	%xmm7, -48(%rbp)
+	# line 16
+	movsd	.Lc5(%rip), %xmm8
+	movsd	%xmm8, -56(%rbp)
+	# line 16
+	movapd	%xmm3, %xmm9
+	subsd	%xmm8, %xmm9
+	movsd	%xmm9, -64(%rbp)
+	# line 16
+	cvttsd2si	%xmm7, %eax
+	cvttsd2si	%xmm9, %ecx
+	imull	$4, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm10
+	movsd	%xmm10, -72(%rbp)
+	# line 16
+	movsd	.Lc6(%rip), %xmm11
+	movsd	%xmm11, -80(%rbp)
+	# line 16
+	movsd	.Lc7(%rip), %xmm12
+	movsd	%xmm12, -88(%rbp)
+	# line 16
+	movapd	%xmm3, %xmm13
+	subsd	%xmm12, %xmm13
+	movsd	%xmm13, -96(%rbp)
+	# line 16
+	cvttsd2si	%xmm11, %eax
+	cvttsd2si	%xmm13, %ecx
+	imull	$4, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm14
+	movsd	%xmm14, -104(%rbp)
+	# line 16
+	movapd	%xmm10, %xmm15
+	addsd	%xmm14, %xmm15
+	movsd	%xmm15, -112(%rbp)
+	# line 16
+	movapd	%xmm6, %xmm2
+	addsd	%xmm15, %xmm2
+	movsd	%xmm2, -120(%rbp)
+	# line 16
+	cvttsd2si	%xmm3, %eax
+	subl	$1, %eax
+	imull	$1, %eax, %eax
+	cltq
+	leaq	.Lm3(%rip), %rdx
+	movsd	%xmm2, (%rdx,%rax,8)
+	# line 15
+	movsd	.Lc8(%rip), %xmm4
+	movsd	%xmm4, -120(%rbp)
+	# line 15
+	movapd	%xmm3, %xmm2
+	addsd	%xmm4, %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 15
+	jmp	.Lpc8
+.Lpc28:
+	# line 18
+	movl	$4, %edi
+	movl	$1, %esi
+	leaq	.Lm3(%rip), %rdx
+	call	print_mat@PLT
+.Lpc29:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	4607182418800017408
+.Lc1:
+	.quad	4617315517961601024
+.Lc2:
+	.quad	0
+.Lc3:
+	.quad	4607182418800017408
+.Lc4:
+	.quad	4607182418800017408
+.Lc5:
+	.quad	4607182418800017408
+.Lc6:
+	.quad	4611686018427387904
+.Lc7:
+	.quad	4607182418800017408
+.Lc8:
+	.quad	4607182418800017408
+.Ls0:
+	.string	"tests/ex11.csv"
+	.bss
+	.balign	32
+.Lm0:
+	.zero	96
+	.balign	32
+.Lm1:
+	.zero	128
+	.balign	32
+.Lm2:
+	.zero	96
+	.balign	32
+.Lm3:
+	.zero	32
+	.section	.note.GNU-stack,"",@progbits
@@ -0,0 +1,129 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$48, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 8
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 8
+	movsd	%xmm2, .Lm0+0(%rip)
+	# line 8
+	movsd	.Lc1(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 8
+	movsd	%xmm3, .Lm0+8(%rip)
+	# line 10
+	movsd	.Lc2(%rip), %xmm4
+	movsd	%xmm4, -16(%rbp)
+	# line 10
+	movsd	.Lc3(%rip), %xmm3
+	movsd	%xmm3, -8(%rbp)
+	# line 10
+	movsd	.Lc4(%rip), %xmm2
+	movsd	%xmm2, -24(%rbp)
+	# line 10
+	movsd	.Lc5(%rip), %xmm5
+	movsd	%xmm5, -32(%rbp)
+	# line 10
+	movapd	%xmm2, %xmm6
+	subsd	%xmm5, %xmm6
+	movsd	%xmm6, -40(%rbp)
+	# line 10
+	sqrtsd	%xmm6, %xmm7
+	movsd	%xmm7, -48(%rbp)
+	# line 10
+	cvttsd2si	%xmm4, %eax
+	subl	$1, %eax
+	imull	$2, %eax, %eax
+	cvttsd2si	%xmm3, %ecx
+	subl	$1, %ecx
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	%xmm7, (%rdx,%rax,8)
+	# line 11
+	movsd	.Lc6(%rip), %xmm8
+	movsd	%xmm8, -48(%rbp)
+	# line 11
+	movsd	.Lc7(%rip), %xmm7
+	movsd	%xmm7, -40(%rbp)
+	# line 11
+	movsd	.Lc8(%rip), %xmm6
+	movsd	%xmm6, -32(%rbp)
+	# line 11
+	cvttsd2si	%xmm8, %eax
+	subl	$1, %eax
+	imull	$2, %eax, %eax
+	cvttsd2si	%xmm7, %ecx
+	subl	$1, %ecx
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	%xmm6, (%rdx,%rax,8)
+	# line 12
+	movsd	.Lc9(%rip), %xmm5
+	movsd	%xmm5, -32(%rbp)
+	# line 12
+	movl	$1, %edi
+	movl	$2, %esi
+	leaq	.Lm1(%rip), %rdx
+	leaq	.Lm3(%rip), %rcx
+	call	neg_mat@PLT
+	# line 12
+	movl	$1, %edi
+	movl	$2, %esi
+	leaq	.Lm0(%rip), %rdx
+	leaq	.Lm3(%rip), %rcx
+	leaq	.Lm2(%rip), %r8
+	call	mat_mat_add@PLT
+	# line 13
+	movl	$1, %edi
+	movl	$2, %esi
+	leaq	.Lm2(%rip), %rdx
+	call	print_mat@PLT
+.Lpc19:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	4607182418800017408
+.Lc1:
+	.quad	4611686018427387904
+.Lc2:
+	.quad	4607182418800017408
+.Lc3:
+	.quad	4607182418800017408
+.Lc4:
+	.quad	0
+.Lc5:
+	.quad	4607182418800017408
+.Lc6:
+	.quad	4607182418800017408
+.Lc7:
+	.quad	4611686018427387904
+.Lc8:
+	.quad	4607182418800017408
+.Lc9:
+	.quad	0
+	.bss
+	.balign	32
+.Lm0:
+	.zero	16
+	.balign	32
+.Lm1:
+	.zero	16
+	.balign	32
+.Lm2:
+	.zero	16
+	.balign	32
+.Lm3:
+	.zero	16
+	.section	.note.GNU-stack,"",@progbits
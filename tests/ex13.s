@@ -0,0 +1,72 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 6
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 6
+	movsd	%xmm2, .Lm0+0(%rip)
+	# line 6
+	movsd	.Lc1(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 6
+	movsd	%xmm3, .Lm0+8(%rip)
+	# line 6
+	movsd	.Lc2(%rip), %xmm4
+	movsd	%xmm4, -24(%rbp)
+	# line 6
+	movsd	%xmm4, .Lm0+16(%rip)
+	# line 6
+	movsd	.Lc3(%rip), %xmm5
+	movsd	%xmm5, -32(%rbp)
+	# line 6
+	movsd	%xmm5, .Lm0+24(%rip)
+	# line 7
+	movl	$2, %edi
+	movl	$2, %esi
+	leaq	.Lm0(%rip), %rdx
+	call	print_mat@PLT
+	# line 8
+	call	printsep@PLT
+	# line 9
+	leaq	.Ls0(%rip), %rdi
+	movl	$3, %esi
+	movl	$1, %edx
+	leaq	.Lm1(%rip), %rcx
+	call	rt_load_csv@PLT
+	# line 10
+	movl	$3, %edi
+	movl	$1, %esi
+	leaq	.Lm1(%rip), %rdx
+	call	print_mat@PLT
+.Lpc12:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	4607182418800017408
+.Lc1:
+	.quad	4611686018427387904
+.Lc2:
+	.quad	4613937818241073152
+.Lc3:
+	.quad	4616189618054758400
+.Ls0:
+	.string	"tests/ex13_missing.csv"
+	.bss
+	.balign	32
+.Lm0:
+	.zero	32
+	.balign	32
+.Lm1:
+	.zero	24
+	.section	.note.GNU-stack,"",@progbits
@@ -0,0 +1,241 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$96, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 6
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 6
+	movsd	%xmm2, .Lm0+0(%rip)
+	# line 6
+	movsd	.Lc1(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 6
+	movsd	%xmm3, .Lm0+8(%rip)
+	# line 6
+	movsd	.Lc2(%rip), %xmm4
+	movsd	%xmm4, -24(%rbp)
+	# line 6
+	movsd	%xmm4, .Lm0+16(%rip)
+	# line 7
+	movsd	.Lc3(%rip), %xmm5
+	movsd	%xmm5, -24(%rbp)
+	# line 7
+	movsd	.Lc4(%rip), %xmm4
+	movsd	%xmm4, -16(%rbp)
+	# line 7
+	cvttsd2si	%xmm5, %eax
+	cvttsd2si	%xmm4, %ecx
+	imull	$1, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm3
+	movsd	%xmm3, -8(%rbp)
+	# line 7
+	movsd	%xmm3, .Lm0+0(%rip)
+	# line 7
+	movsd	.Lc5(%rip), %xmm2
+	movsd	%xmm2, -32(%rbp)
+	# line 7
+	movsd	%xmm2, .Lm0+8(%rip)
+	# line 7
+	movsd	.Lc6(%rip), %xmm6
+	movsd	%xmm6, -40(%rbp)
+	# line 7
+	movsd	%xmm6, .Lm0+16(%rip)
+	# line 8
+	movl	$3, %edi
+	movl	$1, %esi
+	leaq	.Lm0(%rip), %rdx
+	call	print_mat@PLT
+	# line 9
+	call	printsep@PLT
+	# line 10
+	movsd	.Lc7(%rip), %xmm2
+	movsd	%xmm2, -40(%rbp)
+	# line 10
+	movsd	%xmm2, .Lm0+0(%rip)
+	# line 10
+	movsd	.Lc8(%rip), %xmm3
+	movsd	%xmm3, -32(%rbp)
+	# line 10
+	movsd	.Lc9(%rip), %xmm4
+	movsd	%xmm4, -8(%rbp)
+	# line 10
+	cvttsd2si	%xmm3, %eax
+	cvttsd2si	%xmm4, %ecx
+	imull	$1, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm5
+	movsd	%xmm5, -16(%rbp)
+	# line 10
+	movsd	%xmm5, .Lm0+8(%rip)
+	# line 10
+	movsd	.Lc10(%rip), %xmm6
+	movsd	%xmm6, -24(%rbp)
+	# line 10
+	movsd	%xmm6, .Lm0+16(%rip)
+	# line 11
+	movl	$3, %edi
+	movl	$1, %esi
+	leaq	.Lm0(%rip), %rdx
+	call	print_mat@PLT
+	# line 12
+	call	printsep@PLT
+	# line 13
+	movsd	.Lc11(%rip), %xmm2
+	movsd	%xmm2, -24(%rbp)
+	# line 13
+	movsd	%xmm2, .Lm1+0(%rip)
+	# line 13
+	movsd	.Lc12(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 13
+	movsd	%xmm3, .Lm1+8(%rip)
+	# line 13
+	movsd	.Lc13(%rip), %xmm4
+	movsd	%xmm4, -8(%rbp)
+	# line 13
+	movsd	%xmm4, .Lm1+16(%rip)
+	# line 13
+	movsd	.Lc14(%rip), %xmm5
+	movsd	%xmm5, -32(%rbp)
+	# line 13
+	movsd	%xmm5, .Lm1+24(%rip)
+	# line 14
+	movsd	.Lc15(%rip), %xmm6
+	movsd	%xmm6, -32(%rbp)
+	# line 14
+	movsd	.Lc16(%rip), %xmm5
+	movsd	%xmm5, -8(%rbp)
+	# line 14
+	cvttsd2si	%xmm6, %eax
+	cvttsd2si	%xmm5, %ecx
+	imull	$2, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm4
+	movsd	%xmm4, -16(%rbp)
+	# line 14
+	movsd	%xmm4, .Lm1+0(%rip)
+	# line 14
+	movsd	.Lc17(%rip), %xmm3
+	movsd	%xmm3, -24(%rbp)
+	# line 14
+	movsd	%xmm3, .Lm1+8(%rip)
+	# line 14
+	movsd	.Lc18(%rip), %xmm2
+	movsd	%xmm2, -40(%rbp)
+	# line 14
+	movsd	.Lc19(%rip), %xmm7
+	movsd	%xmm7, -48(%rbp)
+	# line 14
+	cvttsd2si	%xmm2, %eax
+	cvttsd2si	%xmm7, %ecx
+	imull	$2, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm8
+	movsd	%xmm8, -56(%rbp)
+	# line 14
+	movsd	.Lc20(%rip), %xmm9
+	movsd	%xmm9, -64(%rbp)
+	# line 14
+	movapd	%xmm8, %xmm10
+	addsd	%xmm9, %xmm10
+	movsd	%xmm10, -72(%rbp)
+	# line 14
+	movsd	%xmm10, .Lm1+16(%rip)
+	# line 14
+	movsd	.Lc21(%rip), %xmm11
+	movsd	%xmm11, -80(%rbp)
+	# line 14
+	movsd	.Lc22(%rip), %xmm12
+	movsd	%xmm12, -88(%rbp)
+	# line 14
+	cvttsd2si	%xmm11, %eax
+	cvttsd2si	%xmm12, %ecx
+	imull	$2, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm13
+	movsd	%xmm13, -96(%rbp)
+	# line 14
+	movsd	%xmm13, .Lm1+24(%rip)
+	# line 15
+	movl	$2, %edi
+	movl	$2, %esi
+	leaq	.Lm1(%rip), %rdx
+	call	print_mat@PLT
+.Lpc51:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	4607182418800017408
+.Lc1:
+	.quad	4611686018427387904
+.Lc2:
+	.quad	4613937818241073152
+.Lc3:
+	.quad	4611686018427387904
+.Lc4:
+	.quad	0
+.Lc5:
+	.quad	4617315517961601024
+.Lc6:
+	.quad	4619567317775286272
+.Lc7:
+	.quad	4616189618054758400
+.Lc8:
+	.quad	0
+.Lc9:
+	.quad	0
+.Lc10:
+	.quad	4618441417868443648
+.Lc11:
+	.quad	4607182418800017408
+.Lc12:
+	.quad	4611686018427387904
+.Lc13:
+	.quad	4613937818241073152
+.Lc14:
+	.quad	4616189618054758400
+.Lc15:
+	.quad	4607182418800017408
+.Lc16:
+	.quad	4607182418800017408
+.Lc17:
+	.quad	0
+.Lc18:
+	.quad	0
+.Lc19:
+	.quad	0
+.Lc20:
+	.quad	4619567317775286272
+.Lc21:
+	.quad	0
+.Lc22:
+	.quad	4607182418800017408
+	.bss
+	.balign	32
+.Lm0:
+	.zero	24
+	.balign	32
+.Lm1:
+	.zero	32
+	.section	.note.GNU-stack,"",@progbits
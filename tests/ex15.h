@@ -0,0 +1,45 @@
+#ifndef EX15_H
+#define EX15_H
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/uio.h>
+int rt_binary_out();
+void rt_writev_all(struct iovec* iov, int count);
+void rt_out_flush();
+char* rt_out_reserve(int count);
+void rt_out_str(const char* str);
+void rt_out_double(double value);
+void rt_bin_put(const void* value, int size);
+void rt_bin_record(int rows, int cols, const double* data);
+void print(double value);
+void print_mat(int size1, int size2, double matrix[size1][size2]);
+void printsep();
+struct rt_state {
+	double A[4][4];
+	double B[4][4];
+	double v[4][1];
+	double i;
+	double j;
+	double s;
+	double t;
+	double u;
+};
+void rt_part_1(struct rt_state* rt_s);
+void rt_part_2(struct rt_state* rt_s);
+void rt_part_3(struct rt_state* rt_s);
+void rt_part_4(struct rt_state* rt_s);
+void rt_part_5(struct rt_state* rt_s);
+void rt_part_6(struct rt_state* rt_s);
+void rt_part_7(struct rt_state* rt_s);
+void rt_part_8(struct rt_state* rt_s);
+void rt_part_9(struct rt_state* rt_s);
+void rt_part_10(struct rt_state* rt_s);
+void rt_part_11(struct rt_state* rt_s);
+void rt_part_12(struct rt_state* rt_s);
+void rt_part_13(struct rt_state* rt_s);
+#endif
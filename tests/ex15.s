@@ -0,0 +1,416 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$176, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 13
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 13
+	movsd	%xmm2, .Lm0+0(%rip)
+	# line 13
+	movsd	.Lc1(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 13
+	movsd	%xmm3, .Lm0+8(%rip)
+	# line 13
+	movsd	.Lc2(%rip), %xmm4
+	movsd	%xmm4, -24(%rbp)
+	# line 13
+	movsd	%xmm4, .Lm0+16(%rip)
+	# line 13
+	movsd	.Lc3(%rip), %xmm5
+	movsd	%xmm5, -32(%rbp)
+	# line 13
+	movsd	%xmm5, .Lm0+24(%rip)
+	# line 13
+	movsd	.Lc4(%rip), %xmm6
+	movsd	%xmm6, -40(%rbp)
+	# line 13
+	movsd	%xmm6, .Lm0+32(%rip)
+	# line 13
+	movsd	.Lc5(%rip), %xmm7
+	movsd	%xmm7, -48(%rbp)
+	# line 13
+	movsd	%xmm7, .Lm0+40(%rip)
+	# line 13
+	movsd	.Lc6(%rip), %xmm8
+	movsd	%xmm8, -56(%rbp)
+	# line 13
+	movsd	%xmm8, .Lm0+48(%rip)
+	# line 13
+	movsd	.Lc7(%rip), %xmm9
+	movsd	%xmm9, -64(%rbp)
+	# line 13
+	movsd	%xmm9, .Lm0+56(%rip)
+	# line 13
+	movsd	.Lc8(%rip), %xmm10
+	movsd	%xmm10, -72(%rbp)
+	# line 13
+	movsd	%xmm10, .Lm0+64(%rip)
+	# line 13
+	movsd	.Lc9(%rip), %xmm11
+	movsd	%xmm11, -80(%rbp)
+	# line 13
+	movsd	%xmm11, .Lm0+72(%rip)
+	# line 13
+	movsd	.Lc10(%rip), %xmm12
+	movsd	%xmm12, -88(%rbp)
+	# line 13
+	movsd	%xmm12, .Lm0+80(%rip)
+	# line 13
+	movsd	.Lc11(%rip), %xmm13
+	movsd	%xmm13, -96(%rbp)
+	# line 13
+	movsd	%xmm13, .Lm0+88(%rip)
+	# line 13
+	movsd	.Lc12(%rip), %xmm14
+	movsd	%xmm14, -104(%rbp)
+	# line 13
+	movsd	%xmm14, .Lm0+96(%rip)
+	# line 13
+	movsd	.Lc13(%rip), %xmm15
+	movsd	%xmm15, -112(%rbp)
+	# line 13
+	movsd	%xmm15, .Lm0+104(%rip)
+	# line 13
+	movsd	.Lc14(%rip), %xmm2
+	movsd	%xmm2, -120(%rbp)
+	# line 13
+	movsd	%xmm2, .Lm0+112(%rip)
+	# line 13
+	movsd	.Lc15(%rip), %xmm3
+	movsd	%xmm3, -128(%rbp)
+	# line 13
+	movsd	%xmm3, .Lm0+120(%rip)
+	# line 14
+	movsd	.Lc16(%rip), %xmm4
+	movsd	%xmm4, -136(%rbp)
+	# line 15
+	movsd	.Lc17(%rip), %xmm5
+	movsd	%xmm5, -144(%rbp)
+.Lpc34:
+	# line 15
+	movsd	.Lc18(%rip), %xmm2
+	movsd	%xmm2, -128(%rbp)
+	# line 15
+	movsd	-144(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc49
+	# line 16
+	movsd	.Lc19(%rip), %xmm4
+	movsd	%xmm4, -128(%rbp)
+	# line 16
+	movapd	%xmm3, %xmm2
+	subsd	%xmm4, %xmm2
+	movsd	%xmm2, -120(%rbp)
+	# line 16
+	movsd	.Lc20(%rip), %xmm5
+	movsd	%xmm5, -112(%rbp)
+	# line 16
+	cvttsd2si	%xmm2, %eax
+	cvttsd2si	%xmm5, %ecx
+	imull	$4, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm6
+	movsd	%xmm6, -104(%rbp)
+	# line 16
+	movsd	.Lc21(%rip), %xmm7
+	movsd	%xmm7, -96(%rbp)
+	# line 16
+	movapd	%xmm6, %xmm8
+	mulsd	%xmm7, %xmm8
+	movsd	%xmm8, -152(%rbp)
+	# line 17
+	movsd	.Lc22(%rip), %xmm9
+	movsd	%xmm9, -96(%rbp)
+	# line 17
+	movapd	%xmm8, %xmm7
+	addsd	%xmm9, %xmm7
+	movsd	%xmm7, -104(%rbp)
+	# line 17
+	cvttsd2si	%xmm3, %eax
+	subl	$1, %eax
+	imull	$1, %eax, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	%xmm7, (%rdx,%rax,8)
+	# line 18
+	movsd	-136(%rbp), %xmm6
+	movapd	%xmm6, %xmm10
+	addsd	%xmm8, %xmm10
+	movsd	%xmm10, -136(%rbp)
+	# line 15
+	movsd	.Lc23(%rip), %xmm6
+	movsd	%xmm6, -104(%rbp)
+	# line 15
+	movapd	%xmm3, %xmm7
+	addsd	%xmm6, %xmm7
+	movsd	%xmm7, -144(%rbp)
+	# line 15
+	jmp	.Lpc34
+.Lpc49:
+	# line 20
+	movsd	-136(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 21
+	movsd	-152(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 22
+	movsd	-144(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 23
+	movl	$4, %edi
+	movl	$1, %esi
+	leaq	.Lm1(%rip), %rdx
+	call	print_mat@PLT
+	# line 24
+	call	printsep@PLT
+	# line 25
+	movsd	.Lc24(%rip), %xmm2
+	movsd	%xmm2, -160(%rbp)
+	# line 26
+	movsd	.Lc25(%rip), %xmm3
+	movsd	%xmm3, -144(%rbp)
+.Lpc56:
+	# line 26
+	movsd	.Lc26(%rip), %xmm2
+	movsd	%xmm2, -104(%rbp)
+	# line 26
+	movsd	-144(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc84
+	# line 26
+	movsd	.Lc27(%rip), %xmm4
+	movsd	%xmm4, -168(%rbp)
+.Lpc59:
+	# line 26
+	movsd	.Lc28(%rip), %xmm2
+	movsd	%xmm2, -104(%rbp)
+	# line 26
+	movsd	-168(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc81
+	# line 27
+	movsd	.Lc29(%rip), %xmm4
+	movsd	%xmm4, -104(%rbp)
+	# line 27
+	movsd	-144(%rbp), %xmm2
+	movapd	%xmm2, %xmm5
+	subsd	%xmm4, %xmm5
+	movsd	%xmm5, -96(%rbp)
+	# line 27
+	movsd	.Lc30(%rip), %xmm6
+	movsd	%xmm6, -112(%rbp)
+	# line 27
+	movapd	%xmm3, %xmm7
+	subsd	%xmm6, %xmm7
+	movsd	%xmm7, -120(%rbp)
+	# line 27
+	cvttsd2si	%xmm5, %eax
+	cvttsd2si	%xmm7, %ecx
+	imull	$4, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm8
+	movsd	%xmm8, -128(%rbp)
+	# line 27
+	movsd	.Lc31(%rip), %xmm9
+	movsd	%xmm9, -88(%rbp)
+	# line 27
+	movapd	%xmm8, %xmm10
+	addsd	%xmm9, %xmm10
+	movsd	%xmm10, -152(%rbp)
+	# line 28
+	movapd	%xmm10, %xmm11
+	mulsd	%xmm10, %xmm11
+	movsd	%xmm11, -88(%rbp)
+	# line 28
+	cvttsd2si	%xmm2, %eax
+	subl	$1, %eax
+	imull	$4, %eax, %eax
+	cvttsd2si	%xmm3, %ecx
+	subl	$1, %ecx
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm2(%rip), %rdx
+	movsd	%xmm11, (%rdx,%rax,8)
+	# line 29
+	movsd	.Lc32(%rip), %xmm9
+	movsd	%xmm9, -88(%rbp)
+	# line 29
+	movapd	%xmm2, %xmm11
+	subsd	%xmm9, %xmm11
+	movsd	%xmm11, -128(%rbp)
+	# line 29
+	movsd	.Lc33(%rip), %xmm8
+	movsd	%xmm8, -120(%rbp)
+	# line 29
+	movapd	%xmm3, %xmm7
+	subsd	%xmm8, %xmm7
+	movsd	%xmm7, -112(%rbp)
+	# line 29
+	cvttsd2si	%xmm11, %eax
+	cvttsd2si	%xmm7, %ecx
+	imull	$4, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm6
+	movsd	%xmm6, -96(%rbp)
+	# line 29
+	movsd	.Lc34(%rip), %xmm5
+	movsd	%xmm5, -104(%rbp)
+	# line 29
+	movapd	%xmm6, %xmm4
+	mulsd	%xmm5, %xmm4
+	movsd	%xmm4, -80(%rbp)
+	# line 29
+	movsd	-160(%rbp), %xmm12
+	movapd	%xmm12, %xmm13
+	addsd	%xmm4, %xmm13
+	movsd	%xmm13, -160(%rbp)
+	# line 26
+	movsd	.Lc35(%rip), %xmm12
+	movsd	%xmm12, -80(%rbp)
+	# line 26
+	movapd	%xmm3, %xmm4
+	addsd	%xmm12, %xmm4
+	movsd	%xmm4, -168(%rbp)
+	# line 26
+	jmp	.Lpc59
+.Lpc81:
+	# line 26
+	movsd	.Lc36(%rip), %xmm2
+	movsd	%xmm2, -80(%rbp)
+	# line 26
+	movsd	-144(%rbp), %xmm3
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -144(%rbp)
+	# line 26
+	jmp	.Lpc56
+.Lpc84:
+	# line 31
+	movsd	-160(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 32
+	movsd	-152(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 33
+	movsd	-144(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 34
+	movsd	-168(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 35
+	movl	$4, %edi
+	movl	$4, %esi
+	leaq	.Lm2(%rip), %rdx
+	call	print_mat@PLT
+.Lpc89:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	4607182418800017408
+.Lc1:
+	.quad	4611686018427387904
+.Lc2:
+	.quad	4613937818241073152
+.Lc3:
+	.quad	4616189618054758400
+.Lc4:
+	.quad	4617315517961601024
+.Lc5:
+	.quad	4618441417868443648
+.Lc6:
+	.quad	4619567317775286272
+.Lc7:
+	.quad	4620693217682128896
+.Lc8:
+	.quad	4621256167635550208
+.Lc9:
+	.quad	4621819117588971520
+.Lc10:
+	.quad	4622382067542392832
+.Lc11:
+	.quad	4622945017495814144
+.Lc12:
+	.quad	4623507967449235456
+.Lc13:
+	.quad	4624070917402656768
+.Lc14:
+	.quad	4624633867356078080
+.Lc15:
+	.quad	4625196817309499392
+.Lc16:
+	.quad	0
+.Lc17:
+	.quad	4607182418800017408
+.Lc18:
+	.quad	4617315517961601024
+.Lc19:
+	.quad	4607182418800017408
+.Lc20:
+	.quad	0
+.Lc21:
+	.quad	4611686018427387904
+.Lc22:
+	.quad	4607182418800017408
+.Lc23:
+	.quad	4607182418800017408
+.Lc24:
+	.quad	4607182418800017408
+.Lc25:
+	.quad	4607182418800017408
+.Lc26:
+	.quad	4617315517961601024
+.Lc27:
+	.quad	4607182418800017408
+.Lc28:
+	.quad	4617315517961601024
+.Lc29:
+	.quad	4607182418800017408
+.Lc30:
+	.quad	4607182418800017408
+.Lc31:
+	.quad	4607182418800017408
+.Lc32:
+	.quad	4607182418800017408
+.Lc33:
+	.quad	4607182418800017408
+.Lc34:
+	.quad	4593671619917905920
+.Lc35:
+	.quad	4607182418800017408
+.Lc36:
+	.quad	4607182418800017408
+	.bss
+	.balign	32
+.Lm0:
+	.zero	128
+	.balign	32
+.Lm1:
+	.zero	32
+	.balign	32
+.Lm2:
+	.zero	128
+	.section	.note.GNU-stack,"",@progbits
@@ -0,0 +1,265 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$80, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 11
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 11
+	movsd	%xmm2, .Lm0+0(%rip)
+	# line 11
+	movsd	.Lc1(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 11
+	movsd	%xmm3, .Lm0+8(%rip)
+	# line 11
+	movsd	.Lc2(%rip), %xmm4
+	movsd	%xmm4, -24(%rbp)
+	# line 11
+	movsd	%xmm4, .Lm0+16(%rip)
+	# line 11
+	movsd	.Lc3(%rip), %xmm5
+	movsd	%xmm5, -32(%rbp)
+	# line 11
+	movsd	%xmm5, .Lm0+24(%rip)
+	# line 11
+	movsd	.Lc4(%rip), %xmm6
+	movsd	%xmm6, -40(%rbp)
+	# line 11
+	movsd	%xmm6, .Lm0+32(%rip)
+	# line 11
+	movsd	.Lc5(%rip), %xmm7
+	movsd	%xmm7, -48(%rbp)
+	# line 11
+	movsd	%xmm7, .Lm0+40(%rip)
+	# line 11
+	movsd	.Lc6(%rip), %xmm8
+	movsd	%xmm8, -56(%rbp)
+	# line 11
+	movsd	%xmm8, .Lm0+48(%rip)
+	# line 11
+	movsd	.Lc7(%rip), %xmm9
+	movsd	%xmm9, -64(%rbp)
+	# line 11
+	movsd	%xmm9, .Lm0+56(%rip)
+	# line 11
+	movsd	.Lc8(%rip), %xmm10
+	movsd	%xmm10, -72(%rbp)
+	# line 11
+	movsd	%xmm10, .Lm0+64(%rip)
+	# line 12
+	movsd	.Lc9(%rip), %xmm11
+	movsd	%xmm11, -72(%rbp)
+	# line 12
+	movsd	%xmm11, .Lm1+0(%rip)
+	# line 12
+	movsd	.Lc10(%rip), %xmm10
+	movsd	%xmm10, -64(%rbp)
+	# line 12
+	movsd	%xmm10, .Lm1+8(%rip)
+	# line 12
+	movsd	.Lc11(%rip), %xmm9
+	movsd	%xmm9, -56(%rbp)
+	# line 12
+	movsd	%xmm9, .Lm1+16(%rip)
+	# line 12
+	movsd	.Lc12(%rip), %xmm8
+	movsd	%xmm8, -48(%rbp)
+	# line 12
+	movsd	%xmm8, .Lm1+24(%rip)
+	# line 12
+	movsd	.Lc13(%rip), %xmm7
+	movsd	%xmm7, -40(%rbp)
+	# line 12
+	movsd	%xmm7, .Lm1+32(%rip)
+	# line 12
+	movsd	.Lc14(%rip), %xmm6
+	movsd	%xmm6, -32(%rbp)
+	# line 12
+	movsd	%xmm6, .Lm1+40(%rip)
+	# line 12
+	movsd	.Lc15(%rip), %xmm5
+	movsd	%xmm5, -24(%rbp)
+	# line 12
+	movsd	%xmm5, .Lm1+48(%rip)
+	# line 12
+	movsd	.Lc16(%rip), %xmm4
+	movsd	%xmm4, -16(%rbp)
+	# line 12
+	movsd	%xmm4, .Lm1+56(%rip)
+	# line 12
+	movsd	.Lc17(%rip), %xmm3
+	movsd	%xmm3, -8(%rbp)
+	# line 12
+	movsd	%xmm3, .Lm1+64(%rip)
+	# line 13
+	movl	$3, %edi
+	movl	$3, %esi
+	leaq	.Lm0(%rip), %rdx
+	call	print_mat@PLT
+	# line 14
+	call	printsep@PLT
+	# line 15
+	movl	$3, %edi
+	movl	$3, %esi
+	movl	$3, %edx
+	leaq	.Lm0(%rip), %rcx
+	leaq	.Lm1(%rip), %r8
+	leaq	.Lm2(%rip), %r9
+	call	mat_mat_mul@PLT
+	# line 16
+	movl	$3, %edi
+	movl	$3, %esi
+	movl	$3, %edx
+	leaq	.Lm1(%rip), %rcx
+	leaq	.Lm1(%rip), %r8
+	leaq	.Lm3(%rip), %r9
+	call	mat_mat_mul@PLT
+	# line 17
+	movl	$3, %edi
+	movl	$3, %esi
+	leaq	.Lm0(%rip), %rdx
+	leaq	.Lm5(%rip), %rcx
+	call	tr@PLT
+	# line 17
+	movl	$3, %edi
+	movl	$3, %esi
+	leaq	.Lm5(%rip), %rdx
+	leaq	.Lm1(%rip), %rcx
+	leaq	.Lm4(%rip), %r8
+	call	mat_mat_add@PLT
+	# line 18
+	movl	$3, %edi
+	movl	$3, %esi
+	leaq	.Lm3(%rip), %rdx
+	leaq	.Lm1(%rip), %rcx
+	leaq	.Lm0(%rip), %r8
+	call	mat_mat_add@PLT
+	# line 19
+	movsd	.Lc18(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 19
+	movl	$3, %edi
+	movl	$3, %esi
+	leaq	.Lm0(%rip), %rdx
+	leaq	.Lm5(%rip), %rcx
+	call	neg_mat@PLT
+	# line 19
+	movl	$3, %edi
+	movl	$3, %esi
+	leaq	.Lm1(%rip), %rdx
+	leaq	.Lm5(%rip), %rcx
+	leaq	.Lm3(%rip), %r8
+	call	mat_mat_add@PLT
+	# line 20
+	movl	$3, %edi
+	movl	$3, %esi
+	leaq	.Lm2(%rip), %rdx
+	leaq	.Lm4(%rip), %rcx
+	leaq	.Lm2(%rip), %r8
+	call	mat_mat_add@PLT
+	# line 21
+	movl	$3, %edi
+	movl	$3, %esi
+	movl	$3, %edx
+	leaq	.Lm4(%rip), %rcx
+	leaq	.Lm0(%rip), %r8
+	leaq	.Lscratch(%rip), %r9
+	call	mat_mat_mul@PLT
+	movl	$3, %edi
+	movl	$3, %esi
+	leaq	.Lscratch(%rip), %rdx
+	leaq	.Lm4(%rip), %rcx
+	call	mat_assign@PLT
+	# line 22
+	movl	$3, %edi
+	movl	$3, %esi
+	leaq	.Lm2(%rip), %rdx
+	call	print_mat@PLT
+	# line 23
+	call	printsep@PLT
+	# line 24
+	movl	$3, %edi
+	movl	$3, %esi
+	leaq	.Lm3(%rip), %rdx
+	call	print_mat@PLT
+	# line 25
+	call	printsep@PLT
+	# line 26
+	movl	$3, %edi
+	movl	$3, %esi
+	leaq	.Lm4(%rip), %rdx
+	call	print_mat@PLT
+.Lpc53:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	4607182418800017408
+.Lc1:
+	.quad	4611686018427387904
+.Lc2:
+	.quad	4613937818241073152
+.Lc3:
+	.quad	4616189618054758400
+.Lc4:
+	.quad	4617315517961601024
+.Lc5:
+	.quad	4618441417868443648
+.Lc6:
+	.quad	4619567317775286272
+.Lc7:
+	.quad	4620693217682128896
+.Lc8:
+	.quad	4621256167635550208
+.Lc9:
+	.quad	4611686018427387904
+.Lc10:
+	.quad	0
+.Lc11:
+	.quad	4607182418800017408
+.Lc12:
+	.quad	0
+.Lc13:
+	.quad	4607182418800017408
+.Lc14:
+	.quad	0
+.Lc15:
+	.quad	4607182418800017408
+.Lc16:
+	.quad	0
+.Lc17:
+	.quad	4611686018427387904
+.Lc18:
+	.quad	0
+	.bss
+	.balign	32
+.Lm0:
+	.zero	72
+	.balign	32
+.Lm1:
+	.zero	72
+	.balign	32
+.Lm2:
+	.zero	72
+	.balign	32
+.Lm3:
+	.zero	72
+	.balign	32
+.Lm4:
+	.zero	72
+	.balign	32
+.Lm5:
+	.zero	72
+	.balign	32
+.Lscratch:
+	.zero	72
+	.section	.note.GNU-stack,"",@progbits
@@ -0,0 +1,36 @@
+#ifndef EX17_H
+#define EX17_H
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/uio.h>
+int rt_binary_out();
+void rt_writev_all(struct iovec* iov, int count);
+void rt_out_flush();
+char* rt_out_reserve(int count);
+void rt_out_str(const char* str);
+void rt_out_double(double value);
+void rt_bin_put(const void* value, int size);
+void rt_bin_record(int rows, int cols, const double* data);
+void print(double value);
+struct rt_state {
+	double n;
+	double i;
+	double j;
+	double s;
+};
+void rt_part_1(struct rt_state* rt_s);
+void rt_part_2(struct rt_state* rt_s);
+void rt_part_3(struct rt_state* rt_s);
+void rt_part_4(struct rt_state* rt_s);
+void rt_part_5(struct rt_state* rt_s);
+void rt_part_6(struct rt_state* rt_s);
+void rt_part_7(struct rt_state* rt_s);
+void rt_part_8(struct rt_state* rt_s);
+void rt_part_9(struct rt_state* rt_s);
+void rt_part_10(struct rt_state* rt_s);
+#endif
@@ -0,0 +1,307 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$64, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 10
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 11
+	movsd	.Lc1(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+.Lpc2:
+	# line 11
+	movsd	.Lc2(%rip), %xmm2
+	movsd	%xmm2, -32(%rbp)
+	# line 11
+	movsd	.Lc3(%rip), %xmm3
+	movsd	%xmm3, -40(%rbp)
+	# line 11
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -24(%rbp)
+	# line 11
+	movsd	-16(%rbp), %xmm5
+	ucomisd	%xmm5, %xmm4
+	jbe	.Lpc10
+	# line 12
+	movsd	-8(%rbp), %xmm6
+	movapd	%xmm6, %xmm7
+	addsd	%xmm5, %xmm7
+	movsd	%xmm7, -8(%rbp)
+	# line 11
+	movsd	.Lc4(%rip), %xmm6
+	movsd	%xmm6, -40(%rbp)
+	# line 11
+	movapd	%xmm5, %xmm3
+	addsd	%xmm6, %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 11
+	jmp	.Lpc2
+.Lpc10:
+	# line 14
+	movsd	-8(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 15
+	movsd	.Lc5(%rip), %xmm2
+	movsd	%xmm2, -16(%rbp)
+.Lpc12:
+	# line 15
+	movsd	.Lc6(%rip), %xmm2
+	movsd	%xmm2, -40(%rbp)
+	# line 15
+	movsd	-16(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc18
+	# line 16
+	movsd	-8(%rbp), %xmm4
+	movapd	%xmm4, %xmm5
+	addsd	%xmm3, %xmm5
+	movsd	%xmm5, -8(%rbp)
+	# line 15
+	movsd	.Lc7(%rip), %xmm4
+	movsd	%xmm4, -40(%rbp)
+	# line 15
+	movapd	%xmm3, %xmm2
+	addsd	%xmm4, %xmm2
+	movsd	%xmm2, -16(%rbp)
+	# line 15
+	jmp	.Lpc12
+.Lpc18:
+	# line 18
+	movsd	-8(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 19
+	movsd	-16(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 20
+	movsd	.Lc8(%rip), %xmm2
+	movsd	%xmm2, -16(%rbp)
+.Lpc21:
+	# line 20
+	movsd	.Lc9(%rip), %xmm2
+	movsd	%xmm2, -32(%rbp)
+	# line 20
+	movsd	.Lc10(%rip), %xmm3
+	movsd	%xmm3, -24(%rbp)
+	# line 20
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -40(%rbp)
+	# line 20
+	movsd	-16(%rbp), %xmm5
+	ucomisd	%xmm5, %xmm4
+	jbe	.Lpc38
+	# line 20
+	movapd	%xmm5, %xmm6
+	movsd	%xmm6, -48(%rbp)
+.Lpc26:
+	# line 20
+	movsd	.Lc11(%rip), %xmm2
+	movsd	%xmm2, -32(%rbp)
+	# line 20
+	movsd	.Lc12(%rip), %xmm3
+	movsd	%xmm3, -40(%rbp)
+	# line 20
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -24(%rbp)
+	# line 20
+	movsd	-48(%rbp), %xmm5
+	ucomisd	%xmm5, %xmm4
+	jbe	.Lpc35
+	# line 21
+	movsd	-16(%rbp), %xmm6
+	movapd	%xmm6, %xmm7
+	mulsd	%xmm5, %xmm7
+	movsd	%xmm7, -40(%rbp)
+	# line 21
+	movsd	-8(%rbp), %xmm3
+	movapd	%xmm3, %xmm8
+	addsd	%xmm7, %xmm8
+	movsd	%xmm8, -8(%rbp)
+	# line 20
+	movsd	.Lc13(%rip), %xmm3
+	movsd	%xmm3, -40(%rbp)
+	# line 20
+	movapd	%xmm5, %xmm7
+	addsd	%xmm3, %xmm7
+	movsd	%xmm7, -48(%rbp)
+	# line 20
+	jmp	.Lpc26
+.Lpc35:
+	# line 20
+	movsd	.Lc14(%rip), %xmm2
+	movsd	%xmm2, -40(%rbp)
+	# line 20
+	movsd	-16(%rbp), %xmm3
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -16(%rbp)
+	# line 20
+	jmp	.Lpc21
+.Lpc38:
+	# line 23
+	movsd	-8(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 24
+	movsd	-48(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 25
+	movsd	.Lc15(%rip), %xmm2
+	movsd	%xmm2, -56(%rbp)
+	# line 26
+	movsd	.Lc16(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+.Lpc42:
+	# line 26
+	movsd	.Lc17(%rip), %xmm2
+	movsd	%xmm2, -32(%rbp)
+	# line 26
+	movsd	.Lc18(%rip), %xmm3
+	movsd	%xmm3, -24(%rbp)
+	# line 26
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -40(%rbp)
+	# line 26
+	movsd	-16(%rbp), %xmm5
+	ucomisd	%xmm5, %xmm4
+	jbe	.Lpc51
+	# line 27
+	movsd	.Lc19(%rip), %xmm6
+	movsd	%xmm6, -24(%rbp)
+	# line 27
+	movsd	-8(%rbp), %xmm3
+	movapd	%xmm3, %xmm7
+	addsd	%xmm6, %xmm7
+	movsd	%xmm7, -8(%rbp)
+	# line 26
+	movsd	.Lc20(%rip), %xmm3
+	movsd	%xmm3, -24(%rbp)
+	# line 26
+	movapd	%xmm5, %xmm6
+	addsd	%xmm3, %xmm6
+	movsd	%xmm6, -16(%rbp)
+	# line 26
+	jmp	.Lpc42
+.Lpc51:
+	# line 29
+	movsd	-8(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 30
+	movsd	.Lc21(%rip), %xmm2
+	movsd	%xmm2, -16(%rbp)
+.Lpc53:
+	# line 30
+	movsd	.Lc22(%rip), %xmm2
+	movsd	%xmm2, -32(%rbp)
+	# line 30
+	movsd	-56(%rbp), %xmm3
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -24(%rbp)
+	# line 30
+	movsd	-16(%rbp), %xmm5
+	ucomisd	%xmm5, %xmm4
+	jbe	.Lpc62
+	# line 31
+	movsd	.Lc23(%rip), %xmm6
+	movsd	%xmm6, -56(%rbp)
+	# line 32
+	movsd	.Lc24(%rip), %xmm3
+	movsd	%xmm3, -32(%rbp)
+	# line 32
+	movsd	-8(%rbp), %xmm2
+	movapd	%xmm2, %xmm7
+	addsd	%xmm3, %xmm7
+	movsd	%xmm7, -8(%rbp)
+	# line 30
+	movsd	.Lc25(%rip), %xmm2
+	movsd	%xmm2, -32(%rbp)
+	# line 30
+	movapd	%xmm5, %xmm3
+	addsd	%xmm2, %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 30
+	jmp	.Lpc53
+.Lpc62:
+	# line 34
+	movsd	-8(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 35
+	movsd	-16(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+.Lpc64:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	0
+.Lc1:
+	.quad	4607182418800017408
+.Lc2:
+	.quad	4607182418800017408
+.Lc3:
+	.quad	4618441417868443648
+.Lc4:
+	.quad	4607182418800017408
+.Lc5:
+	.quad	4611686018427387904
+.Lc6:
+	.quad	4622382067542392832
+.Lc7:
+	.quad	4613937818241073152
+.Lc8:
+	.quad	4607182418800017408
+.Lc9:
+	.quad	4607182418800017408
+.Lc10:
+	.quad	4613937818241073152
+.Lc11:
+	.quad	4607182418800017408
+.Lc12:
+	.quad	4616189618054758400
+.Lc13:
+	.quad	4611686018427387904
+.Lc14:
+	.quad	4607182418800017408
+.Lc15:
+	.quad	4616189618054758400
+.Lc16:
+	.quad	4607182418800017408
+.Lc17:
+	.quad	4607182418800017408
+.Lc18:
+	.quad	4616189618054758400
+.Lc19:
+	.quad	4607182418800017408
+.Lc20:
+	.quad	4607182418800017408
+.Lc21:
+	.quad	4607182418800017408
+.Lc22:
+	.quad	4607182418800017408
+.Lc23:
+	.quad	4611686018427387904
+.Lc24:
+	.quad	4607182418800017408
+.Lc25:
+	.quad	4607182418800017408
+	.bss
+	.section	.note.GNU-stack,"",@progbits
@@ -0,0 +1,174 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 8
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+.Lpc1:
+	# line 8
+	movsd	.Lc1(%rip), %xmm2
+	movsd	%xmm2, -16(%rbp)
+	# line 8
+	movsd	-8(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc6
+	# line 8
+	movsd	.Lc2(%rip), %xmm4
+	movsd	%xmm4, -16(%rbp)
+	# line 8
+	movapd	%xmm3, %xmm2
+	addsd	%xmm4, %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 8
+	jmp	.Lpc1
+.Lpc6:
+	# line 11
+	movsd	-8(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 12
+	movsd	.Lc3(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+.Lpc8:
+	# line 12
+	movsd	.Lc4(%rip), %xmm2
+	movsd	%xmm2, -16(%rbp)
+	# line 12
+	movsd	-8(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc19
+	# line 12
+	movsd	.Lc5(%rip), %xmm4
+	movsd	%xmm4, -24(%rbp)
+.Lpc11:
+	# line 12
+	movsd	.Lc6(%rip), %xmm2
+	movsd	%xmm2, -16(%rbp)
+	# line 12
+	movsd	-24(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc16
+	# line 12
+	movsd	.Lc7(%rip), %xmm4
+	movsd	%xmm4, -16(%rbp)
+	# line 12
+	movapd	%xmm3, %xmm2
+	addsd	%xmm4, %xmm2
+	movsd	%xmm2, -24(%rbp)
+	# line 12
+	jmp	.Lpc11
+.Lpc16:
+	# line 12
+	movsd	.Lc8(%rip), %xmm2
+	movsd	%xmm2, -16(%rbp)
+	# line 12
+	movsd	-8(%rbp), %xmm3
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -8(%rbp)
+	# line 12
+	jmp	.Lpc8
+.Lpc19:
+	# line 16
+	movsd	-8(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 17
+	movsd	-24(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 18
+	movsd	.Lc9(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+.Lpc22:
+	# line 18
+	movsd	.Lc10(%rip), %xmm2
+	movsd	%xmm2, -16(%rbp)
+	# line 18
+	movsd	-8(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc27
+	# line 18
+	movsd	.Lc11(%rip), %xmm4
+	movsd	%xmm4, -16(%rbp)
+	# line 18
+	movapd	%xmm3, %xmm2
+	addsd	%xmm4, %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 18
+	jmp	.Lpc22
+.Lpc27:
+	# line 21
+	movsd	-8(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+	# line 22
+	movsd	.Lc12(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+.Lpc29:
+	# line 22
+	movsd	.Lc13(%rip), %xmm2
+	movsd	%xmm2, -16(%rbp)
+	# line 22
+	movsd	-8(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc34
+	# line 22
+	movsd	.Lc14(%rip), %xmm4
+	movsd	%xmm4, -16(%rbp)
+	# line 22
+	movapd	%xmm3, %xmm2
+	addsd	%xmm4, %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 22
+	jmp	.Lpc29
+.Lpc34:
+	# line 25
+	movsd	-8(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+.Lpc35:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	4607182418800017408
+.Lc1:
+	.quad	4618441417868443648
+.Lc2:
+	.quad	4607182418800017408
+.Lc3:
+	.quad	4607182418800017408
+.Lc4:
+	.quad	4613937818241073152
+.Lc5:
+	.quad	4607182418800017408
+.Lc6:
+	.quad	4616189618054758400
+.Lc7:
+	.quad	4607182418800017408
+.Lc8:
+	.quad	4607182418800017408
+.Lc9:
+	.quad	4616189618054758400
+.Lc10:
+	.quad	4611686018427387904
+.Lc11:
+	.quad	4607182418800017408
+.Lc12:
+	.quad	4607182418800017408
+.Lc13:
+	.quad	4622382067542392832
+.Lc14:
+	.quad	4613937818241073152
+	.bss
+	.section	.note.GNU-stack,"",@progbits
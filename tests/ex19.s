@@ -0,0 +1,232 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$144, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 10
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 10
+	movsd	%xmm2, .Lm0+0(%rip)
+	# line 10
+	movsd	.Lc1(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 10
+	movsd	%xmm3, .Lm0+8(%rip)
+	# line 10
+	movsd	.Lc2(%rip), %xmm4
+	movsd	%xmm4, -24(%rbp)
+	# line 10
+	movsd	%xmm4, .Lm0+16(%rip)
+	# line 10
+	movsd	.Lc3(%rip), %xmm5
+	movsd	%xmm5, -32(%rbp)
+	# line 10
+	movsd	%xmm5, .Lm0+24(%rip)
+	# line 10
+	movsd	.Lc4(%rip), %xmm6
+	movsd	%xmm6, -40(%rbp)
+	# line 10
+	movsd	%xmm6, .Lm0+32(%rip)
+	# line 10
+	movsd	.Lc5(%rip), %xmm7
+	movsd	%xmm7, -48(%rbp)
+	# line 10
+	movsd	%xmm7, .Lm0+40(%rip)
+	# line 11
+	movl	$2, %edi
+	movl	$3, %esi
+	leaq	.Lm0(%rip), %rdx
+	call	print_mat@PLT
+	# line 12
+	call	printsep@PLT
+	# line 13
+	movsd	.Lc6(%rip), %xmm2
+	movsd	%xmm2, -48(%rbp)
+	# line 13
+	movsd	%xmm2, .Lm1+0(%rip)
+	# line 13
+	movsd	.Lc7(%rip), %xmm3
+	movsd	%xmm3, -40(%rbp)
+	# line 13
+	movsd	%xmm3, .Lm1+8(%rip)
+	# line 13
+	movsd	.Lc8(%rip), %xmm4
+	movsd	%xmm4, -32(%rbp)
+	# line 13
+	movsd	%xmm4, .Lm1+16(%rip)
+	# line 13
+	movsd	.Lc9(%rip), %xmm5
+	movsd	%xmm5, -24(%rbp)
+	# line 13
+	movsd	%xmm5, .Lm1+24(%rip)
+	# line 14
+	movl	$4, %edi
+	movl	$1, %esi
+	leaq	.Lm1(%rip), %rdx
+	call	print_mat@PLT
+	# line 15
+	call	printsep@PLT
+	# line 16
+	movsd	.Lc10(%rip), %xmm2
+	movsd	%xmm2, -24(%rbp)
+	# line 16
+	movsd	.Lc11(%rip), %xmm3
+	movsd	%xmm3, -32(%rbp)
+	# line 16
+	cvttsd2si	%xmm2, %eax
+	cvttsd2si	%xmm3, %ecx
+	imull	$3, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm4
+	movsd	%xmm4, -40(%rbp)
+	# line 16
+	movsd	%xmm4, .Lm2+0(%rip)
+	# line 16
+	movsd	.Lc12(%rip), %xmm5
+	movsd	%xmm5, -48(%rbp)
+	# line 16
+	movsd	%xmm5, .Lm2+8(%rip)
+	# line 16
+	movsd	.Lc13(%rip), %xmm6
+	movsd	%xmm6, -16(%rbp)
+	# line 16
+	movsd	%xmm6, .Lm2+16(%rip)
+	# line 16
+	movsd	.Lc14(%rip), %xmm7
+	movsd	%xmm7, -8(%rbp)
+	# line 16
+	movsd	.Lc15(%rip), %xmm8
+	movsd	%xmm8, -56(%rbp)
+	# line 16
+	cvttsd2si	%xmm7, %eax
+	cvttsd2si	%xmm8, %ecx
+	imull	$1, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm9
+	movsd	%xmm9, -64(%rbp)
+	# line 16
+	movsd	.Lc16(%rip), %xmm10
+	movsd	%xmm10, -72(%rbp)
+	# line 16
+	movapd	%xmm9, %xmm11
+	mulsd	%xmm10, %xmm11
+	movsd	%xmm11, -80(%rbp)
+	# line 16
+	movsd	%xmm11, .Lm2+24(%rip)
+	# line 16
+	movsd	.Lc17(%rip), %xmm12
+	movsd	%xmm12, -88(%rbp)
+	# line 16
+	movsd	%xmm12, .Lm2+32(%rip)
+	# line 16
+	movsd	.Lc18(%rip), %xmm13
+	movsd	%xmm13, -96(%rbp)
+	# line 16
+	movsd	.Lc19(%rip), %xmm14
+	movsd	%xmm14, -104(%rbp)
+	# line 16
+	cvttsd2si	%xmm13, %eax
+	cvttsd2si	%xmm14, %ecx
+	imull	$3, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm15
+	movsd	%xmm15, -112(%rbp)
+	# line 16
+	movsd	.Lc20(%rip), %xmm2
+	movsd	%xmm2, -120(%rbp)
+	# line 16
+	movsd	.Lc21(%rip), %xmm3
+	movsd	%xmm3, -128(%rbp)
+	# line 16
+	cvttsd2si	%xmm2, %eax
+	cvttsd2si	%xmm3, %ecx
+	imull	$1, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm4
+	movsd	%xmm4, -136(%rbp)
+	# line 16
+	movapd	%xmm15, %xmm5
+	addsd	%xmm4, %xmm5
+	movsd	%xmm5, -144(%rbp)
+	# line 16
+	movsd	%xmm5, .Lm2+40(%rip)
+	# line 17
+	movl	$3, %edi
+	movl	$2, %esi
+	leaq	.Lm2(%rip), %rdx
+	call	print_mat@PLT
+.Lpc49:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	4607182418800017408
+.Lc1:
+	.quad	4618441417868443648
+.Lc2:
+	.quad	4611686018427387904
+.Lc3:
+	.quad	13839561654909534208
+.Lc4:
+	.quad	4616189618054758400
+.Lc5:
+	.quad	4616189618054758400
+.Lc6:
+	.quad	4599075939470750516
+.Lc7:
+	.quad	4612811918334230528
+.Lc8:
+	.quad	4607182418800017408
+.Lc9:
+	.quad	13830554455654793216
+.Lc10:
+	.quad	0
+.Lc11:
+	.quad	4611686018427387904
+.Lc12:
+	.quad	4609434218613702656
+.Lc13:
+	.quad	4619567317775286272
+.Lc14:
+	.quad	4607182418800017408
+.Lc15:
+	.quad	0
+.Lc16:
+	.quad	4611686018427387904
+.Lc17:
+	.quad	0
+.Lc18:
+	.quad	4607182418800017408
+.Lc19:
+	.quad	4607182418800017408
+.Lc20:
+	.quad	0
+.Lc21:
+	.quad	0
+	.bss
+	.balign	32
+.Lm0:
+	.zero	48
+	.balign	32
+.Lm1:
+	.zero	32
+	.balign	32
+.Lm2:
+	.zero	48
+	.section	.note.GNU-stack,"",@progbits
@@ -0,0 +1,33 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 4
+	leaq	.Ls0(%rip), %rdi
+	movl	$2, %esi
+	movl	$2, %edx
+	leaq	.Lm0(%rip), %rcx
+	call	rt_load_csv@PLT
+	# line 5
+	movl	$2, %edi
+	movl	$2, %esi
+	leaq	.Lm0(%rip), %rdx
+	call	print_mat@PLT
+.Lpc2:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Ls0:
+	.string	"tests/ex20#1.csv"
+	.bss
+	.balign	32
+.Lm0:
+	.zero	32
+	.section	.note.GNU-stack,"",@progbits
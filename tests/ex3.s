@@ -0,0 +1,230 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$96, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 10
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 10
+	movsd	%xmm2, .Lm0+0(%rip)
+	# line 10
+	movsd	.Lc1(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 10
+	movsd	%xmm3, .Lm0+8(%rip)
+	# line 10
+	movsd	.Lc2(%rip), %xmm4
+	movsd	%xmm4, -24(%rbp)
+	# line 10
+	movsd	%xmm4, .Lm0+16(%rip)
+	# line 10
+	movsd	.Lc3(%rip), %xmm5
+	movsd	%xmm5, -32(%rbp)
+	# line 10
+	movsd	%xmm5, .Lm0+24(%rip)
+	# line 10
+	movsd	.Lc4(%rip), %xmm6
+	movsd	%xmm6, -40(%rbp)
+	# line 10
+	movsd	%xmm6, .Lm0+32(%rip)
+	# line 10
+	movsd	.Lc5(%rip), %xmm7
+	movsd	%xmm7, -48(%rbp)
+	# line 10
+	movsd	%xmm7, .Lm0+40(%rip)
+	# line 10
+	movsd	.Lc6(%rip), %xmm8
+	movsd	%xmm8, -56(%rbp)
+	# line 10
+	movsd	%xmm8, .Lm0+48(%rip)
+	# line 10
+	movsd	.Lc7(%rip), %xmm9
+	movsd	%xmm9, -64(%rbp)
+	# line 10
+	movsd	%xmm9, .Lm0+56(%rip)
+	# line 10
+	movsd	.Lc8(%rip), %xmm10
+	movsd	%xmm10, -72(%rbp)
+	# line 10
+	movsd	%xmm10, .Lm0+64(%rip)
+	# line 11
+	movsd	.Lc9(%rip), %xmm11
+	movsd	%xmm11, -72(%rbp)
+	# line 11
+	movsd	%xmm11, .Lm1+0(%rip)
+	# line 11
+	movsd	.Lc10(%rip), %xmm10
+	movsd	%xmm10, -64(%rbp)
+	# line 11
+	movsd	%xmm10, .Lm1+8(%rip)
+	# line 11
+	movsd	.Lc11(%rip), %xmm9
+	movsd	%xmm9, -56(%rbp)
+	# line 11
+	movsd	%xmm9, .Lm1+16(%rip)
+	# line 12
+	movsd	.Lc12(%rip), %xmm8
+	movsd	%xmm8, -80(%rbp)
+.Lpc25:
+	# line 12
+	movsd	.Lc13(%rip), %xmm2
+	movsd	%xmm2, -56(%rbp)
+	# line 12
+	movsd	-80(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc42
+	# line 13
+	movl	$3, %edi
+	movl	$3, %esi
+	movl	$1, %edx
+	leaq	.Lm0(%rip), %rcx
+	leaq	.Lm1(%rip), %r8
+	leaq	.Lm2(%rip), %r9
+	call	mat_mat_mul@PLT
+	# line 14
+	movsd	.Lc14(%rip), %xmm2
+	movsd	%xmm2, -56(%rbp)
+	# line 14
+	movl	$3, %edi
+	movl	$1, %esi
+	leaq	.Lm1(%rip), %rdx
+	leaq	.Lm3(%rip), %rcx
+	call	neg_mat@PLT
+	# line 14
+	movl	$3, %edi
+	movl	$1, %esi
+	leaq	.Lm2(%rip), %rdx
+	leaq	.Lm3(%rip), %rcx
+	leaq	.Lm4(%rip), %r8
+	call	mat_mat_add@PLT
+	# line 14
+	movl	$3, %edi
+	movl	$1, %esi
+	leaq	.Lm4(%rip), %rdx
+	leaq	.Lm5(%rip), %rcx
+	call	tr@PLT
+	# line 14
+	movsd	.Lc15(%rip), %xmm2
+	movsd	%xmm2, -64(%rbp)
+	# line 14
+	movl	$3, %edi
+	movl	$1, %esi
+	leaq	.Lm1(%rip), %rdx
+	leaq	.Lm6(%rip), %rcx
+	call	neg_mat@PLT
+	# line 14
+	movl	$3, %edi
+	movl	$1, %esi
+	leaq	.Lm2(%rip), %rdx
+	leaq	.Lm6(%rip), %rcx
+	leaq	.Lm7(%rip), %r8
+	call	mat_mat_add@PLT
+	# line 14
+	movl	$3, %edi
+	leaq	.Lm5(%rip), %rsi
+	leaq	.Lm7(%rip), %rdx
+	call	mat_mat_mul_s@PLT
+	movsd	%xmm0, -72(%rbp)
+	# line 14
+	movsd	-72(%rbp), %xmm2
+	sqrtsd	%xmm2, %xmm3
+	movsd	%xmm3, -88(%rbp)
+	# line 15
+	movapd	%xmm3, %xmm0
+	call	print@PLT
+	# line 16
+	movl	$3, %edi
+	movl	$1, %esi
+	leaq	.Lm2(%rip), %rdx
+	leaq	.Lm1(%rip), %rcx
+	call	mat_assign@PLT
+	# line 12
+	movsd	.Lc16(%rip), %xmm2
+	movsd	%xmm2, -72(%rbp)
+	# line 12
+	movsd	-80(%rbp), %xmm3
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -80(%rbp)
+	# line 12
+	jmp	.Lpc25
+.Lpc42:
+	# line 18
+	call	printsep@PLT
+	# line 19
+	movl	$3, %edi
+	movl	$1, %esi
+	leaq	.Lm1(%rip), %rdx
+	call	print_mat@PLT
+.Lpc44:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	4602678819172646912
+.Lc1:
+	.quad	0
+.Lc2:
+	.quad	4602678819172646912
+.Lc3:
+	.quad	0
+.Lc4:
+	.quad	0
+.Lc5:
+	.quad	4602678819172646912
+.Lc6:
+	.quad	4602678819172646912
+.Lc7:
+	.quad	4607182418800017408
+.Lc8:
+	.quad	0
+.Lc9:
+	.quad	4607182418800017408
+.Lc10:
+	.quad	4607182418800017408
+.Lc11:
+	.quad	4607182418800017408
+.Lc12:
+	.quad	4607182418800017408
+.Lc13:
+	.quad	4622382067542392832
+.Lc14:
+	.quad	0
+.Lc15:
+	.quad	0
+.Lc16:
+	.quad	4607182418800017408
+	.bss
+	.balign	32
+.Lm0:
+	.zero	72
+	.balign	32
+.Lm1:
+	.zero	24
+	.balign	32
+.Lm2:
+	.zero	24
+	.balign	32
+.Lm3:
+	.zero	24
+	.balign	32
+.Lm4:
+	.zero	24
+	.balign	32
+.Lm5:
+	.zero	24
+	.balign	32
+.Lm6:
+	.zero	24
+	.balign	32
+.Lm7:
+	.zero	24
+	.section	.note.GNU-stack,"",@progbits
@@ -0,0 +1,225 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$144, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 6
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 6
+	movsd	%xmm2, .Lm0+0(%rip)
+	# line 6
+	movsd	.Lc1(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 6
+	movsd	%xmm3, .Lm0+8(%rip)
+	# line 6
+	movsd	.Lc2(%rip), %xmm4
+	movsd	%xmm4, -24(%rbp)
+	# line 6
+	movsd	%xmm4, .Lm0+16(%rip)
+	# line 6
+	movsd	.Lc3(%rip), %xmm5
+	movsd	%xmm5, -32(%rbp)
+	# line 6
+	movsd	%xmm5, .Lm0+24(%rip)
+	# line 6
+	movsd	.Lc4(%rip), %xmm6
+	movsd	%xmm6, -40(%rbp)
+	# line 6
+	movsd	%xmm6, .Lm0+32(%rip)
+	# line 6
+	movsd	.Lc5(%rip), %xmm7
+	movsd	%xmm7, -48(%rbp)
+	# line 6
+	movsd	%xmm7, .Lm0+40(%rip)
+	# line 6
+	movsd	.Lc6(%rip), %xmm8
+	movsd	%xmm8, -56(%rbp)
+	# line 6
+	movsd	%xmm8, .Lm0+48(%rip)
+	# line 6
+	movsd	.Lc7(%rip), %xmm9
+	movsd	%xmm9, -64(%rbp)
+	# line 6
+	movsd	%xmm9, .Lm0+56(%rip)
+	# line 6
+	movsd	.Lc8(%rip), %xmm10
+	movsd	%xmm10, -72(%rbp)
+	# line 6
+	movsd	%xmm10, .Lm0+64(%rip)
+	# line 6
+	movsd	.Lc9(%rip), %xmm11
+	movsd	%xmm11, -80(%rbp)
+	# line 6
+	movsd	%xmm11, .Lm0+72(%rip)
+	# line 6
+	movsd	.Lc10(%rip), %xmm12
+	movsd	%xmm12, -88(%rbp)
+	# line 6
+	movsd	%xmm12, .Lm0+80(%rip)
+	# line 6
+	movsd	.Lc11(%rip), %xmm13
+	movsd	%xmm13, -96(%rbp)
+	# line 6
+	movsd	%xmm13, .Lm0+88(%rip)
+	# line 6
+	movsd	.Lc12(%rip), %xmm14
+	movsd	%xmm14, -104(%rbp)
+	# line 6
+	movsd	%xmm14, .Lm0+96(%rip)
+	# line 6
+	movsd	.Lc13(%rip), %xmm15
+	movsd	%xmm15, -112(%rbp)
+	# line 6
+	movsd	%xmm15, .Lm0+104(%rip)
+	# line 6
+	movsd	.Lc14(%rip), %xmm2
+	movsd	%xmm2, -120(%rbp)
+	# line 6
+	movsd	%xmm2, .Lm0+112(%rip)
+	# line 6
+	movsd	.Lc15(%rip), %xmm3
+	movsd	%xmm3, -128(%rbp)
+	# line 6
+	movsd	%xmm3, .Lm0+120(%rip)
+	# line 7
+	movsd	.Lc16(%rip), %xmm4
+	movsd	%xmm4, -128(%rbp)
+	# line 7
+	movsd	%xmm4, .Lm1+0(%rip)
+	# line 7
+	movsd	.Lc17(%rip), %xmm3
+	movsd	%xmm3, -120(%rbp)
+	# line 7
+	movsd	%xmm3, .Lm1+8(%rip)
+	# line 7
+	movsd	.Lc18(%rip), %xmm2
+	movsd	%xmm2, -112(%rbp)
+	# line 7
+	movsd	%xmm2, .Lm1+16(%rip)
+	# line 7
+	movsd	.Lc19(%rip), %xmm15
+	movsd	%xmm15, -104(%rbp)
+	# line 7
+	movsd	%xmm15, .Lm1+24(%rip)
+	# line 8
+	movsd	.Lc20(%rip), %xmm14
+	movsd	%xmm14, -104(%rbp)
+	# line 8
+	movsd	%xmm14, .Lm2+0(%rip)
+	# line 8
+	movsd	.Lc21(%rip), %xmm15
+	movsd	%xmm15, -112(%rbp)
+	# line 8
+	movsd	%xmm15, .Lm2+8(%rip)
+	# line 8
+	movsd	.Lc22(%rip), %xmm2
+	movsd	%xmm2, -120(%rbp)
+	# line 8
+	movsd	%xmm2, .Lm2+16(%rip)
+	# line 8
+	movsd	.Lc23(%rip), %xmm3
+	movsd	%xmm3, -128(%rbp)
+	# line 8
+	movsd	%xmm3, .Lm2+24(%rip)
+	# line 10
+	movl	$4, %edi
+	movl	$1, %esi
+	leaq	.Lm1(%rip), %rdx
+	leaq	.Lm3(%rip), %rcx
+	call	tr@PLT
+	# line 10
+	movl	$4, %edi
+	movl	$4, %esi
+	movl	$1, %edx
+	leaq	.Lm0(%rip), %rcx
+	leaq	.Lm2(%rip), %r8
+	leaq	.Lm4(%rip), %r9
+	call	mat_mat_mul@PLT
+	# line 10
+	movl	$4, %edi
+	leaq	.Lm3(%rip), %rsi
+	leaq	.Lm4(%rip), %rdx
+	call	mat_mat_mul_s@PLT
+	movsd	%xmm0, -136(%rbp)
+	# line 11
+	movsd	-136(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+.Lpc52:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	0
+.Lc1:
+	.quad	4607182418800017408
+.Lc2:
+	.quad	4611686018427387904
+.Lc3:
+	.quad	4613937818241073152
+.Lc4:
+	.quad	4616189618054758400
+.Lc5:
+	.quad	4617315517961601024
+.Lc6:
+	.quad	4618441417868443648
+.Lc7:
+	.quad	4619567317775286272
+.Lc8:
+	.quad	4620693217682128896
+.Lc9:
+	.quad	4621256167635550208
+.Lc10:
+	.quad	4607182418800017408
+.Lc11:
+	.quad	4607182418800017408
+.Lc12:
+	.quad	4607182418800017408
+.Lc13:
+	.quad	4611686018427387904
+.Lc14:
+	.quad	4613937818241073152
+.Lc15:
+	.quad	4616189618054758400
+.Lc16:
+	.quad	4607182418800017408
+.Lc17:
+	.quad	4607182418800017408
+.Lc18:
+	.quad	4607182418800017408
+.Lc19:
+	.quad	4607182418800017408
+.Lc20:
+	.quad	4611686018427387904
+.Lc21:
+	.quad	4607182418800017408
+.Lc22:
+	.quad	4613937818241073152
+.Lc23:
+	.quad	4607182418800017408
+	.bss
+	.balign	32
+.Lm0:
+	.zero	128
+	.balign	32
+.Lm1:
+	.zero	32
+	.balign	32
+.Lm2:
+	.zero	32
+	.balign	32
+.Lm3:
+	.zero	32
+	.balign	32
+.Lm4:
+	.zero	32
+	.section	.note.GNU-stack,"",@progbits
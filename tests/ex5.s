@@ -0,0 +1,264 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$160, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 9
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 9
+	movsd	%xmm2, .Lm0+0(%rip)
+	# line 9
+	movsd	.Lc1(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 9
+	movsd	%xmm3, .Lm0+8(%rip)
+	# line 9
+	movsd	.Lc2(%rip), %xmm4
+	movsd	%xmm4, -24(%rbp)
+	# line 9
+	movsd	%xmm4, .Lm0+16(%rip)
+	# line 9
+	movsd	.Lc3(%rip), %xmm5
+	movsd	%xmm5, -32(%rbp)
+	# line 9
+	movsd	%xmm5, .Lm0+24(%rip)
+	# line 9
+	movsd	.Lc4(%rip), %xmm6
+	movsd	%xmm6, -40(%rbp)
+	# line 9
+	movsd	%xmm6, .Lm0+32(%rip)
+	# line 9
+	movsd	.Lc5(%rip), %xmm7
+	movsd	%xmm7, -48(%rbp)
+	# line 9
+	movsd	%xmm7, .Lm0+40(%rip)
+	# line 9
+	movsd	.Lc6(%rip), %xmm8
+	movsd	%xmm8, -56(%rbp)
+	# line 9
+	movsd	%xmm8, .Lm0+48(%rip)
+	# line 9
+	movsd	.Lc7(%rip), %xmm9
+	movsd	%xmm9, -64(%rbp)
+	# line 9
+	movsd	%xmm9, .Lm0+56(%rip)
+	# line 9
+	movsd	.Lc8(%rip), %xmm10
+	movsd	%xmm10, -72(%rbp)
+	# line 9
+	movsd	%xmm10, .Lm0+64(%rip)
+	# line 9
+	movsd	.Lc9(%rip), %xmm11
+	movsd	%xmm11, -80(%rbp)
+	# line 9
+	movsd	%xmm11, .Lm0+72(%rip)
+	# line 9
+	movsd	.Lc10(%rip), %xmm12
+	movsd	%xmm12, -88(%rbp)
+	# line 9
+	movsd	%xmm12, .Lm0+80(%rip)
+	# line 9
+	movsd	.Lc11(%rip), %xmm13
+	movsd	%xmm13, -96(%rbp)
+	# line 9
+	movsd	%xmm13, .Lm0+88(%rip)
+	# line 9
+	movsd	.Lc12(%rip), %xmm14
+	movsd	%xmm14, -104(%rbp)
+	# line 9
+	movsd	%xmm14, .Lm0+96(%rip)
+	# line 9
+	movsd	.Lc13(%rip), %xmm15
+	movsd	%xmm15, -112(%rbp)
+	# line 9
+	movsd	%xmm15, .Lm0+104(%rip)
+	# line 9
+	movsd	.Lc14(%rip), %xmm2
+	movsd	%xmm2, -120(%rbp)
+	# line 9
+	movsd	%xmm2, .Lm0+112(%rip)
+	# line 9
+	movsd	.Lc15(%rip), %xmm3
+	movsd	%xmm3, -128(%rbp)
+	# line 9
+	movsd	%xmm3, .Lm0+120(%rip)
+	# line 10
+	movsd	.Lc16(%rip), %xmm4
+	movsd	%xmm4, -136(%rbp)
+	# line 11
+	movsd	.Lc17(%rip), %xmm5
+	movsd	%xmm5, -144(%rbp)
+.Lpc34:
+	# line 11
+	movsd	.Lc18(%rip), %xmm2
+	movsd	%xmm2, -128(%rbp)
+	# line 11
+	movsd	-144(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc57
+	# line 11
+	movsd	.Lc19(%rip), %xmm4
+	movsd	%xmm4, -152(%rbp)
+.Lpc37:
+	# line 11
+	movsd	.Lc20(%rip), %xmm2
+	movsd	%xmm2, -128(%rbp)
+	# line 11
+	movsd	-152(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc54
+	# line 12
+	movsd	.Lc21(%rip), %xmm4
+	movsd	%xmm4, -128(%rbp)
+	# line 12
+	movsd	-144(%rbp), %xmm2
+	movapd	%xmm2, %xmm5
+	subsd	%xmm4, %xmm5
+	movsd	%xmm5, -120(%rbp)
+	# line 12
+	movsd	.Lc22(%rip), %xmm6
+	movsd	%xmm6, -112(%rbp)
+	# line 12
+	movapd	%xmm3, %xmm7
+	subsd	%xmm6, %xmm7
+	movsd	%xmm7, -104(%rbp)
+	# line 12
+	cvttsd2si	%xmm5, %eax
+	cvttsd2si	%xmm7, %ecx
+	imull	$4, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm8
+	movsd	%xmm8, -96(%rbp)
+	# line 12
+	movsd	.Lc23(%rip), %xmm9
+	movsd	%xmm9, -88(%rbp)
+	# line 12
+	movapd	%xmm8, %xmm10
+	subsd	%xmm9, %xmm10
+	movsd	%xmm10, -80(%rbp)
+	# line 12
+	movsd	.Lc24(%rip), %xmm11
+	movsd	%xmm11, -72(%rbp)
+	# line 12
+	movsd	.Lc25(%rip), %xmm12
+	movsd	%xmm12, -64(%rbp)
+	# line 12
+	movsd	.Lc26(%rip), %xmm13
+	movsd	%xmm13, -56(%rbp)
+	# line 12
+	cvttsd2si	%xmm10, %eax
+	movapd	%xmm11, %xmm14
+	testl	%eax, %eax
+	je	1f
+	movapd	%xmm12, %xmm14
+	jg	1f
+	movapd	%xmm13, %xmm14
+1:
+	movsd	%xmm14, -160(%rbp)
+	# line 13
+	movsd	-136(%rbp), %xmm15
+	movapd	%xmm15, %xmm2
+	addsd	%xmm14, %xmm2
+	movsd	%xmm2, -136(%rbp)
+	# line 11
+	movsd	.Lc27(%rip), %xmm15
+	movsd	%xmm15, -56(%rbp)
+	# line 11
+	movapd	%xmm3, %xmm13
+	addsd	%xmm15, %xmm13
+	movsd	%xmm13, -152(%rbp)
+	# line 11
+	jmp	.Lpc37
+.Lpc54:
+	# line 11
+	movsd	.Lc28(%rip), %xmm2
+	movsd	%xmm2, -56(%rbp)
+	# line 11
+	movsd	-144(%rbp), %xmm3
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -144(%rbp)
+	# line 11
+	jmp	.Lpc34
+.Lpc57:
+	# line 15
+	movsd	-136(%rbp), %xmm2
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+.Lpc58:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	0
+.Lc1:
+	.quad	4607182418800017408
+.Lc2:
+	.quad	4611686018427387904
+.Lc3:
+	.quad	4613937818241073152
+.Lc4:
+	.quad	4616189618054758400
+.Lc5:
+	.quad	4617315517961601024
+.Lc6:
+	.quad	4618441417868443648
+.Lc7:
+	.quad	4619567317775286272
+.Lc8:
+	.quad	4620693217682128896
+.Lc9:
+	.quad	4621256167635550208
+.Lc10:
+	.quad	4607182418800017408
+.Lc11:
+	.quad	4607182418800017408
+.Lc12:
+	.quad	4607182418800017408
+.Lc13:
+	.quad	4611686018427387904
+.Lc14:
+	.quad	4613937818241073152
+.Lc15:
+	.quad	4616189618054758400
+.Lc16:
+	.quad	0
+.Lc17:
+	.quad	4607182418800017408
+.Lc18:
+	.quad	4617315517961601024
+.Lc19:
+	.quad	4607182418800017408
+.Lc20:
+	.quad	4617315517961601024
+.Lc21:
+	.quad	4607182418800017408
+.Lc22:
+	.quad	4607182418800017408
+.Lc23:
+	.quad	4616189618054758400
+.Lc24:
+	.quad	4607182418800017408
+.Lc25:
+	.quad	4607182418800017408
+.Lc26:
+	.quad	0
+.Lc27:
+	.quad	4607182418800017408
+.Lc28:
+	.quad	4607182418800017408
+	.bss
+	.balign	32
+.Lm0:
+	.zero	128
+	.section	.note.GNU-stack,"",@progbits
@@ -0,0 +1,631 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$128, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 13
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 13
+	movsd	%xmm2, .Lm0+0(%rip)
+	# line 13
+	movsd	.Lc1(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 13
+	movsd	%xmm3, .Lm0+8(%rip)
+	# line 13
+	movsd	.Lc2(%rip), %xmm4
+	movsd	%xmm4, -24(%rbp)
+	# line 13
+	movsd	%xmm4, .Lm0+16(%rip)
+	# line 13
+	movsd	.Lc3(%rip), %xmm5
+	movsd	%xmm5, -32(%rbp)
+	# line 13
+	movsd	%xmm5, .Lm0+24(%rip)
+	# line 13
+	movsd	.Lc4(%rip), %xmm6
+	movsd	%xmm6, -40(%rbp)
+	# line 13
+	movsd	%xmm6, .Lm0+32(%rip)
+	# line 13
+	movsd	.Lc5(%rip), %xmm7
+	movsd	%xmm7, -48(%rbp)
+	# line 13
+	movsd	%xmm7, .Lm0+40(%rip)
+	# line 13
+	movsd	.Lc6(%rip), %xmm8
+	movsd	%xmm8, -56(%rbp)
+	# line 13
+	movsd	%xmm8, .Lm0+48(%rip)
+	# line 13
+	movsd	.Lc7(%rip), %xmm9
+	movsd	%xmm9, -64(%rbp)
+	# line 13
+	movsd	%xmm9, .Lm0+56(%rip)
+	# line 13
+	movsd	.Lc8(%rip), %xmm10
+	movsd	%xmm10, -72(%rbp)
+	# line 13
+	movsd	%xmm10, .Lm0+64(%rip)
+	# line 14
+	movsd	.Lc9(%rip), %xmm11
+	movsd	%xmm11, -72(%rbp)
+	# line 14
+	movsd	%xmm11, .Lm1+0(%rip)
+	# line 14
+	movsd	.Lc10(%rip), %xmm10
+	movsd	%xmm10, -64(%rbp)
+	# line 14
+	movsd	%xmm10, .Lm1+8(%rip)
+	# line 14
+	movsd	.Lc11(%rip), %xmm9
+	movsd	%xmm9, -56(%rbp)
+	# line 14
+	movsd	%xmm9, .Lm1+16(%rip)
+	# line 17
+	movsd	.Lc12(%rip), %xmm8
+	movsd	%xmm8, -80(%rbp)
+.Lpc25:
+	# line 17
+	movsd	.Lc13(%rip), %xmm2
+	movsd	%xmm2, -56(%rbp)
+	# line 17
+	movsd	-80(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc43
+	# line 18
+	movsd	.Lc14(%rip), %xmm4
+	movsd	%xmm4, -56(%rbp)
+	# line 18
+	movsd	.Lc15(%rip), %xmm2
+	movsd	%xmm2, -64(%rbp)
+	# line 18
+	movsd	.Lc16(%rip), %xmm5
+	movsd	%xmm5, -72(%rbp)
+	# line 18
+	movsd	.Lc17(%rip), %xmm6
+	movsd	%xmm6, -48(%rbp)
+	# line 18
+	movapd	%xmm3, %xmm7
+	subsd	%xmm6, %xmm7
+	movsd	%xmm7, -40(%rbp)
+	# line 18
+	cvttsd2si	%xmm5, %eax
+	cvttsd2si	%xmm7, %ecx
+	imull	$3, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm8
+	movsd	%xmm8, -32(%rbp)
+	# line 18
+	movapd	%xmm2, %xmm9
+	mulsd	%xmm8, %xmm9
+	movsd	%xmm9, -24(%rbp)
+	# line 18
+	movsd	.Lc18(%rip), %xmm10
+	movsd	%xmm10, -16(%rbp)
+	# line 18
+	movsd	.Lc19(%rip), %xmm11
+	movsd	%xmm11, -8(%rbp)
+	# line 18
+	movapd	%xmm3, %xmm12
+	subsd	%xmm11, %xmm12
+	movsd	%xmm12, -88(%rbp)
+	# line 18
+	cvttsd2si	%xmm10, %eax
+	cvttsd2si	%xmm12, %ecx
+	imull	$3, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm13
+	movsd	%xmm13, -96(%rbp)
+	# line 18
+	movapd	%xmm9, %xmm14
+	addsd	%xmm13, %xmm14
+	movsd	%xmm14, -104(%rbp)
+	# line 18
+	cvttsd2si	%xmm4, %eax
+	subl	$1, %eax
+	imull	$3, %eax, %eax
+	cvttsd2si	%xmm3, %ecx
+	subl	$1, %ecx
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	%xmm14, (%rdx,%rax,8)
+	# line 17
+	movsd	.Lc20(%rip), %xmm15
+	movsd	%xmm15, -104(%rbp)
+	# line 17
+	movapd	%xmm3, %xmm14
+	addsd	%xmm15, %xmm14
+	movsd	%xmm14, -80(%rbp)
+	# line 17
+	jmp	.Lpc25
+.Lpc43:
+	# line 20
+	movsd	.Lc21(%rip), %xmm2
+	movsd	%xmm2, -104(%rbp)
+	# line 20
+	movsd	.Lc22(%rip), %xmm3
+	movsd	%xmm3, -96(%rbp)
+	# line 20
+	movsd	.Lc23(%rip), %xmm4
+	movsd	%xmm4, -88(%rbp)
+	# line 20
+	movsd	.Lc24(%rip), %xmm5
+	movsd	%xmm5, -8(%rbp)
+	# line 20
+	cvttsd2si	%xmm4, %eax
+	cvttsd2si	%xmm5, %ecx
+	imull	$1, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm6
+	movsd	%xmm6, -16(%rbp)
+	# line 20
+	movapd	%xmm3, %xmm7
+	mulsd	%xmm6, %xmm7
+	movsd	%xmm7, -24(%rbp)
+	# line 20
+	movsd	.Lc25(%rip), %xmm8
+	movsd	%xmm8, -32(%rbp)
+	# line 20
+	movsd	.Lc26(%rip), %xmm9
+	movsd	%xmm9, -40(%rbp)
+	# line 20
+	cvttsd2si	%xmm8, %eax
+	cvttsd2si	%xmm9, %ecx
+	imull	$1, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm10
+	movsd	%xmm10, -48(%rbp)
+	# line 20
+	movapd	%xmm7, %xmm11
+	addsd	%xmm10, %xmm11
+	movsd	%xmm11, -72(%rbp)
+	# line 20
+	cvttsd2si	%xmm2, %eax
+	subl	$1, %eax
+	imull	$1, %eax, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	%xmm11, (%rdx,%rax,8)
+	# line 22
+	movsd	.Lc27(%rip), %xmm12
+	movsd	%xmm12, -80(%rbp)
+.Lpc55:
+	# line 22
+	movsd	.Lc28(%rip), %xmm2
+	movsd	%xmm2, -72(%rbp)
+	# line 22
+	movsd	-80(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc73
+	# line 23
+	movsd	.Lc29(%rip), %xmm4
+	movsd	%xmm4, -72(%rbp)
+	# line 23
+	movsd	.Lc30(%rip), %xmm2
+	movsd	%xmm2, -48(%rbp)
+	# line 23
+	movsd	.Lc31(%rip), %xmm5
+	movsd	%xmm5, -40(%rbp)
+	# line 23
+	movsd	.Lc32(%rip), %xmm6
+	movsd	%xmm6, -32(%rbp)
+	# line 23
+	movapd	%xmm3, %xmm7
+	subsd	%xmm6, %xmm7
+	movsd	%xmm7, -24(%rbp)
+	# line 23
+	cvttsd2si	%xmm5, %eax
+	cvttsd2si	%xmm7, %ecx
+	imull	$3, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm8
+	movsd	%xmm8, -16(%rbp)
+	# line 23
+	movapd	%xmm2, %xmm9
+	mulsd	%xmm8, %xmm9
+	movsd	%xmm9, -8(%rbp)
+	# line 23
+	movsd	.Lc33(%rip), %xmm10
+	movsd	%xmm10, -88(%rbp)
+	# line 23
+	movsd	.Lc34(%rip), %xmm11
+	movsd	%xmm11, -96(%rbp)
+	# line 23
+	movapd	%xmm3, %xmm12
+	subsd	%xmm11, %xmm12
+	movsd	%xmm12, -104(%rbp)
+	# line 23
+	cvttsd2si	%xmm10, %eax
+	cvttsd2si	%xmm12, %ecx
+	imull	$3, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm13
+	movsd	%xmm13, -64(%rbp)
+	# line 23
+	movapd	%xmm9, %xmm14
+	addsd	%xmm13, %xmm14
+	movsd	%xmm14, -56(%rbp)
+	# line 23
+	cvttsd2si	%xmm4, %eax
+	subl	$1, %eax
+	imull	$3, %eax, %eax
+	cvttsd2si	%xmm3, %ecx
+	subl	$1, %ecx
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	%xmm14, (%rdx,%rax,8)
+	# line 22
+	movsd	.Lc35(%rip), %xmm15
+	movsd	%xmm15, -56(%rbp)
+	# line 22
+	movapd	%xmm3, %xmm14
+	addsd	%xmm15, %xmm14
+	movsd	%xmm14, -80(%rbp)
+	# line 22
+	jmp	.Lpc55
+.Lpc73:
+	# line 25
+	movsd	.Lc36(%rip), %xmm2
+	movsd	%xmm2, -56(%rbp)
+	# line 25
+	movsd	.Lc37(%rip), %xmm3
+	movsd	%xmm3, -64(%rbp)
+	# line 25
+	movsd	.Lc38(%rip), %xmm4
+	movsd	%xmm4, -104(%rbp)
+	# line 25
+	movsd	.Lc39(%rip), %xmm5
+	movsd	%xmm5, -96(%rbp)
+	# line 25
+	cvttsd2si	%xmm4, %eax
+	cvttsd2si	%xmm5, %ecx
+	imull	$1, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm6
+	movsd	%xmm6, -88(%rbp)
+	# line 25
+	movapd	%xmm3, %xmm7
+	mulsd	%xmm6, %xmm7
+	movsd	%xmm7, -8(%rbp)
+	# line 25
+	movsd	.Lc40(%rip), %xmm8
+	movsd	%xmm8, -16(%rbp)
+	# line 25
+	movsd	.Lc41(%rip), %xmm9
+	movsd	%xmm9, -24(%rbp)
+	# line 25
+	cvttsd2si	%xmm8, %eax
+	cvttsd2si	%xmm9, %ecx
+	imull	$1, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm10
+	movsd	%xmm10, -32(%rbp)
+	# line 25
+	movapd	%xmm7, %xmm11
+	addsd	%xmm10, %xmm11
+	movsd	%xmm11, -40(%rbp)
+	# line 25
+	cvttsd2si	%xmm2, %eax
+	subl	$1, %eax
+	imull	$1, %eax, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	%xmm11, (%rdx,%rax,8)
+	# line 27
+	movsd	.Lc42(%rip), %xmm12
+	movsd	%xmm12, -80(%rbp)
+.Lpc85:
+	# line 27
+	movsd	.Lc43(%rip), %xmm2
+	movsd	%xmm2, -40(%rbp)
+	# line 27
+	movsd	-80(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc105
+	# line 28
+	movsd	.Lc44(%rip), %xmm4
+	movsd	%xmm4, -40(%rbp)
+	# line 28
+	movsd	.Lc45(%rip), %xmm2
+	movsd	%xmm2, -32(%rbp)
+	# line 28
+	movsd	.Lc46(%rip), %xmm5
+	movsd	%xmm5, -24(%rbp)
+	# line 28
+	movapd	%xmm2, %xmm6
+	subsd	%xmm5, %xmm6
+	movsd	%xmm6, -16(%rbp)
+	# line 28
+	movsd	.Lc47(%rip), %xmm7
+	movsd	%xmm7, -8(%rbp)
+	# line 28
+	movsd	.Lc48(%rip), %xmm8
+	movsd	%xmm8, -88(%rbp)
+	# line 28
+	movapd	%xmm3, %xmm9
+	subsd	%xmm8, %xmm9
+	movsd	%xmm9, -96(%rbp)
+	# line 28
+	cvttsd2si	%xmm7, %eax
+	cvttsd2si	%xmm9, %ecx
+	imull	$3, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm10
+	movsd	%xmm10, -104(%rbp)
+	# line 28
+	movapd	%xmm6, %xmm11
+	mulsd	%xmm10, %xmm11
+	movsd	%xmm11, -64(%rbp)
+	# line 28
+	movsd	.Lc49(%rip), %xmm12
+	movsd	%xmm12, -56(%rbp)
+	# line 28
+	movsd	.Lc50(%rip), %xmm13
+	movsd	%xmm13, -48(%rbp)
+	# line 28
+	movapd	%xmm3, %xmm14
+	subsd	%xmm13, %xmm14
+	movsd	%xmm14, -72(%rbp)
+	# line 28
+	cvttsd2si	%xmm12, %eax
+	cvttsd2si	%xmm14, %ecx
+	imull	$3, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm15
+	movsd	%xmm15, -112(%rbp)
+	# line 28
+	movapd	%xmm11, %xmm4
+	addsd	%xmm15, %xmm4
+	movsd	%xmm4, -120(%rbp)
+	# line 28
+	movsd	-40(%rbp), %xmm2
+	cvttsd2si	%xmm2, %eax
+	subl	$1, %eax
+	imull	$3, %eax, %eax
+	cvttsd2si	%xmm3, %ecx
+	subl	$1, %ecx
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm0(%rip), %rdx
+	movsd	%xmm4, (%rdx,%rax,8)
+	# line 27
+	movsd	.Lc51(%rip), %xmm5
+	movsd	%xmm5, -120(%rbp)
+	# line 27
+	movapd	%xmm3, %xmm4
+	addsd	%xmm5, %xmm4
+	movsd	%xmm4, -80(%rbp)
+	# line 27
+	jmp	.Lpc85
+.Lpc105:
+	# line 30
+	movsd	.Lc52(%rip), %xmm2
+	movsd	%xmm2, -120(%rbp)
+	# line 30
+	movsd	.Lc53(%rip), %xmm3
+	movsd	%xmm3, -112(%rbp)
+	# line 30
+	movsd	.Lc54(%rip), %xmm4
+	movsd	%xmm4, -72(%rbp)
+	# line 30
+	movapd	%xmm3, %xmm5
+	subsd	%xmm4, %xmm5
+	movsd	%xmm5, -48(%rbp)
+	# line 30
+	movsd	.Lc55(%rip), %xmm6
+	movsd	%xmm6, -56(%rbp)
+	# line 30
+	movsd	.Lc56(%rip), %xmm7
+	movsd	%xmm7, -64(%rbp)
+	# line 30
+	cvttsd2si	%xmm6, %eax
+	cvttsd2si	%xmm7, %ecx
+	imull	$1, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm8
+	movsd	%xmm8, -104(%rbp)
+	# line 30
+	movapd	%xmm5, %xmm9
+	mulsd	%xmm8, %xmm9
+	movsd	%xmm9, -96(%rbp)
+	# line 30
+	movsd	.Lc57(%rip), %xmm10
+	movsd	%xmm10, -88(%rbp)
+	# line 30
+	movsd	.Lc58(%rip), %xmm11
+	movsd	%xmm11, -8(%rbp)
+	# line 30
+	cvttsd2si	%xmm10, %eax
+	cvttsd2si	%xmm11, %ecx
+	imull	$1, %eax, %eax
+	addl	%ecx, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	(%rdx,%rax,8), %xmm12
+	movsd	%xmm12, -16(%rbp)
+	# line 30
+	movapd	%xmm9, %xmm13
+	addsd	%xmm12, %xmm13
+	movsd	%xmm13, -24(%rbp)
+	# line 30
+	cvttsd2si	%xmm2, %eax
+	subl	$1, %eax
+	imull	$1, %eax, %eax
+	cltq
+	leaq	.Lm1(%rip), %rdx
+	movsd	%xmm13, (%rdx,%rax,8)
+	# line 32
+	movl	$3, %edi
+	movl	$3, %esi
+	leaq	.Lm0(%rip), %rdx
+	call	print_mat@PLT
+	# line 33
+	call	printsep@PLT
+	# line 34
+	movl	$3, %edi
+	movl	$1, %esi
+	leaq	.Lm1(%rip), %rdx
+	call	print_mat@PLT
+.Lpc121:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	4607182418800017408
+.Lc1:
+	.quad	4611686018427387904
+.Lc2:
+	.quad	4613937818241073152
+.Lc3:
+	.quad	4607182418800017408
+.Lc4:
+	.quad	13835058055282163712
+.Lc5:
+	.quad	13830554455654793216
+.Lc6:
+	.quad	4613937818241073152
+.Lc7:
+	.quad	4607182418800017408
+.Lc8:
+	.quad	4607182418800017408
+.Lc9:
+	.quad	13830554455654793216
+.Lc10:
+	.quad	13830554455654793216
+.Lc11:
+	.quad	4613937818241073152
+.Lc12:
+	.quad	4607182418800017408
+.Lc13:
+	.quad	4616189618054758400
+.Lc14:
+	.quad	4611686018427387904
+.Lc15:
+	.quad	13830554455654793216
+.Lc16:
+	.quad	0
+.Lc17:
+	.quad	4607182418800017408
+.Lc18:
+	.quad	4607182418800017408
+.Lc19:
+	.quad	4607182418800017408
+.Lc20:
+	.quad	4607182418800017408
+.Lc21:
+	.quad	4611686018427387904
+.Lc22:
+	.quad	13830554455654793216
+.Lc23:
+	.quad	0
+.Lc24:
+	.quad	0
+.Lc25:
+	.quad	4607182418800017408
+.Lc26:
+	.quad	0
+.Lc27:
+	.quad	4607182418800017408
+.Lc28:
+	.quad	4616189618054758400
+.Lc29:
+	.quad	4613937818241073152
+.Lc30:
+	.quad	13837309855095848960
+.Lc31:
+	.quad	0
+.Lc32:
+	.quad	4607182418800017408
+.Lc33:
+	.quad	4611686018427387904
+.Lc34:
+	.quad	4607182418800017408
+.Lc35:
+	.quad	4607182418800017408
+.Lc36:
+	.quad	4613937818241073152
+.Lc37:
+	.quad	13837309855095848960
+.Lc38:
+	.quad	0
+.Lc39:
+	.quad	0
+.Lc40:
+	.quad	4611686018427387904
+.Lc41:
+	.quad	0
+.Lc42:
+	.quad	4607182418800017408
+.Lc43:
+	.quad	4616189618054758400
+.Lc44:
+	.quad	4613937818241073152
+.Lc45:
+	.quad	0
+.Lc46:
+	.quad	4608308318706860032
+.Lc47:
+	.quad	4607182418800017408
+.Lc48:
+	.quad	4607182418800017408
+.Lc49:
+	.quad	4611686018427387904
+.Lc50:
+	.quad	4607182418800017408
+.Lc51:
+	.quad	4607182418800017408
+.Lc52:
+	.quad	4613937818241073152
+.Lc53:
+	.quad	0
+.Lc54:
+	.quad	4608308318706860032
+.Lc55:
+	.quad	4607182418800017408
+.Lc56:
+	.quad	0
+.Lc57:
+	.quad	4611686018427387904
+.Lc58:
+	.quad	0
+	.bss
+	.balign	32
+.Lm0:
+	.zero	72
+	.balign	32
+.Lm1:
+	.zero	24
+	.section	.note.GNU-stack,"",@progbits
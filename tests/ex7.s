@@ -0,0 +1,45 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 3
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+	# line 3
+	movsd	.Lc1(%rip), %xmm3
+	movsd	%xmm3, -16(%rbp)
+	# line 3
+	movapd	%xmm2, %xmm4
+	subsd	%xmm3, %xmm4
+	movsd	%xmm4, -24(%rbp)
+	# line 3
+	movapd	%xmm4, %xmm0
+	call	print@PLT
+	# line 4
+	call	printsep@PLT
+	# line 5
+	movsd	.Lc2(%rip), %xmm2
+	movsd	%xmm2, -24(%rbp)
+	# line 5
+	movapd	%xmm2, %xmm0
+	call	print@PLT
+.Lpc7:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	0
+.Lc1:
+	.quad	4616189618054758400
+.Lc2:
+	.quad	13839561654909534208
+	.bss
+	.section	.note.GNU-stack,"",@progbits
@@ -0,0 +1,81 @@
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+	movq	rt_out_flush@GOTPCREL(%rip), %rdi
+	call	atexit@PLT
+	# line 3
+	movsd	.Lc0(%rip), %xmm2
+	movsd	%xmm2, -8(%rbp)
+.Lpc1:
+	# line 3
+	movsd	.Lc1(%rip), %xmm2
+	movsd	%xmm2, -16(%rbp)
+	# line 3
+	movsd	-8(%rbp), %xmm3
+	ucomisd	%xmm3, %xmm2
+	jbe	.Lpc14
+	# line 3
+	movsd	.Lc2(%rip), %xmm4
+	movsd	%xmm4, -24(%rbp)
+.Lpc4:
+	# line 3
+	movsd	.Lc3(%rip), %xmm2
+	movsd	%xmm2, -32(%rbp)
+	# line 3
+	movsd	-8(%rbp), %xmm3
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -16(%rbp)
+	# line 3
+	movsd	-24(%rbp), %xmm5
+	ucomisd	%xmm5, %xmm4
+	jbe	.Lpc11
+	# line 4
+	movapd	%xmm5, %xmm0
+	call	print@PLT
+	# line 3
+	movsd	.Lc4(%rip), %xmm2
+	movsd	%xmm2, -32(%rbp)
+	# line 3
+	movsd	-24(%rbp), %xmm3
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -24(%rbp)
+	# line 3
+	jmp	.Lpc4
+.Lpc11:
+	# line 3
+	movsd	.Lc5(%rip), %xmm2
+	movsd	%xmm2, -32(%rbp)
+	# line 3
+	movsd	-8(%rbp), %xmm3
+	movapd	%xmm3, %xmm4
+	addsd	%xmm2, %xmm4
+	movsd	%xmm4, -8(%rbp)
+	# line 3
+	jmp	.Lpc1
+.Lpc14:
+	movl	$0, %eax
+	leave
+	ret
+	.size	main, .-main
+	.section	.rodata
+	.balign	8
+.Lc0:
+	.quad	4607182418800017408
+.Lc1:
+	.quad	4622382067542392832
+.Lc2:
+	.quad	4607182418800017408
+.Lc3:
+	.quad	4607182418800017408
+.Lc4:
+	.quad	4607182418800017408
+.Lc5:
+	.quad	4607182418800017408
+	.bss
+	.section	.note.GNU-stack,"",@progbits